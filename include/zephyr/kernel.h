@@ -71,6 +71,7 @@ BUILD_ASSERT(sizeof(intptr_t) == sizeof(long));
 
 struct k_thread;
 struct k_mutex;
+struct k_rwlock;
 struct k_sem;
 struct k_msgq;
 struct k_mbox;
@@ -79,6 +80,7 @@ struct k_queue;
 struct k_fifo;
 struct k_lifo;
 struct k_stack;
+struct k_mpmcq;
 struct k_mem_slab;
 struct k_timer;
 struct k_poll_event;
@@ -3310,11 +3312,178 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define K_MPMCQ_FLAG_ALLOC	((uint8_t)1)	/* Buffer was allocated */
+
+struct k_mpmcq_slot {
+	/* Position of the slot, relative to its index, at which it was last
+	 * written (plus one) or read (plus the queue size).
+	 */
+	atomic_t seq;
+	uintptr_t data;
+};
+
+struct k_mpmcq {
+	/* Position of the next slot to write */
+	atomic_t tail;
+	/* Position of the next slot to read */
+	atomic_t head;
+
+	struct k_mpmcq_slot *slots;
+	uint32_t mask;
+
+	/* Number of threads pending on a full or an empty queue */
+	atomic_t put_waiters;
+	atomic_t get_waiters;
+
+	/* Only used to pend and wake threads */
+	struct k_spinlock lock;
+	_wait_q_t put_wait_q;
+	_wait_q_t get_wait_q;
+
+	uint8_t flags;
+};
+
+#define Z_MPMCQ_INITIALIZER(obj, slot_buffer, num_slots) \
+	{ \
+	.slots = (slot_buffer), \
+	.mask = (num_slots) - 1U, \
+	.put_wait_q = Z_WAIT_Q_INIT(&(obj).put_wait_q), \
+	.get_wait_q = Z_WAIT_Q_INIT(&(obj).get_wait_q), \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup mpmcq_apis MPMC Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize a multi-producer multi-consumer queue.
+ *
+ * This routine initializes a bounded multi-producer multi-consumer queue,
+ * prior to its first use. Values are put into and got from the queue
+ * without taking a lock; the queue lock is only used to pend threads when
+ * the queue is full or empty.
+ *
+ * @param mpmcq Address of the queue.
+ * @param buffer Array of @a num_slots slots, used to hold the values.
+ * @param num_slots Maximum number of values the queue can hold. Must be a
+ *                  power of two, and at least 2.
+ */
+void k_mpmcq_init(struct k_mpmcq *mpmcq, struct k_mpmcq_slot *buffer,
+		  uint32_t num_slots);
+
+/**
+ * @brief Initialize a multi-producer multi-consumer queue.
+ *
+ * This routine initializes a queue object, prior to its first use. Internal
+ * buffers will be allocated from the calling thread's resource pool.
+ * This memory will be released if k_mpmcq_cleanup() is called, or
+ * userspace is enabled and the queue object loses all references to it.
+ *
+ * @param mpmcq Address of the queue.
+ * @param num_slots Maximum number of values the queue can hold. Must be a
+ *                  power of two, and at least 2.
+ *
+ * @retval 0 on success
+ * @retval -ENOMEM if memory couldn't be allocated
+ * @retval -EINVAL if @a num_slots is not a power of two, or is less than 2
+ */
+__syscall int k_mpmcq_alloc_init(struct k_mpmcq *mpmcq, uint32_t num_slots);
+
+/**
+ * @brief Release a queue's allocated buffer
+ *
+ * If a queue object was given a dynamically allocated buffer via
+ * k_mpmcq_alloc_init(), this will free it. This function does nothing
+ * if the buffer wasn't dynamically allocated.
+ *
+ * @param mpmcq Address of the queue.
+ * @retval 0 on success
+ * @retval -EBUSY when object is still in use
+ */
+int k_mpmcq_cleanup(struct k_mpmcq *mpmcq);
+
+/**
+ * @brief Put a value into a multi-producer multi-consumer queue.
+ *
+ * This routine adds the value @a data at the end of @a mpmcq. If the queue
+ * is full, the caller pends until space is available or the timeout
+ * expires.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param mpmcq Address of the queue.
+ * @param data Value to put into the queue.
+ * @param timeout Waiting period to add the value,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Value put into the queue.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_mpmcq_put(struct k_mpmcq *mpmcq, uintptr_t data, k_timeout_t timeout);
+
+/**
+ * @brief Get a value from a multi-producer multi-consumer queue.
+ *
+ * This routine removes the value at the front of @a mpmcq, in a "first in,
+ * first out" manner, and stores it in @a data. If the queue is empty, the
+ * caller pends until a value is available or the timeout expires.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param mpmcq Address of the queue.
+ * @param data Address of area to hold the value got from the queue.
+ * @param timeout Waiting period to get a value,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Value got from the queue.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_mpmcq_get(struct k_mpmcq *mpmcq, uintptr_t *data, k_timeout_t timeout);
+
+/**
+ * @brief Statically define and initialize a multi-producer multi-consumer
+ * queue.
+ *
+ * The queue can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_mpmcq <name>; @endcode
+ *
+ * @param name Name of the queue.
+ * @param num_slots Maximum number of values the queue can hold. Must be a
+ *                  power of two, and at least 2.
+ */
+#define K_MPMCQ_DEFINE(name, num_slots)                                    \
+	BUILD_ASSERT(IS_POWER_OF_TWO(num_slots) && ((num_slots) >= 2),     \
+		     "MPMC queue size must be a power of two, at least 2"); \
+	struct k_mpmcq_slot _k_mpmcq_buf_##name[num_slots];                \
+	STRUCT_SECTION_ITERABLE(k_mpmcq, name) =                           \
+		Z_MPMCQ_INITIALIZER(name, _k_mpmcq_buf_##name, num_slots)
+
+/** @} */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
 
 struct k_work;
+struct k_work_q_worker;
 struct k_work_q;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
@@ -3350,6 +3519,13 @@ struct k_mutex {
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	/** Contention statistics */
+	struct k_mutex_stats stats;
+	/** Cycle count when the current owner acquired the mutex */
+	uint32_t owned_since;
+#endif
 };
 
 /**
@@ -3440,6 +3616,169 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
  */
 __syscall int k_mutex_unlock(struct k_mutex *mutex);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Boost the writer holding the lock to the priority of waiters.
+ */
+#define K_RWLOCK_PRIO_INHERIT BIT(0)
+
+/**
+ * Reader-writer lock structure
+ */
+struct k_rwlock {
+	/** Lock protecting the fields below */
+	struct k_spinlock lock;
+	/** Threads waiting to read */
+	_wait_q_t rd_wait_q;
+	/** Threads waiting to write */
+	_wait_q_t wr_wait_q;
+	/** Thread holding the lock for writing */
+	struct k_thread *writer;
+	/** Number of threads holding the lock for reading */
+	uint32_t readers;
+	/** Original priority of the writer */
+	int writer_orig_prio;
+	/** K_RWLOCK_* options */
+	uint32_t options;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_RWLOCK_INITIALIZER(obj, opts) \
+	{ \
+	.rd_wait_q = Z_WAIT_Q_INIT(&(obj).rd_wait_q), \
+	.wr_wait_q = Z_WAIT_Q_INIT(&(obj).wr_wait_q), \
+	.writer = NULL, \
+	.readers = 0, \
+	.writer_orig_prio = K_LOWEST_APPLICATION_THREAD_PRIO, \
+	.options = (opts), \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ * @param options Either 0 or K_RWLOCK_PRIO_INHERIT.
+ */
+#define K_RWLOCK_DEFINE(name, options) \
+	STRUCT_SECTION_ITERABLE(k_rwlock, name) = \
+		Z_RWLOCK_INITIALIZER(name, options)
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * This routine initializes a reader-writer lock object, prior to its first
+ * use.
+ *
+ * Upon completion, the lock is held neither for reading nor for writing.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param options Either 0 or K_RWLOCK_PRIO_INHERIT.
+ *
+ * @retval 0 Reader-writer lock object created
+ * @retval -EINVAL Invalid options
+ */
+__syscall int k_rwlock_init(struct k_rwlock *rwlock, uint32_t options);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * This routine locks @a rwlock for reading. Any number of threads may hold
+ * the lock for reading at the same time. If the lock is held for writing, or
+ * if a thread waits to lock it for writing, the calling thread waits until
+ * the lock is released by all writers or until a timeout occurs.
+ *
+ * Writers are preferred over readers: a thread holding the lock for reading
+ * that locks it for reading again may deadlock if a writer waits in the
+ * meantime.
+ *
+ * Reader-writer locks may not be locked in ISRs.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the reader-writer lock,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Reader-writer lock locked for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * This routine locks @a rwlock for writing. If the lock is held for
+ * reading or for writing by other threads, the calling thread waits until
+ * it is released by all of them or until a timeout occurs. New readers are
+ * held off while the calling thread waits.
+ *
+ * If the lock was initialized with K_RWLOCK_PRIO_INHERIT, the priority of
+ * the thread holding it for writing is raised to that of the highest
+ * priority thread waiting for it. Threads holding it for reading are not
+ * tracked and are never boosted.
+ *
+ * Reader-writer locks may not be locked in ISRs.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the reader-writer lock,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Reader-writer lock locked for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EDEADLK The calling thread already holds the lock for writing,
+ *                  and @a timeout is not K_NO_WAIT.
+ */
+__syscall int k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a reader-writer lock held for reading.
+ *
+ * This routine releases a read lock on @a rwlock. Once the last reader
+ * releases the lock, it is given to the highest priority thread waiting to
+ * write, if any.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Reader-writer lock unlocked.
+ * @retval -EINVAL The lock is not held for reading.
+ */
+__syscall int k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Unlock a reader-writer lock held for writing.
+ *
+ * This routine releases @a rwlock, which must be held for writing by the
+ * calling thread. The lock is given to the highest priority thread waiting
+ * to write, if any, or else to all the threads waiting to read.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Reader-writer lock unlocked.
+ * @retval -EPERM The current thread does not hold the lock for writing.
+ */
+__syscall int k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
 /**
  * @}
  */
@@ -4010,6 +4349,48 @@ void k_work_queue_start(struct k_work_q *queue,
  */
 void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *cfg);
 
+/** @brief Start a work queue served by several threads.
+ *
+ * This works like k_work_queue_start(), but the queue is animated by @p
+ * num_workers threads that process its items in parallel.  Each worker
+ * thread has its own list of pending items; items submitted from outside
+ * the queue are spread over idle workers, items submitted from a work
+ * handler are added to the list of the worker running that handler, and an
+ * idle worker takes items from the list of a busy one.
+ *
+ * A work item never runs on more than one worker at a time: an item
+ * resubmitted while it is running is queued to the worker running it.
+ * Flushing, cancelling, draining and stopping behave as for single-threaded
+ * queues.  Items submitted to the queue may however complete in a different
+ * order from the one they were submitted in.
+ *
+ * @kconfig_dep{CONFIG_WORKQUEUE_MULTI}
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param workers array of @p num_workers worker structures.
+ *
+ * @param num_workers number of worker threads, at least 1.
+ *
+ * @param stacks array of @p num_workers stacks, defined with
+ *        K_THREAD_STACK_ARRAY_DEFINE() using @p stack_size as the size.
+ *
+ * @param stack_size size of each worker thread stack area, in bytes.
+ *
+ * @param prio initial priority of the worker threads
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_queue_config.  The work timeout is not supported by queues with
+ * several workers and is ignored.
+ */
+void k_work_queue_start_workers(struct k_work_q *queue,
+				struct k_work_q_worker *workers, size_t num_workers,
+				k_thread_stack_t *stacks, size_t stack_size,
+				int prio, const struct k_work_queue_config *cfg);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -4595,6 +4976,32 @@ struct k_work_queue_config {
 	uint32_t work_timeout_ms;
 };
 
+/** @brief A worker thread of a work queue started with
+ * k_work_queue_start_workers().
+ *
+ * The contents are private to the work queue implementation.
+ */
+struct k_work_q_worker {
+	/* The thread that animates the worker. */
+	struct k_thread thread;
+
+	/* The queue the worker belongs to. */
+	struct k_work_q *queue;
+
+	/* All the following fields must be accessed only while the
+	 * work module spinlock is held.
+	 */
+
+	/* List of k_work items to be worked by this worker first. */
+	sys_slist_t pending;
+
+	/* Wait queue for the idle worker thread. */
+	_wait_q_t notifyq;
+
+	/* The work item being processed, if any. */
+	struct k_work *work;
+};
+
 /** @brief A structure used to hold work until it can be processed. */
 struct k_work_q {
 	/* The thread that animates the work. */
@@ -4626,6 +5033,17 @@ struct k_work_q {
 	struct k_work *work;
 	k_timeout_t work_timeout;
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
+
+#if defined(CONFIG_WORKQUEUE_MULTI)
+	/* Worker threads, or NULL if the queue has a single thread. */
+	struct k_work_q_worker *workers;
+
+	/* Number of entries in workers. */
+	uint16_t num_workers;
+
+	/* Worker to try first for the next submission. */
+	uint16_t next_worker;
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -5196,6 +5614,37 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data);
 
+/**
+ * @brief Send several messages to the end of a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data to
+ * message queue @a msgq with a single acquisition of the queue's lock.
+ * Messages are handed to waiting receivers first, the remaining ones are
+ * copied to the ring buffer as long as there is space.  Waiting threads are
+ * rescheduled once, after all messages have been transferred.
+ *
+ * If no message can be sent, the routine waits up to @a timeout for space
+ * for the first message, then sends as many of the remaining messages as
+ * fit without waiting again.
+ *
+ * @note The message contents are copied from @a data into @a msgq and the
+ * @a data pointer is not retained.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to an array of @a num_msgs messages.
+ * @param num_msgs Number of messages to send.
+ * @param timeout Waiting period to add the first message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent, which may be less than @a num_msgs.
+ * @retval -ENOMSG No message could be sent without waiting, or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Receive a message from a message queue.
  *
@@ -5218,6 +5667,36 @@ __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data);
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq in a "first in, first out" manner, with a single acquisition of
+ * the queue's lock.  The space freed is refilled from threads waiting to
+ * send, which are rescheduled once, after all messages have been
+ * transferred.
+ *
+ * If the queue is empty, the routine waits up to @a timeout for a first
+ * message, then receives as many of the remaining messages as are available
+ * without waiting again.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold @a num_msgs received messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message, or one of
+ *                the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages received, which may be less than @a num_msgs.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -5486,6 +5965,10 @@ __syscall void k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t buffer_s
 enum pipe_flags {
 	PIPE_FLAG_OPEN = BIT(0),
 	PIPE_FLAG_RESET = BIT(1),
+	PIPE_FLAG_WRITE_CLAIM = BIT(2),
+	PIPE_FLAG_READ_CLAIM = BIT(3),
+	PIPE_FLAG_WRITE_CANCELED = BIT(4),
+	PIPE_FLAG_READ_CANCELED = BIT(5),
 };
 
 struct k_pipe {
@@ -5576,11 +6059,113 @@ __syscall int k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len,
 __syscall int k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len,
 			  k_timeout_t timeout);
 
+/**
+ * @brief Claim space in a pipe for writing in place
+ *
+ * This routine reserves up to @a len contiguous bytes of the pipe's ring
+ * buffer, so that the caller can produce data directly into pipe storage
+ * instead of copying it in with k_pipe_write(). If the pipe is full, or
+ * another write claim is outstanding, the routine blocks until space can be
+ * claimed or the timeout expires.
+ *
+ * The claimed area may be smaller than requested when the pipe has less free
+ * space or the area would wrap around the end of the ring buffer. It must be
+ * handed over with k_pipe_write_commit() before the pipe can be written to
+ * again. Only one write claim can be outstanding at a time: the thread
+ * holding it must not call k_pipe_write() or k_pipe_write_claim() on the
+ * same pipe before committing it.
+ *
+ * @note The claim/commit routines are not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed area.
+ * @param len Requested number of bytes.
+ * @param timeout Waiting period to wait for space to become available.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EINVAL if @a len is zero or the pipe has no ring buffer
+ * @retval -EAGAIN if no space could be claimed before the timeout expired
+ * @retval -ECANCELED if the claim was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed
+ */
+int k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+		       k_timeout_t timeout);
+
+/**
+ * @brief Commit data written in place to a pipe
+ *
+ * This routine makes the first @a len bytes of the area obtained with
+ * k_pipe_write_claim() available to readers and releases the claim. The rest
+ * of the claimed area is returned to the free space of the pipe. Waiting
+ * readers are woken up.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes written to the claimed area.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if no write claim is outstanding, or @a len exceeds the
+ *         claimed size
+ * @retval -ECANCELED if the pipe was reset since the claim, the data is
+ *         discarded and the claim released
+ * @retval -EPIPE if the pipe was closed, the data is discarded
+ */
+int k_pipe_write_commit(struct k_pipe *pipe, size_t len);
+
+/**
+ * @brief Claim data in a pipe for reading in place
+ *
+ * This routine returns the address and size of up to @a len contiguous bytes
+ * of data at the head of the pipe's ring buffer, so that the caller can
+ * consume it directly from pipe storage instead of copying it out with
+ * k_pipe_read(). If the pipe is empty, or another read claim is outstanding,
+ * the routine blocks until data can be claimed or the timeout expires.
+ *
+ * The claimed data must be released with k_pipe_read_commit() before the pipe
+ * can be read from again. Only one read claim can be outstanding at a time:
+ * the thread holding it must not call k_pipe_read() or k_pipe_read_claim()
+ * on the same pipe before committing it.
+ *
+ * @note The claim/commit routines are not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed data.
+ * @param len Requested number of bytes.
+ * @param timeout Waiting period to wait for data to become available.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EINVAL if @a len is zero or the pipe has no ring buffer
+ * @retval -EAGAIN if no data could be claimed before the timeout expired
+ * @retval -ECANCELED if the claim was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed and no data is left
+ */
+int k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+		      k_timeout_t timeout);
+
+/**
+ * @brief Release data read in place from a pipe
+ *
+ * This routine frees the first @a len bytes of the data obtained with
+ * k_pipe_read_claim() and releases the claim. The rest of the claimed data
+ * stays in the pipe, to be read again. Waiting writers are woken up.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes consumed from the claimed data.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if no read claim is outstanding, or @a len exceeds the
+ *         claimed size
+ * @retval -ECANCELED if the pipe was reset since the claim, the claimed data
+ *         was already discarded and the claim is released
+ */
+int k_pipe_read_commit(struct k_pipe *pipe, size_t len);
+
 /**
  * @brief Reset a pipe
  * This routine resets the pipe, discarding any unread data and unblocking any threads waiting to
  * write or read, causing the waiting threads to return with -ECANCELED. Calling k_pipe_read(..) or
  * k_pipe_write(..) when the pipe is resetting but not yet reset will return -ECANCELED.
+ * Outstanding claims are cancelled: they keep blocking their direction until
+ * k_pipe_write_commit(..) or k_pipe_read_commit(..) returns -ECANCELED for them.
  * The pipe is left open after a reset and can be used as normal.
  *
  * @param pipe Address of the pipe.
@@ -5617,6 +6202,20 @@ struct k_mem_slab {
 	char *free_list;
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	/* Generation tag and index of the first free block */
+	atomic_t free_head;
+	/* Replace info.num_used and info.max_used */
+	atomic_t num_used;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_t max_used;
+#endif
+	/* Threads that are about to pend, or pending, on wait_q */
+	atomic_t num_waiters;
+	/* Width of the block index field in free_head */
+	uint8_t index_bits;
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5828,7 +6427,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	return (uint32_t)atomic_get(&slab->num_used);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5845,7 +6448,9 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
 {
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && defined(CONFIG_MEM_SLAB_LOCKLESS)
+	return (uint32_t)atomic_get(&slab->max_used);
+#elif defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
 	return slab->info.max_used;
 #else
 	ARG_UNUSED(slab);
@@ -5867,7 +6472,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -6530,6 +7135,96 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A poll set holds poll events that stay registered with their objects
+ * across waits, see k_poll_set_init().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t returned;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+};
+
+/**
+ * @brief Initialize a poll set
+ *
+ * A poll set is a persistent alternative to k_poll() for threads watching
+ * many objects. Events are registered with their objects once, by
+ * k_poll_set_add(), instead of on every call. When an object becomes ready,
+ * its event is queued on the set's ready list, so that k_poll_set_wait()
+ * costs time proportional to the number of ready events rather than to the
+ * number of events in the set.
+ *
+ * @param set The poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set
+ *
+ * The event must have been initialized with k_poll_event_init() and must not
+ * be part of another poll set nor be passed to k_poll() or
+ * k_work_poll_submit() while it is part of the set. The event stays part of
+ * the set until removed with k_poll_set_remove().
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ *
+ * @retval 0 Event added.
+ * @retval -EINVAL Event of type K_POLL_TYPE_IGNORE.
+ * @retval -EBUSY Event already registered by a poller.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set
+ *
+ * @param set The poll set.
+ * @param event The event to remove.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL Event is not part of @a set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready
+ *
+ * This routine returns up to @a max_events events of @a set which are ready,
+ * waiting up to @a timeout for one to become ready if none is. The state field
+ * of each returned event tells why it is ready, as with k_poll().
+ *
+ * Events are level triggered: the events returned by a call are rearmed by
+ * the next call to k_poll_set_wait() on the set, and are returned again if
+ * the condition they watch is still met at that point. The caller is thus
+ * expected to process, e.g. take the semaphore or drain the queue of, every
+ * event returned before waiting again.
+ *
+ * Only one thread may wait on a given poll set at a time.
+ *
+ * @param set The poll set.
+ * @param events Array receiving pointers to the ready events.
+ * @param max_events Size of the @a events array.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events returned in @a events.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a max_events is not positive.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout);
+
 /** @} */
 
 /**
@@ -50,6 +50,13 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif /* !CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+		/**
+		 * Number of page faults on data pages which were among the
+		 * last CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY pages
+		 * evicted
+		 */
+		unsigned long			refaults;
 	} pagefaults;
 
 	struct {
@@ -158,6 +165,49 @@ void k_mem_unpin(void *addr, size_t size);
  */
 __syscall void k_mem_paging_stats_get(struct k_mem_paging_stats_t *stats);
 
+#if defined(CONFIG_DEMAND_PAGING_STATS) || defined(__DOXYGEN__)
+/**
+ * Compute the hit ratio of data page accesses
+ *
+ * Accesses to data pages which are paged in do not trap, so the kernel
+ * cannot count them. The caller provides the number of accesses made over
+ * the period covered by the statistics, e.g. when replaying a workload.
+ *
+ * @param[in] stats Paging statistics over the period
+ * @param accesses Number of data page accesses made over the period
+ * @return Per-mille of the accesses which did not page fault
+ */
+static inline unsigned int k_mem_paging_stats_hit_ratio(const struct k_mem_paging_stats_t *stats,
+							unsigned long accesses)
+{
+	if ((accesses == 0UL) || (stats->pagefaults.cnt >= accesses)) {
+		return 0U;
+	}
+
+	return (unsigned int)(((uint64_t)(accesses - stats->pagefaults.cnt) * 1000U) / accesses);
+}
+
+/**
+ * Compute the refault ratio of page faults
+ *
+ * A high ratio of refaults indicates that the eviction algorithm evicts
+ * pages which are still in use, or that the working set does not fit in
+ * the page frames.
+ *
+ * @param[in] stats Paging statistics
+ * @return Per-mille of the page faults which were refaults
+ */
+static inline unsigned int k_mem_paging_stats_refault_ratio(const struct k_mem_paging_stats_t *stats)
+{
+	if (stats->pagefaults.cnt == 0UL) {
+		return 0U;
+	}
+
+	return (unsigned int)(((uint64_t)stats->pagefaults.refaults * 1000U) /
+			      stats->pagefaults.cnt);
+}
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
 struct k_thread;
 /**
  * Get the paging statistics since system startup for a thread
@@ -59,6 +59,10 @@
 #define K_OBJ_TYPE_THREAD_ID     K_OBJ_TYPE_ID_GEN("THRD")
 /** Timer object type */
 #define K_OBJ_TYPE_TIMER_ID      K_OBJ_TYPE_ID_GEN("TIMR")
+/** Timeout queue object type */
+#define K_OBJ_TYPE_TIMEOUT_Q_ID  K_OBJ_TYPE_ID_GEN("TMOQ")
+/** Per-CPU IPI object type */
+#define K_OBJ_TYPE_IPI_ID        K_OBJ_TYPE_ID_GEN("IPI_")
 
 struct k_obj_type;
 struct k_obj_core;
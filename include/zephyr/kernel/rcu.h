@@ -0,0 +1,128 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_KERNEL_RCU_H_
+#define ZEPHYR_INCLUDE_KERNEL_RCU_H_
+
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/barrier.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup rcu_apis Read-Copy-Update APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+struct k_rcu_head;
+
+/**
+ * @brief RCU callback.
+ *
+ * Called by k_rcu_call() once a grace period has elapsed, typically to
+ * free the structure embedding @a head.
+ *
+ * @param head Head passed to k_rcu_call().
+ */
+typedef void (*k_rcu_callback_t)(struct k_rcu_head *head);
+
+/**
+ * @brief Deferred RCU callback record.
+ *
+ * Embed this in structures reclaimed with k_rcu_call(). Its contents are
+ * private to the kernel.
+ */
+struct k_rcu_head {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	k_rcu_callback_t func;
+	/** @endcond */
+};
+
+/**
+ * @brief Enter an RCU read-side critical section.
+ *
+ * Data published with k_rcu_assign_pointer() and read with
+ * k_rcu_dereference() within the critical section is not reclaimed before
+ * the critical section is left. Critical sections may be nested, may be
+ * preempted and may be entered from ISRs, but the calling thread must
+ * not block within them.
+ *
+ * Entering and leaving a critical section takes neither locks nor atomic
+ * operations, but each costs a full memory barrier on SMP.
+ *
+ * @funcprops \isr_ok
+ */
+void k_rcu_read_lock(void);
+
+/**
+ * @brief Leave an RCU read-side critical section.
+ *
+ * @funcprops \isr_ok
+ */
+void k_rcu_read_unlock(void);
+
+/**
+ * @brief Wait for an RCU grace period.
+ *
+ * Waits until every read-side critical section that was entered before
+ * the call has been left. Data that was unpublished before the call can
+ * then be reclaimed.
+ *
+ * This must not be called from an ISR, nor within a read-side critical
+ * section.
+ */
+void k_rcu_synchronize(void);
+
+/**
+ * @brief Call a function once an RCU grace period has elapsed.
+ *
+ * Queues @a func to be called from the system work queue once every
+ * read-side critical section that was entered before the call has been
+ * left. This does not block.
+ *
+ * @param head Callback record, usually embedded in the data to reclaim.
+ * @param func Function to call.
+ *
+ * @funcprops \isr_ok
+ */
+void k_rcu_call(struct k_rcu_head *head, k_rcu_callback_t func);
+
+/**
+ * @brief Read a pointer published with k_rcu_assign_pointer().
+ *
+ * Must be used within a read-side critical section. The data pointed to
+ * stays valid until the critical section is left.
+ *
+ * @param p Pointer to read.
+ */
+#define k_rcu_dereference(p) (*(volatile __typeof__(p) *)&(p))
+
+/**
+ * @brief Publish a pointer to data for RCU readers.
+ *
+ * Stores made to initialize the data are visible to readers before the
+ * pointer is.
+ *
+ * @param p Pointer to set.
+ * @param v Value to set it to.
+ */
+#define k_rcu_assign_pointer(p, v)					\
+	do {								\
+		barrier_dmem_fence_full();				\
+		*(volatile __typeof__(p) *)&(p) = (v);			\
+	} while (false)
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_KERNEL_RCU_H_ */
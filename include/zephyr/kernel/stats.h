@@ -10,6 +10,20 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(__DOXYGEN__)
+/**
+ * Log2 histogram of durations measured in cycles. Bucket N counts the
+ * durations of 2^N to 2^(N+1)-1 cycles, bucket 0 also counts durations of
+ * 0 cycles and the last bucket also counts all longer durations.
+ */
+
+struct k_cycle_histogram {
+	/** \# of durations in each bucket */
+	uint32_t  buckets[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS];
+	uint64_t  sum;          /**< sum of all durations in cycles */
+};
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 /**
  * Structure used to track internal statistics about both thread
  * and CPU usage.
@@ -27,7 +41,54 @@ struct k_cycle_stats {
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_THREAD_USAGE_HISTOGRAM is selected.
+	 * @{
+	 */
+	uint32_t  ready_at;     /**< time made ready, 0 if not pending a run */
+	struct k_cycle_histogram  wakeup_latency;  /**< made ready to running */
+	struct k_cycle_histogram  run_length;      /**< usage window lengths */
+	/** @} */
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+/**
+ * Structure used to track lock contention on a kernel timeout queue.
+ */
+
+struct k_timeout_q_stats {
+	uint64_t  lock_acquired;   /**< \# of times the queue lock was taken */
+	uint64_t  lock_contended;  /**< \# of those that had to wait */
+	uint64_t  added;           /**< \# of timeouts added to the queue */
+	uint64_t  expired;         /**< \# of timeouts expired from the queue */
+};
+
+/**
+ * Structure used to track the scheduler IPIs of a CPU.
+ */
+
+struct k_ipi_stats {
+	uint64_t  sent;       /**< \# of IPIs sent to other CPUs */
+	uint64_t  coalesced;  /**< \# of IPIs not sent, one being pending */
+	uint64_t  received;   /**< \# of IPIs serviced */
+	uint64_t  useful;     /**< \# of those that caused a context switch */
+	uint64_t  wasted;     /**< \# of those that did not */
+};
+
+/**
+ * Structure used to track contention on a mutex.
+ */
+
+struct k_mutex_stats {
+	uint64_t  acquired;       /**< \# of times a thread became the owner */
+	uint64_t  contended;      /**< \# of locks finding another owner */
+	uint64_t  spun;           /**< \# of those that spun on the owner */
+	uint64_t  spin_acquired;  /**< \# of spins that acquired the mutex */
+	uint64_t  blocked;        /**< \# of contended locks that pended */
+	uint64_t  hold_cycles;    /**< total cycles the mutex was owned */
+	uint32_t  hold_max;       /**< longest ownership (in cycles) */
+};
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
@@ -93,7 +93,8 @@ struct _thread_base {
 	int prio_deadline;
 #endif /* CONFIG_SCHED_DEADLINE */
 
-#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE)
+#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE) || \
+	defined(CONFIG_SCHED_WORK_STEALING)
 	uint32_t order_key;
 #endif
 
@@ -107,6 +108,11 @@ struct _thread_base {
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	/* CPU whose ready queue holds this thread while it is queued */
+	uint8_t runq_cpu;
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
 #endif /* CONFIG_SMP */
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -241,6 +247,18 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	/*
+	 * Log2 histograms, in cycles, of the time spent between being made
+	 * ready and running, and of the length of the usage windows. For
+	 * CPUs, they cover the threads tracked that ran on the CPU, idle
+	 * thread excepted for run lengths.
+	 */
+
+	struct k_cycle_histogram wakeup_latency;
+	struct k_cycle_histogram run_length;
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
@@ -256,6 +274,24 @@ struct z_poller {
 	uint8_t mode;
 };
 
+#ifdef CONFIG_RCU
+struct _thread_rcu {
+	/* Nesting depth of RCU read-side critical sections */
+	uint16_t nesting;
+
+	/* True if switched out within a read-side critical section */
+	bool blocked;
+
+	/* CPU, grace period and quiescent state count when switched out */
+	uint8_t cpu;
+	uint32_t gp_seq;
+	uint32_t qs;
+
+	/* Node in the list of blocked readers */
+	sys_dnode_t node;
+};
+#endif /* CONFIG_RCU */
+
 /**
  * @ingroup thread_apis
  * Thread Structure
@@ -277,6 +313,11 @@ struct k_thread {
 	struct z_poller poller;
 #endif /* CONFIG_POLL */
 
+#if defined(CONFIG_RCU)
+	/** RCU read-side critical section state */
+	struct _thread_rcu rcu;
+#endif /* CONFIG_RCU */
+
 #if defined(CONFIG_EVENTS)
 	struct k_thread *next_event_link;
 
@@ -135,7 +135,7 @@ struct _ready_q {
 
 #if defined(CONFIG_SCHED_SIMPLE)
 	sys_dlist_t runq;
-#elif defined(CONFIG_SCHED_SCALABLE)
+#elif defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_SCHED_WORK_STEALING)
 	struct _priq_rb runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
@@ -157,7 +157,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_WORK_STEALING)
 	struct _ready_q ready_q;
 #endif
 
@@ -199,6 +199,11 @@ struct _cpu {
 	sys_dlist_t ipi_workq;
 #endif
 
+#ifdef CONFIG_RCU
+	/* Number of RCU quiescent states the CPU passed through */
+	uint32_t rcu_qs;
+#endif
+
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
 };
@@ -216,7 +221,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_WORK_STEALING)
 	struct _ready_q ready_q;
 #endif
 
@@ -235,6 +240,11 @@ struct z_kernel {
 	/* Identify CPUs to send IPIs to at the next scheduling point */
 	atomic_t pending_ipi;
 #endif
+
+#ifdef CONFIG_IPI_COALESCE
+	/* Identify CPUs sent an IPI they have not serviced yet */
+	atomic_t ipi_in_flight;
+#endif
 };
 
 typedef struct z_kernel _kernel_t;
@@ -300,7 +310,11 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct rbnode node;
+#else
 	sys_dnode_t node;
+#endif
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
 	/* Can't use k_ticks_t for header dependency reasons */
@@ -308,6 +322,16 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* Absolute expiry tick while queued */
+	uint64_t tick;
+	/* Insertion order among timeouts expiring on the same tick */
+	uint32_t order_key;
+#endif
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Index of the per-CPU timeout queue holding this timeout */
+	uint8_t cpu;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
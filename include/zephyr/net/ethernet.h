@@ -207,6 +207,12 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload supported. The device cuts packets with
+	 * a non-zero net_pkt_gso_size() into TCP segments of that size, and
+	 * computes their IPv4 and TCP checksums.
+	 */
+	ETHERNET_HW_TSO			= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
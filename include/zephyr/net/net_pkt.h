@@ -244,6 +244,9 @@ struct net_pkt {
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 	uint8_t tx_timestamping : 1; /** Timestamp transmitted packet */
 	uint8_t rx_timestamping : 1; /** Timestamp received packet */
+#endif
+#if defined(CONFIG_NET_PKT_CHKSUM_ACCUMULATE)
+	uint8_t chksum_acc_on : 1; /* Data appended is summed into chksum_acc */
 #endif
 	/* bitfield byte alignment boundary */
 
@@ -361,6 +364,22 @@ struct net_pkt {
 	uint8_t ipv4_pmtu : 1;
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_PKT_CHKSUM_ACCUMULATE)
+	/* Internet checksum of the last chksum_acc_len bytes of the packet,
+	 * accumulated while they were appended.
+	 */
+	uint16_t chksum_acc;
+	uint16_t chksum_acc_len;
+#endif /* CONFIG_NET_PKT_CHKSUM_ACCUMULATE */
+
+#if defined(CONFIG_NET_TCP_GSO) || defined(CONFIG_NET_TCP_GRO)
+	/* Size of the TCP segments the payload is made of, 0 for a single
+	 * segment. Sent packets are cut in segments of this size, received
+	 * ones were merged from segments with a verified checksum.
+	 */
+	uint16_t gso_size;
+#endif
+
 	/* @endcond */
 };
 
@@ -576,6 +595,111 @@ static inline void net_pkt_set_chksum_done(struct net_pkt *pkt,
 	pkt->chksum_done = is_chksum_done;
 }
 
+#if defined(CONFIG_NET_PKT_CHKSUM_ACCUMULATE)
+/* Sum the data appended from now on with net_pkt_write(), net_pkt_memset(),
+ * net_pkt_skip() or net_pkt_copy(). Any other change to the end of the
+ * packet stops the accumulation.
+ */
+static inline void net_pkt_chksum_acc_start(struct net_pkt *pkt)
+{
+	pkt->chksum_acc_on = 1U;
+	pkt->chksum_acc = 0U;
+	pkt->chksum_acc_len = 0U;
+}
+
+static inline void net_pkt_chksum_acc_stop(struct net_pkt *pkt)
+{
+	pkt->chksum_acc_on = 0U;
+}
+
+static inline bool net_pkt_chksum_acc_is_on(struct net_pkt *pkt)
+{
+	return !!(pkt->chksum_acc_on);
+}
+
+/* Set the checksum of the last len bytes, which were summed elsewhere */
+static inline void net_pkt_chksum_acc_set(struct net_pkt *pkt, uint16_t sum,
+					  size_t len)
+{
+	pkt->chksum_acc_on = 1U;
+	pkt->chksum_acc = sum;
+	pkt->chksum_acc_len = len;
+}
+
+static inline bool net_pkt_chksum_acc_get(struct net_pkt *pkt, uint16_t *sum,
+					  size_t *len)
+{
+	if (!pkt->chksum_acc_on) {
+		return false;
+	}
+
+	*sum = pkt->chksum_acc;
+	*len = pkt->chksum_acc_len;
+
+	return true;
+}
+#else
+static inline void net_pkt_chksum_acc_start(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+}
+
+static inline void net_pkt_chksum_acc_stop(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+}
+
+static inline bool net_pkt_chksum_acc_is_on(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_chksum_acc_set(struct net_pkt *pkt, uint16_t sum,
+					  size_t len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+	ARG_UNUSED(len);
+}
+
+static inline bool net_pkt_chksum_acc_get(struct net_pkt *pkt, uint16_t *sum,
+					  size_t *len)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+	ARG_UNUSED(len);
+
+	return false;
+}
+#endif /* CONFIG_NET_PKT_CHKSUM_ACCUMULATE */
+
+#if defined(CONFIG_NET_TCP_GSO) || defined(CONFIG_NET_TCP_GRO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t gso_size)
+{
+	pkt->gso_size = gso_size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0U;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t gso_size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(gso_size);
+}
+#endif
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 #if defined(CONFIG_NET_IP)
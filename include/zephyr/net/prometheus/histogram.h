@@ -22,6 +22,9 @@
 
 #include <stddef.h>
 
+/** Upper bound of the last bucket of a histogram, exposed as "+Inf" */
+#define PROMETHEUS_HISTOGRAM_INF __builtin_inf()
+
 /**
  * @brief Prometheus histogram bucket definition.
  *
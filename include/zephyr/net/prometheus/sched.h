@@ -0,0 +1,92 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROMETHEUS_SCHED_H_
+#define ZEPHYR_INCLUDE_PROMETHEUS_SCHED_H_
+
+/**
+ * @file
+ *
+ * @brief Prometheus export of the kernel scheduling latency histograms.
+ *
+ * @addtogroup prometheus
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/prometheus/histogram.h>
+
+/**
+ * @brief Prometheus scheduling latency histogram definition.
+ *
+ * This macro defines a histogram metric, along with the bucket storage needed
+ * to hold a kernel scheduling latency histogram. Durations are exported in
+ * seconds. If you want to make the histogram static, then add "static"
+ * keyword before the PROMETHEUS_SCHED_HISTOGRAM_DEFINE.
+ *
+ * @param _name The histogram metric name.
+ * @param _desc Histogram description
+ * @param _label Label for the metric. Additional labels can be added at runtime.
+ * @param _collector Collector to map this metric. Can be set to NULL if it not yet known.
+ *
+ * Example usage:
+ * @code{.c}
+ *
+ * PROMETHEUS_SCHED_HISTOGRAM_DEFINE(net_rx_wakeup_latency, "RX thread wakeup latency",
+ *                                   ({ .key = "thread", .value = "rx" }), NULL);
+ *
+ * @endcode
+ */
+#define PROMETHEUS_SCHED_HISTOGRAM_DEFINE(_name, _desc, _label, _collector)	\
+	static struct prometheus_histogram_bucket				\
+		_name##_buckets[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS];	\
+	STRUCT_SECTION_ITERABLE(prometheus_histogram, _name) = {		\
+		.base.name = STRINGIFY(_name),					\
+		.base.type = PROMETHEUS_HISTOGRAM,				\
+		.base.description = _desc,					\
+		.base.labels[0] = __DEBRACKET _label,				\
+		.base.num_labels = 1,						\
+		.base.collector = _collector,					\
+		.buckets = _name##_buckets,					\
+		.num_buckets = ARRAY_SIZE(_name##_buckets),			\
+		.sum = 0.0,							\
+		.count = 0U,							\
+		.user_data = NULL,						\
+	}
+
+/**
+ * @brief Load a kernel scheduling latency histogram into a Prometheus histogram
+ *
+ * Replaces the buckets, count and sum of @p histogram with those of @p hist,
+ * converted to seconds. The upper bound of the last bucket is +Inf, as it
+ * counts every longer duration.
+ *
+ * @param histogram Histogram metric defined with PROMETHEUS_SCHED_HISTOGRAM_DEFINE().
+ * @param hist Kernel histogram, as reported in k_thread_runtime_stats_t.
+ *
+ * @return 0 on success, -EINVAL if @p histogram has no room for the buckets.
+ */
+int prometheus_sched_histogram_set(struct prometheus_histogram *histogram,
+				   const struct k_cycle_histogram *hist);
+
+/**
+ * @brief Load the scheduling latency histograms of a thread
+ *
+ * @param thread Thread whose histograms are exported.
+ * @param wakeup_latency Histogram metric receiving the wakeup latencies, or NULL.
+ * @param run_length Histogram metric receiving the run lengths, or NULL.
+ *
+ * @return 0 on success, a negative error code otherwise.
+ */
+int prometheus_sched_thread_update(k_tid_t thread,
+				   struct prometheus_histogram *wakeup_latency,
+				   struct prometheus_histogram *run_length);
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_PROMETHEUS_SCHED_H_ */
@@ -943,6 +943,8 @@ int zsock_getnameinfo(const struct net_sockaddr *addr, net_socklen_t addrlen,
 #define ZSOCK_TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define ZSOCK_TCP_KEEPCNT 4
+/** Congestion control algorithm, by name (e.g. "cubic") */
+#define ZSOCK_TCP_CONGESTION 5
 
 /** @} */
 
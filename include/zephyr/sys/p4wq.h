@@ -48,12 +48,38 @@ struct k_p4wq_work {
 	};
 	struct k_thread *thread;
 	struct k_p4wq *queue;
+#ifdef CONFIG_P4WQ_AGING
+	uint64_t aging_start;
+#endif
+#ifdef CONFIG_P4WQ_STATS
+	uint32_t submitted;
+#endif
 };
 
 #define K_P4WQ_QUEUE_PER_THREAD		BIT(0)
 #define K_P4WQ_DELAYED_START		BIT(1)
 #define K_P4WQ_USER_CPU_MASK		BIT(2)
 
+/**
+ * @brief P4 Queue statistics
+ *
+ * Latencies of the work items run by a P4 queue, in hardware cycles.
+ * Run times are measured from the entry to the handler to its return,
+ * and include any time the handler spent preempted.
+ */
+struct k_p4wq_stats {
+	/** Number of handlers that returned */
+	uint32_t count;
+	/** Longest time from submission to the entry to the handler */
+	uint32_t wait_max;
+	/** Sum of the times from submission to the entry to the handler */
+	uint64_t wait_total;
+	/** Longest handler run time */
+	uint32_t run_max;
+	/** Sum of the handler run times */
+	uint64_t run_total;
+};
+
 /**
  * @brief P4 Queue
  *
@@ -86,6 +112,15 @@ struct k_p4wq {
 	 * and k_p4wq_work is not needed by p4wq anymore
 	 */
 	k_p4wq_done_handler_t done_handler;
+
+#ifdef CONFIG_P4WQ_AGING
+	/* Cycles a work item waits to gain a priority level, or 0 */
+	uint32_t aging;
+#endif
+
+#ifdef CONFIG_P4WQ_STATS
+	struct k_p4wq_stats stats;
+#endif
 };
 
 struct k_p4wq_initparam {
@@ -225,6 +260,20 @@ void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
  */
 void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item);
 
+/**
+ * @brief Submit a set of work items to a P4 queue
+ *
+ * Equivalent to calling k_p4wq_submit() on each of the items, but the
+ * items are queued under a single lock and the caller reschedules at
+ * most once.  Useful to submit a burst of items at once.
+ *
+ * @param queue P4 Queue to which to submit
+ * @param items Array of P4 work items to be submitted
+ * @param count Number of items in the array
+ */
+void k_p4wq_submit_many(struct k_p4wq *queue, struct k_p4wq_work **items,
+			size_t count);
+
 /**
  * @brief Cancel submitted P4 work item
  *
@@ -242,6 +291,46 @@ bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item);
  */
 int k_p4wq_wait(struct k_p4wq_work *work, k_timeout_t timeout);
 
+/**
+ * @brief Set the priority aging interval of a P4 queue
+ *
+ * Work items waiting in the queue gain one priority level for each
+ * @a interval they wait, so that a sustained load of higher-priority
+ * items cannot starve them.  Aged items are run at their aged
+ * priority, which stays within their class: preemptible items do not
+ * become cooperative.  Aging is disabled by default.
+ *
+ * The interval can only be changed while no items are queued.
+ * Requires CONFIG_P4WQ_AGING.
+ *
+ * @param queue P4 Queue
+ * @param interval Aging interval in hardware cycles, as for work item
+ *                 deadlines, or 0 to disable aging
+ *
+ * @retval 0 on success
+ * @retval -EBUSY if items are queued
+ */
+int k_p4wq_aging_set(struct k_p4wq *queue, uint32_t interval);
+
+/**
+ * @brief Get the statistics of a P4 queue
+ *
+ * Requires CONFIG_P4WQ_STATS.
+ *
+ * @param queue P4 Queue
+ * @param stats Statistics, filled out by the call
+ */
+void k_p4wq_stats_get(struct k_p4wq *queue, struct k_p4wq_stats *stats);
+
+/**
+ * @brief Reset the statistics of a P4 queue
+ *
+ * Requires CONFIG_P4WQ_STATS.
+ *
+ * @param queue P4 Queue
+ */
+void k_p4wq_stats_reset(struct k_p4wq *queue);
+
 void k_p4wq_enable_static_thread(struct k_p4wq *queue, struct k_thread *thread,
 				 uint32_t cpu_mask);
 
@@ -0,0 +1,231 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @defgroup radix_tree_apis Radix Tree
+ * @ingroup datastructure_apis
+ *
+ * @brief Intrusive radix tree keyed by integers
+ *
+ * This implements an ordered container of nodes keyed by unique 64-bit
+ * unsigned integers, as a path-compressed radix tree: every interior
+ * node consumes CONFIG_RADIX_TREE_FANOUT_BITS bits of the key, and
+ * interior nodes with a single child are never created. The depth of
+ * the tree is thus bounded by the key width rather than by the number
+ * of nodes, and lookups follow one child pointer per level without any
+ * comparison callback.
+ *
+ * Like @ref rbtree_apis, the tree is intrusive and never allocates:
+ * a tree of N nodes never has more than N - 1 interior nodes, so every
+ * @ref radix_node embeds the storage for one interior node, which the
+ * tree uses as needed. The price for the shallow tree is a node much
+ * larger than an @ref rbnode, see @ref radix_node.
+ *
+ * @{
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RADIX_TREE_H_
+#define ZEPHYR_INCLUDE_SYS_RADIX_TREE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_RADIX_TREE_FANOUT_BITS
+#define Z_RADIX_BITS CONFIG_RADIX_TREE_FANOUT_BITS
+#else
+#define Z_RADIX_BITS 4
+#endif
+
+#define Z_RADIX_FANOUT BIT(Z_RADIX_BITS)
+
+/* Interior node. Children are tagged pointers, with the lowest bit set
+ * for leaves. Unused interior nodes are kept on a free list, through
+ * their child array.
+ */
+struct z_radix_inner {
+	struct z_radix_inner *parent;
+	uint16_t bitmap;
+	uint8_t shift;
+	uint8_t slot;
+	bool used;
+	union {
+		uintptr_t child[Z_RADIX_FANOUT];
+		sys_dnode_t free_node;
+	};
+};
+
+/** @endcond */
+
+/**
+ * @brief Radix tree node structure
+ *
+ * Besides the key and a parent pointer, a node holds the storage for
+ * one interior node of 2^CONFIG_RADIX_TREE_FANOUT_BITS pointers.
+ */
+struct radix_node {
+	/** @cond INTERNAL_HIDDEN */
+	struct z_radix_inner inner;
+	struct z_radix_inner *parent;
+	uint64_t key;
+	/** @endcond */
+};
+
+/**
+ * @brief Radix tree structure
+ *
+ * The structure should contain only zero bits before first use.
+ */
+struct radix_tree {
+	/** @cond INTERNAL_HIDDEN */
+	uintptr_t root;
+	sys_dlist_t free;
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+struct radix_node *z_radix_tree_get_minmax(struct radix_tree *tree, bool max);
+/** @endcond */
+
+/**
+ * @brief Insert a node into a tree
+ *
+ * @param tree Tree to insert into
+ * @param node Node to insert, not part of any tree
+ * @param key Key of the node
+ *
+ * @retval 0 on success
+ * @retval -EEXIST if the tree already holds a node with the same key
+ */
+int radix_tree_insert(struct radix_tree *tree, struct radix_node *node, uint64_t key);
+
+/**
+ * @brief Remove a node from a tree
+ *
+ * This takes constant time, independent of the size of the tree.
+ *
+ * @param tree Tree holding the node
+ * @param node Node to remove
+ */
+void radix_tree_remove(struct radix_tree *tree, struct radix_node *node);
+
+/**
+ * @brief Find the node with a given key
+ *
+ * @param tree Tree to search
+ * @param key Key to look for
+ *
+ * @return The node with the key, or NULL if there is none
+ */
+struct radix_node *radix_tree_find(struct radix_tree *tree, uint64_t key);
+
+/**
+ * @brief Find the lowest-keyed node whose key is not less than a given key
+ *
+ * @param tree Tree to search
+ * @param key Key to look for
+ *
+ * @return The node found, or NULL if all keys in the tree are less than @a key
+ */
+struct radix_node *radix_tree_lower_bound(struct radix_tree *tree, uint64_t key);
+
+/**
+ * @brief Return the node following a node in key order
+ *
+ * @param tree Tree holding the node
+ * @param node Node of the tree
+ *
+ * @return The next node, or NULL if @a node has the highest key
+ */
+struct radix_node *radix_tree_next(struct radix_tree *tree, struct radix_node *node);
+
+/**
+ * @brief Return the node preceding a node in key order
+ *
+ * @param tree Tree holding the node
+ * @param node Node of the tree
+ *
+ * @return The previous node, or NULL if @a node has the lowest key
+ */
+struct radix_node *radix_tree_prev(struct radix_tree *tree, struct radix_node *node);
+
+/**
+ * @brief Returns the lowest-keyed member of the tree
+ */
+static inline struct radix_node *radix_tree_get_min(struct radix_tree *tree)
+{
+	return z_radix_tree_get_minmax(tree, false);
+}
+
+/**
+ * @brief Returns the highest-keyed member of the tree
+ */
+static inline struct radix_node *radix_tree_get_max(struct radix_tree *tree)
+{
+	return z_radix_tree_get_minmax(tree, true);
+}
+
+/**
+ * @brief Returns true if the tree holds no node
+ */
+static inline bool radix_tree_is_empty(const struct radix_tree *tree)
+{
+	return tree->root == 0U;
+}
+
+/**
+ * @brief Returns the key a node was inserted with
+ */
+static inline uint64_t radix_node_key(const struct radix_node *node)
+{
+	return node->key;
+}
+
+/**
+ * @brief Walk a tree in key order
+ *
+ * The loop is not safe against modifications to the tree, except for
+ * the removal of the current node when the iteration stops right after.
+ *
+ * @param tree A pointer to a struct radix_tree to walk
+ * @param node The symbol name of a local struct radix_node* variable to
+ *             use as the iterator
+ */
+#define RADIX_TREE_FOR_EACH(tree, node)					\
+	for ((node) = radix_tree_get_min(tree); (node) != NULL;		\
+	     (node) = radix_tree_next((tree), (node)))
+
+/**
+ * @brief Loop over a radix tree with implicit container field logic
+ *
+ * As for RADIX_TREE_FOR_EACH(), but "node" can have an arbitrary type
+ * containing a struct radix_node.
+ *
+ * @param tree A pointer to a struct radix_tree to walk
+ * @param node The symbol name of a local iterator
+ * @param field The field name of a struct radix_node inside node
+ */
+#define RADIX_TREE_FOR_EACH_CONTAINER(tree, node, field)			\
+	for (struct radix_node *__n = radix_tree_get_min(tree);			\
+	     ((node) = (__n != NULL) ?						\
+		       CONTAINER_OF(__n, __typeof__(*(node)), field) : NULL) != NULL; \
+	     __n = radix_tree_next((tree), __n))
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* ZEPHYR_INCLUDE_SYS_RADIX_TREE_H_ */
@@ -42,6 +42,19 @@ typedef uint16_t ring_buf_idx_t;
 
 struct ring_buf_index { ring_buf_idx_t head, tail, base; };
 
+/* The producer and the consumer only write their own indices, keep them
+ * in separate cache lines if requested.
+ */
+#ifdef CONFIG_RING_BUFFER_CACHE_ALIGNED
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define Z_RING_BUF_INDEX_ALIGN __aligned(CONFIG_DCACHE_LINE_SIZE)
+#else
+#define Z_RING_BUF_INDEX_ALIGN __aligned(64)
+#endif
+#else
+#define Z_RING_BUF_INDEX_ALIGN
+#endif
+
 /** @endcond */
 
 /**
@@ -50,16 +63,28 @@ struct ring_buf_index { ring_buf_idx_t head, tail, base; };
 struct ring_buf {
 	/** @cond INTERNAL_HIDDEN */
 	uint8_t *buffer;
-	struct ring_buf_index put;
-	struct ring_buf_index get;
 	uint32_t size;
+	struct ring_buf_index put Z_RING_BUF_INDEX_ALIGN;
+	struct ring_buf_index get Z_RING_BUF_INDEX_ALIGN;
 	/** @endcond */
 };
 
+/**
+ * @brief A contiguous area of a ring buffer
+ */
+struct ring_buf_vec {
+	/** Start of the area */
+	uint8_t *data;
+	/** Size of the area (in bytes) */
+	uint32_t size;
+};
+
 /** @cond INTERNAL_HIDDEN */
 
 uint32_t ring_buf_area_claim(struct ring_buf *buf, struct ring_buf_index *ring,
 			     uint8_t **data, uint32_t size);
+uint32_t ring_buf_area_claim_vec(struct ring_buf *buf, struct ring_buf_index *ring,
+				 struct ring_buf_vec vec[2], uint32_t size);
 int ring_buf_area_finish(struct ring_buf *buf, struct ring_buf_index *ring,
 			 uint32_t size);
 
@@ -310,6 +335,41 @@ static inline uint32_t ring_buf_put_claim(struct ring_buf *buf,
 				   MIN(size, space));
 }
 
+/**
+ * @brief Allocate buffers for writing data to a ring buffer, across the wrap.
+ *
+ * Same as @ref ring_buf_put_claim, but allocates the free space both up to
+ * the end of the ring buffer area and from its start, so that a single call
+ * can be used to fill the ring buffer. The number of bytes written must be
+ * confirmed with @ref ring_buf_put_finish, the first area being written
+ * first.
+ *
+ * @warning
+ * Use cases involving multiple writers to the ring buffer must prevent
+ * concurrent write operations, either by preventing all writers from
+ * being preempted or by using a mutex to govern writes to the ring buffer.
+ *
+ * @warning
+ * Ring buffer instance should not mix byte access and item access
+ * (calls prefixed with ring_buf_item_).
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] vec  Allocated areas, in order. The size of the second one
+ *		    is 0 unless the allocation wraps.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Total size of the allocated buffers which can be smaller than
+ *	   requested if there is not enough free space.
+ */
+static inline uint32_t ring_buf_put_claim_vec(struct ring_buf *buf,
+					      struct ring_buf_vec vec[2],
+					      uint32_t size)
+{
+	uint32_t space = ring_buf_space_get(buf);
+
+	return ring_buf_area_claim_vec(buf, &buf->put, vec, MIN(size, space));
+}
+
 /**
  * @brief Indicate number of bytes written to allocated buffers.
  *
@@ -392,6 +452,40 @@ static inline uint32_t ring_buf_get_claim(struct ring_buf *buf,
 				   MIN(size, buf_size));
 }
 
+/**
+ * @brief Get addresses of valid data in a ring buffer, across the wrap.
+ *
+ * Same as @ref ring_buf_get_claim, but returns the valid data both up to
+ * the end of the ring buffer area and from its start, so that a single call
+ * can be used to drain the ring buffer. Once data is processed it must be
+ * freed using @ref ring_buf_get_finish, the first area being freed first.
+ *
+ * @warning
+ * Use cases involving multiple reads of the ring buffer must prevent
+ * concurrent read operations, either by preventing all readers from
+ * being preempted or by using a mutex to govern reads to the ring buffer.
+ *
+ * @warning
+ * Ring buffer instance should not mix byte access and item access
+ * (calls prefixed with ring_buf_item_).
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] vec  Areas of valid data, in order. The size of the second
+ *		    one is 0 unless the data wraps.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Total number of valid bytes in the provided buffers which can be
+ *	   smaller than requested if there is not enough data.
+ */
+static inline uint32_t ring_buf_get_claim_vec(struct ring_buf *buf,
+					      struct ring_buf_vec vec[2],
+					      uint32_t size)
+{
+	uint32_t buf_size = ring_buf_size_get(buf);
+
+	return ring_buf_area_claim_vec(buf, &buf->get, vec, MIN(size, buf_size));
+}
+
 /**
  * @brief Indicate number of bytes read from claimed buffer.
  *
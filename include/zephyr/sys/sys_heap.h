@@ -47,6 +47,22 @@ extern "C" {
  * locked operation.
  */
 
+/**
+ * @brief Statistics of a per-CPU caching layer in front of a heap
+ */
+struct sys_heap_cache_stats {
+	/** Allocations served from a cache */
+	uint32_t hits;
+	/** Allocations that found their cache empty */
+	uint32_t misses;
+	/** Batches of blocks moved from the heap into a cache */
+	uint32_t refills;
+	/** Batches of blocks moved from a cache back to the heap */
+	uint32_t drains;
+	/** Bytes currently held by the caches */
+	size_t cached_bytes;
+};
+
 /* Note: the init_mem/bytes fields are for the static initializer to
  * have somewhere to put the arguments.  The actual heap metadata at
  * runtime lives in the heap memory itself and this struct simply
@@ -58,6 +74,10 @@ struct sys_heap {
 	struct z_heap *heap;
 	void *init_mem;
 	size_t init_bytes;
+#ifdef CONFIG_SYS_HEAP_CACHE_STATS
+	/* One entry per CPU, provided by the caching layer if any */
+	struct sys_heap_cache_stats *cache_stats;
+#endif
 };
 
 struct z_heap_stress_result {
@@ -94,6 +114,21 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
  */
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
+/**
+ * @brief Get the statistics of the caching layer in front of a heap
+ *
+ * Sums up the per-CPU statistics of the cache placed in front of
+ * @a heap, e.g. the per-CPU k_malloc() cache of the system heap.  The
+ * hit rate is hits / (hits + misses).
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, -ENOTSUP if the heap has no cache,
+ *         otherwise 0
+ */
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+		struct sys_heap_cache_stats *stats);
+
 /** @brief Initialize sys_heap
  *
  * Initializes a sys_heap struct to manage the specified memory.
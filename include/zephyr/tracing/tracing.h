@@ -836,6 +836,90 @@
 
 /** @} */ /* end of subsys_tracing_apis_mutex */
 
+/**
+ * @brief Tracing hooks for reader-writer lock events
+ * @defgroup subsys_tracing_apis_rwlock Reader-writer lock
+ * @{
+ */
+
+/**
+ * @brief Trace initialization of reader-writer lock
+ * @param rwlock Reader-writer lock object
+ */
+#define sys_port_trace_k_rwlock_init(rwlock)
+
+/**
+ * @brief Trace reader-writer lock read lock attempt entry
+ * @param rwlock Reader-writer lock object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_rwlock_read_lock_enter(rwlock, timeout)
+
+/**
+ * @brief Trace reader-writer lock read lock attempt blocking
+ * @param rwlock Reader-writer lock object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_rwlock_read_lock_blocking(rwlock, timeout)
+
+/**
+ * @brief Trace reader-writer lock read lock attempt outcome
+ * @param rwlock Reader-writer lock object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_read_lock_exit(rwlock, timeout, ret)
+
+/**
+ * @brief Trace reader-writer lock write lock attempt entry
+ * @param rwlock Reader-writer lock object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_rwlock_write_lock_enter(rwlock, timeout)
+
+/**
+ * @brief Trace reader-writer lock write lock attempt blocking
+ * @param rwlock Reader-writer lock object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_rwlock_write_lock_blocking(rwlock, timeout)
+
+/**
+ * @brief Trace reader-writer lock write lock attempt outcome
+ * @param rwlock Reader-writer lock object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_write_lock_exit(rwlock, timeout, ret)
+
+/**
+ * @brief Trace reader-writer lock read unlock entry
+ * @param rwlock Reader-writer lock object
+ */
+#define sys_port_trace_k_rwlock_read_unlock_enter(rwlock)
+
+/**
+ * @brief Trace reader-writer lock read unlock exit
+ * @param rwlock Reader-writer lock object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_read_unlock_exit(rwlock, ret)
+
+/**
+ * @brief Trace reader-writer lock write unlock entry
+ * @param rwlock Reader-writer lock object
+ */
+#define sys_port_trace_k_rwlock_write_unlock_enter(rwlock)
+
+/**
+ * @brief Trace reader-writer lock write unlock exit
+ * @param rwlock Reader-writer lock object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_write_unlock_exit(rwlock, ret)
+
+/** @} */ /* end of subsys_tracing_apis_rwlock */
+
 /**
  * @brief Tracing hooks for conditional variable events
  * @defgroup subsys_tracing_apis_condvar Conditional variable
@@ -1371,6 +1455,90 @@
 
 /** @} */ /* end of subsys_tracing_apis_stack */
 
+/**
+ * @brief Tracing hooks for MPMC queue events
+ * @defgroup subsys_tracing_apis_mpmcq MPMC queue
+ * @{
+ */
+
+/**
+ * @brief Trace initialization of MPMC queue
+ * @param mpmcq MPMC queue object
+ */
+#define sys_port_trace_k_mpmcq_init(mpmcq)
+
+/**
+ * @brief Trace MPMC queue alloc init attempt entry
+ * @param mpmcq MPMC queue object
+ */
+#define sys_port_trace_k_mpmcq_alloc_init_enter(mpmcq)
+
+/**
+ * @brief Trace MPMC queue alloc init outcome
+ * @param mpmcq MPMC queue object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_mpmcq_alloc_init_exit(mpmcq, ret)
+
+/**
+ * @brief Trace MPMC queue cleanup attempt entry
+ * @param mpmcq MPMC queue object
+ */
+#define sys_port_trace_k_mpmcq_cleanup_enter(mpmcq)
+
+/**
+ * @brief Trace MPMC queue cleanup outcome
+ * @param mpmcq MPMC queue object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_mpmcq_cleanup_exit(mpmcq, ret)
+
+/**
+ * @brief Trace MPMC queue put attempt entry
+ * @param mpmcq MPMC queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_mpmcq_put_enter(mpmcq, timeout)
+
+/**
+ * @brief Trace MPMC queue put attempt blocking
+ * @param mpmcq MPMC queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_mpmcq_put_blocking(mpmcq, timeout)
+
+/**
+ * @brief Trace MPMC queue put attempt outcome
+ * @param mpmcq MPMC queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_mpmcq_put_exit(mpmcq, timeout, ret)
+
+/**
+ * @brief Trace MPMC queue get attempt entry
+ * @param mpmcq MPMC queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_mpmcq_get_enter(mpmcq, timeout)
+
+/**
+ * @brief Trace MPMC queue get attempt blocking
+ * @param mpmcq MPMC queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_mpmcq_get_blocking(mpmcq, timeout)
+
+/**
+ * @brief Trace MPMC queue get attempt outcome
+ * @param mpmcq MPMC queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_mpmcq_get_exit(mpmcq, timeout, ret)
+
+/** @} */ /* end of subsys_tracing_apis_mpmcq */
+
 /**
  * @brief Tracing hooks for message queue events
  * @defgroup subsys_tracing_apis_msgq Message queue
@@ -1453,6 +1621,28 @@
  */
 #define sys_port_trace_k_msgq_put_front_exit(msgq, timeout, ret)
 
+/**
+ * @brief Trace Message Queue put many attempt entry
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue put many attempt blocking
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue put many attempt outcome
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+
 /**
  * @brief Trace Message Queue get attempt entry
  * @param msgq Message Queue object
@@ -1475,6 +1665,28 @@
  */
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
 
+/**
+ * @brief Trace Message Queue get many attempt entry
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue get many attempt blocking
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue get many attempt outcome
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
+
 /**
  * @brief Trace Message Queue peek
  * @param msgq Message Queue object
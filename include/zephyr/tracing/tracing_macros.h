@@ -141,6 +141,18 @@
 	#define sys_port_trace_type_mask_k_stack(trace_call)
 #endif
 
+#if defined(CONFIG_TRACING_RWLOCK)
+	#define sys_port_trace_type_mask_k_rwlock(trace_call) trace_call
+#else
+	#define sys_port_trace_type_mask_k_rwlock(trace_call)
+#endif
+
+#if defined(CONFIG_TRACING_MPMCQ)
+	#define sys_port_trace_type_mask_k_mpmcq(trace_call) trace_call
+#else
+	#define sys_port_trace_type_mask_k_mpmcq(trace_call)
+#endif
+
 #if defined(CONFIG_TRACING_MESSAGE_QUEUE)
 	#define sys_port_trace_type_mask_k_msgq(trace_call) trace_call
 #else
@@ -99,6 +99,8 @@ extern struct k_event *_track_list_k_event;
 #define sys_port_track_k_condvar_init(condvar, ret)
 #define sys_port_track_k_stack_init(stack) \
 	sys_track_k_stack_init(stack)
+#define sys_port_track_k_mpmcq_init(mpmcq)
+#define sys_port_track_k_rwlock_init(rwlock)
 #define sys_port_track_k_thread_name_set(thread, ret)
 #define sys_port_track_k_sem_reset(sem)
 #define sys_port_track_k_sem_init(sem, ret) \
@@ -156,6 +158,8 @@ void sys_track_socket_init(int sock, int family, int type, int proto);
 #define sys_port_track_k_pipe_init(pipe, buffer, buffer_size)
 #define sys_port_track_k_condvar_init(condvar, ret)
 #define sys_port_track_k_stack_init(stack)
+#define sys_port_track_k_mpmcq_init(mpmcq)
+#define sys_port_track_k_rwlock_init(rwlock)
 #define sys_port_track_k_thread_name_set(thread, ret)
 #define sys_port_track_k_sem_reset(sem)
 #define sys_port_track_k_sem_init(sem, ret)
@@ -5,6 +5,7 @@
  */
 #include <zephyr/kernel.h>
 #include <ksched.h>
+#include <timeout_q.h>
 #include <zephyr/spinlock.h>
 
 extern struct k_spinlock _sched_spinlock;
@@ -41,6 +42,12 @@ static int cpu_mask_mod(k_tid_t thread, uint32_t enable_mask, uint32_t disable_m
 			 "Only one CPU allowed in mask when PIN_ONLY");
 #endif /* defined(CONFIG_ASSERT) && defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	if (ret == 0) {
+		z_migrate_thread_timeout(thread);
+	}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 	return ret;
 }
 
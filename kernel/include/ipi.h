@@ -29,5 +29,12 @@ atomic_val_t ipi_mask_create(struct k_thread *thread);
 #define signal_pending_ipi() do { } while (false)
 #endif /* CONFIG_SMP */
 
+/* defined in ipi.c when CONFIG_OBJ_CORE_STATS_IPI=y */
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+void z_ipi_switch_account(bool switched);
+#else
+#define z_ipi_switch_account(switched) do { } while (false)
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
+
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_IPI_H_ */
@@ -172,6 +172,17 @@ void z_thread_mark_switched_out(void);
 
 #endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
 
+#ifdef CONFIG_RCU
+/* Notes a context switch away from @a thread as an RCU quiescent state */
+void z_rcu_switched_out(struct k_thread *thread);
+
+/* Notes a quiescent state if a timer tick did not interrupt a reader */
+void z_rcu_tick(void);
+
+/* Forgets about a thread aborted within a read-side critical section */
+void z_rcu_thread_abort(struct k_thread *thread);
+#endif /* CONFIG_RCU */
+
 /* Init hook for page frame management, invoked immediately upon entry of
  * main thread, before POST_KERNEL tasks
  */
@@ -208,6 +219,23 @@ bool pm_system_suspend(int32_t ticks);
 
 #endif /* CONFIG_PM */
 
+#ifdef CONFIG_DEMAND_PAGING_STATS
+/**
+ * Record a data page evicted to make room for another page.
+ *
+ * @param addr Virtual address of the evicted data page.
+ */
+void z_paging_stats_evicted(void *addr);
+
+/**
+ * Check whether a page fault is a refault.
+ *
+ * @param addr Virtual address of the faulting data page.
+ * @return True if the data page was recently evicted.
+ */
+bool z_paging_stats_refault(void *addr);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
 /**
  * Initialize the timing histograms for demand paging.
@@ -44,6 +44,11 @@ BUILD_ASSERT(K_LOWEST_APPLICATION_THREAD_PRIO
 #define LOCK_SCHED_SPINLOCK   K_SPINLOCK(&_sched_spinlock)
 #endif
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+/* _thread_base::runq_cpu of a thread that was never made runnable */
+#define RUNQ_CPU_NONE UINT8_MAX
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -329,6 +334,18 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+/**
+ * @brief Timestamps a thread being made ready, for its wakeup latency
+ */
+void z_sched_usage_ready(struct k_thread *thread);
+#else
+static inline void z_sched_usage_ready(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
@@ -28,6 +28,17 @@
 #define _priq_run_remove	z_priq_rb_remove
 #define _priq_run_yield         z_priq_rb_yield
 #define _priq_run_best		z_priq_rb_best
+/* Work Stealing Scheduling */
+#elif defined(CONFIG_SCHED_WORK_STEALING)
+#define _priq_run_init		z_priq_rb_init
+#define _priq_run_add		z_priq_rb_add
+#define _priq_run_remove	z_priq_rb_remove
+#define _priq_run_yield         z_priq_rb_yield
+# if defined(CONFIG_SCHED_CPU_MASK)
+#  define _priq_run_best	z_priq_rb_mask_best
+# else
+#  define _priq_run_best	z_priq_rb_best
+# endif /* CONFIG_SCHED_CPU_MASK */
  /* Multi Queue Scheduling */
 #elif defined(CONFIG_SCHED_MULTIQ)
 #define _priq_run_init		z_priq_mq_init
@@ -183,7 +194,8 @@ static ALWAYS_INLINE struct k_thread *z_priq_simple_mask_best(sys_dlist_t *pq)
 }
 #endif /* CONFIG_SCHED_CPU_MASK */
 
-#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE)
+#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE) || \
+	defined(CONFIG_SCHED_WORK_STEALING)
 static ALWAYS_INLINE void z_priq_rb_init(struct _priq_rb *pq)
 {
 	bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
@@ -245,6 +257,23 @@ static ALWAYS_INLINE struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	}
 	return thread;
 }
+
+#ifdef CONFIG_SCHED_CPU_MASK
+static ALWAYS_INLINE struct k_thread *z_priq_rb_mask_best(struct _priq_rb *pq)
+{
+	/* As with the simple queue, walk the tree in priority order
+	 * looking for one we can run
+	 */
+	struct k_thread *thread;
+
+	RB_FOR_EACH_CONTAINER(&pq->tree, thread, base.qnode_rb) {
+		if ((thread->base.cpu_mask & BIT(_current_cpu->id)) != 0) {
+			return thread;
+		}
+	}
+	return NULL;
+}
+#endif /* CONFIG_SCHED_CPU_MASK */
 #endif
 
 struct prio_info {
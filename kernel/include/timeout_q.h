@@ -13,6 +13,7 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/math_extras.h>
 
 #include <stdbool.h>
 
@@ -27,7 +28,15 @@ extern "C" {
 
 static inline void z_init_timeout(struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* A queued timeout always has dticks >= 1, see z_add_timeout() */
+	to->dticks = 0;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	to->cpu = 0;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+#else
 	sys_dnode_init(&to->node);
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 }
 
 /* Adds the timeout to the queue.
@@ -38,9 +47,23 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 
 int z_abort_timeout(struct _timeout *to);
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Moves a pending timeout to the timeout queue of another CPU */
+void z_migrate_timeout(struct _timeout *to, int cpu);
+
+/* Called from the IPI handler, reprograms the timer of the current CPU
+ * if another CPU changed the first timeout of its queue.
+ */
+void z_timeout_ipi(void);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	return to->dticks <= 0;
+#else
 	return !sys_dnode_is_linked(&to->node);
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 }
 
 static inline bool z_is_aborted_timeout(const struct _timeout *to)
@@ -72,6 +95,19 @@ static inline bool z_is_aborted_thread_timeout(struct k_thread *thread)
 	return z_is_aborted_timeout(&thread->base.timeout);
 }
 
+#if defined(CONFIG_TIMEOUT_QUEUE_PER_CPU) && defined(CONFIG_SCHED_CPU_MASK)
+/* Keeps a pending thread timeout on a CPU the thread is allowed to run on */
+static inline void z_migrate_thread_timeout(struct k_thread *thread)
+{
+	uint32_t mask = thread->base.cpu_mask & BIT_MASK(CONFIG_MP_MAX_NUM_CPUS);
+
+	if ((mask != 0U) && ((mask & BIT(thread->base.timeout.cpu)) == 0U)) {
+		z_migrate_timeout(&thread->base.timeout,
+				  u32_count_trailing_zeros(mask));
+	}
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU && CONFIG_SCHED_CPU_MASK */
+
 int32_t z_get_next_timeout_expiry(void);
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout);
@@ -424,6 +424,10 @@ void z_init_cpu(int id)
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
 	sys_dlist_init(&_kernel.cpus[id].ipi_workq);
 #endif
+
+#ifdef CONFIG_IPI_COALESCE
+	atomic_clear_bit(&_kernel.ipi_in_flight, id);
+#endif
 }
 
 /**
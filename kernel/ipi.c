@@ -7,11 +7,40 @@
 #include <kswap.h>
 #include <ksched.h>
 #include <ipi.h>
+#include <timeout_q.h>
+#include <zephyr/init.h>
+#include <string.h>
 
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
 static struct k_spinlock ipi_lock;
 #endif
 
+#ifdef CONFIG_IPI_COALESCE
+/* Cycle count at which the last IPI was sent to each CPU */
+static uint32_t ipi_sent_at[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
+#ifdef CONFIG_OBJ_CORE_IPI
+struct ipi_cpu {
+	struct k_obj_core  obj_core;
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+	/* Only updated by the CPU itself, under ipi_stats_lock */
+	struct k_ipi_stats stats;
+
+	/* True until the scheduling decision following an IPI is known */
+	bool               switch_pending;
+#endif
+};
+
+static struct k_obj_type obj_type_ipi;
+static struct ipi_cpu ipi_cpus[CONFIG_MP_MAX_NUM_CPUS];
+
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+/* Keeps readers on other CPUs from seeing half updated 64-bit counters */
+static struct k_spinlock ipi_stats_lock;
+#endif
+#endif /* CONFIG_OBJ_CORE_IPI */
+
 #ifdef CONFIG_TRACE_SCHED_IPI
 extern void z_trace_sched_ipi(void);
 #endif
@@ -69,6 +98,78 @@ atomic_val_t ipi_mask_create(struct k_thread *thread)
 	return (atomic_val_t)ipi_mask;
 }
 
+#if defined(CONFIG_IPI_COALESCE) || defined(CONFIG_OBJ_CORE_STATS_IPI)
+#ifdef CONFIG_IPI_COALESCE
+static inline bool ipi_window_elapsed(uint32_t cpu_id, uint32_t now)
+{
+	return (now - ipi_sent_at[cpu_id]) >=
+	       k_us_to_cyc_ceil32(CONFIG_IPI_COALESCE_WINDOW_US);
+}
+#endif /* CONFIG_IPI_COALESCE */
+
+/*
+ * Trim the set of CPUs flagged for an IPI down to those that need to be
+ * sent one, and account for the IPIs about to be sent.  A CPU that has
+ * not yet serviced the last IPI sent to it does not need another: it
+ * clears its in-flight flag before rescheduling, and thus takes note of
+ * any thread readied in the meantime.
+ */
+static uint32_t ipi_targets_get(uint32_t cpu_bitmap)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t id = _current_cpu->id;
+	uint32_t others = BIT_MASK(arch_num_cpus()) & ~BIT(id);
+	uint32_t targets = cpu_bitmap & others;
+
+#ifdef CONFIG_IPI_COALESCE
+	uint32_t now = k_cycle_get_32();
+	uint32_t wanted = targets;
+
+	targets = 0;
+	for (uint32_t i = 0; i < arch_num_cpus(); i++) {
+		if (((wanted & BIT(i)) != 0) &&
+		    (!atomic_test_and_set_bit(&_kernel.ipi_in_flight, i) ||
+		     ipi_window_elapsed(i, now))) {
+			targets |= BIT(i);
+		}
+	}
+
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+	wanted &= ~targets;
+	K_SPINLOCK(&ipi_stats_lock) {
+		ipi_cpus[id].stats.coalesced += sys_count_bits(&wanted, sizeof(wanted));
+	}
+#endif
+#endif /* CONFIG_IPI_COALESCE */
+
+#ifndef CONFIG_ARCH_HAS_DIRECTED_IPIS
+	/* A broadcast IPI reaches all other CPUs */
+	if (targets != 0) {
+		targets = others;
+	}
+#endif
+
+#ifdef CONFIG_IPI_COALESCE
+	atomic_or(&_kernel.ipi_in_flight, (atomic_val_t)targets);
+	for (uint32_t i = 0; i < arch_num_cpus(); i++) {
+		if ((targets & BIT(i)) != 0) {
+			ipi_sent_at[i] = now;
+		}
+	}
+#endif /* CONFIG_IPI_COALESCE */
+
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+	K_SPINLOCK(&ipi_stats_lock) {
+		ipi_cpus[id].stats.sent += sys_count_bits(&targets, sizeof(targets));
+	}
+#endif
+
+	arch_irq_unlock(key);
+
+	return targets;
+}
+#endif /* CONFIG_IPI_COALESCE || CONFIG_OBJ_CORE_STATS_IPI */
+
 void signal_pending_ipi(void)
 {
 	/* Synchronization note: you might think we need to lock these
@@ -84,6 +185,11 @@ void signal_pending_ipi(void)
 		uint32_t  cpu_bitmap;
 
 		cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+#if defined(CONFIG_IPI_COALESCE) || defined(CONFIG_OBJ_CORE_STATS_IPI)
+		if (cpu_bitmap != 0) {
+			cpu_bitmap = ipi_targets_get(cpu_bitmap);
+		}
+#endif
 		if (cpu_bitmap != 0) {
 #ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
 			arch_sched_directed_ipi(cpu_bitmap);
@@ -186,6 +292,22 @@ void z_sched_ipi(void)
 	/* NOTE: When adding code to this, make sure this is called
 	 * at appropriate location when !CONFIG_SCHED_IPI_SUPPORTED.
 	 */
+#ifdef CONFIG_IPI_COALESCE
+	/* Done first, so that no IPI readying a thread is coalesced
+	 * with this one after the reschedule it triggers.
+	 */
+	atomic_clear_bit(&_kernel.ipi_in_flight, _current_cpu->id);
+#endif /* CONFIG_IPI_COALESCE */
+
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+	K_SPINLOCK(&ipi_stats_lock) {
+		struct ipi_cpu *cpu = &ipi_cpus[_current_cpu->id];
+
+		cpu->stats.received++;
+		cpu->switch_pending = true;
+	}
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
+
 #ifdef CONFIG_TRACE_SCHED_IPI
 	z_trace_sched_ipi();
 #endif /* CONFIG_TRACE_SCHED_IPI */
@@ -200,7 +322,96 @@ void z_sched_ipi(void)
 	arch_ipi_lazy_coprocessors_save();
 #endif
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	z_timeout_ipi();
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
 	ipi_work_process(&_kernel.cpus[_current_cpu->id].ipi_workq);
 #endif
 }
+
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+/* Called with _sched_spinlock held, on the next reschedule of a CPU */
+void z_ipi_switch_account(bool switched)
+{
+	struct ipi_cpu *cpu = &ipi_cpus[_current_cpu->id];
+
+	if (cpu->switch_pending) {
+		K_SPINLOCK(&ipi_stats_lock) {
+			cpu->switch_pending = false;
+			if (switched) {
+				cpu->stats.useful++;
+			} else {
+				cpu->stats.wasted++;
+			}
+		}
+	}
+}
+
+static int ipi_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct ipi_cpu *cpu = CONTAINER_OF(obj_core, struct ipi_cpu, obj_core);
+
+	K_SPINLOCK(&ipi_stats_lock) {
+		memcpy(stats, &cpu->stats, sizeof(cpu->stats));
+	}
+
+	return 0;
+}
+
+static int ipi_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct ipi_cpu *cpu = CONTAINER_OF(obj_core, struct ipi_cpu, obj_core);
+
+	K_SPINLOCK(&ipi_stats_lock) {
+		memset(&cpu->stats, 0, sizeof(cpu->stats));
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc ipi_stats_desc = {
+	.raw_size = sizeof(struct k_ipi_stats),
+	.query_size = sizeof(struct k_ipi_stats),
+	.raw   = ipi_stats_raw,
+	.query = ipi_stats_raw,
+	.reset = ipi_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
+
+#ifdef CONFIG_OBJ_CORE_IPI
+static int init_ipi_obj_core_list(void)
+{
+	/* Initialize IPI object type */
+
+	z_obj_type_init(&obj_type_ipi, K_OBJ_TYPE_IPI_ID,
+			offsetof(struct ipi_cpu, obj_core));
+
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+	k_obj_type_stats_init(&obj_type_ipi, &ipi_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
+
+	/* Initialize and link the per-CPU IPI objects, in CPU order */
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		k_obj_core_init_and_link(K_OBJ_CORE(&ipi_cpus[i]), &obj_type_ipi);
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+		k_obj_core_stats_register(K_OBJ_CORE(&ipi_cpus[i]),
+					  &ipi_cpus[i].stats,
+					  sizeof(struct k_ipi_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_ipi_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_IPI */
@@ -13,6 +13,8 @@
 #include <zephyr/init.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/math_extras.h>
 #include <string.h>
 /* private kernel APIs */
 #include <ksched.h>
@@ -33,6 +35,12 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	((struct k_mem_slab_info *)stats)->num_used = k_mem_slab_num_used_get(slab);
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	((struct k_mem_slab_info *)stats)->max_used = k_mem_slab_max_used_get(slab);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,14 +56,9 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
-#else
-	ptr->max_allocated_bytes = 0;
-#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
+	ptr->max_allocated_bytes = k_mem_slab_max_used_get(slab) * slab->info.block_size;
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -71,7 +74,9 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && defined(CONFIG_MEM_SLAB_LOCKLESS)
+	atomic_set(&slab->max_used, atomic_get(&slab->num_used));
+#elif defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
 	slab->info.max_used = slab->info.num_used;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
@@ -120,6 +125,23 @@ static int create_free_list(struct k_mem_slab *slab)
 		p -= slab->info.block_size;
 	}
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	/* Block indexes are stored off by one, so that 0 means "empty" */
+	slab->index_bits = 32 - u32_count_leading_zeros(slab->info.num_blocks);
+
+	/* leave enough generation tag bits to make ABA unlikely */
+	CHECKIF(slab->index_bits > ATOMIC_BITS - 8) {
+		return -EINVAL;
+	}
+
+	atomic_set(&slab->free_head, slab->info.num_blocks == 0U ? 0 : 1);
+	atomic_set(&slab->num_used, 0);
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_set(&slab->max_used, 0);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+	atomic_set(&slab->num_waiters, 0);
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
+
 	return 0;
 }
 
@@ -219,6 +241,183 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 	       ((offset % slab->info.block_size) == 0);
 }
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+/*
+ * The free list is a lock-free stack.  Its head packs the (1-based)
+ * index of the first free block in the low index_bits of free_head and
+ * a generation tag, bumped on every update, in the remaining bits.  The
+ * tag makes a compare-and-swap fail if the head block was popped and
+ * pushed back in between (the ABA problem), so the "next" link read
+ * from the block is never trusted when it may be stale.
+ */
+static inline atomic_val_t free_head_index(struct k_mem_slab *slab, atomic_val_t head)
+{
+	return head & ((((atomic_val_t)1) << slab->index_bits) - 1);
+}
+
+static inline atomic_val_t free_head_next(struct k_mem_slab *slab, atomic_val_t head,
+					  char *block)
+{
+	atomic_val_t index = 0;
+
+	if (block != NULL) {
+		index = (block - slab->buffer) / slab->info.block_size + 1;
+	}
+
+	/* Shift as unsigned, the tag is allowed to wrap around */
+	return (atomic_val_t)(((((unsigned long)head >> slab->index_bits) + 1UL) <<
+			       slab->index_bits) | index);
+}
+
+static char *free_list_pop(struct k_mem_slab *slab)
+{
+	atomic_val_t head;
+	atomic_val_t index;
+	char *block;
+
+	do {
+		head = atomic_get(&slab->free_head);
+		index = free_head_index(slab, head);
+		if (index == 0) {
+			return NULL;
+		}
+		block = slab->buffer + (index - 1) * slab->info.block_size;
+	} while (!atomic_cas(&slab->free_head, head,
+			     free_head_next(slab, head, *(char **)block)));
+
+	return block;
+}
+
+static void free_list_push(struct k_mem_slab *slab, char *block)
+{
+	atomic_val_t head;
+	atomic_val_t index;
+
+	do {
+		head = atomic_get(&slab->free_head);
+		index = free_head_index(slab, head);
+		*(char **)block = index == 0 ? NULL :
+				  slab->buffer + (index - 1) * slab->info.block_size;
+	} while (!atomic_cas(&slab->free_head, head, free_head_next(slab, head, block)));
+}
+
+static void account_alloc(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_val_t used = atomic_inc(&slab->num_used) + 1;
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(&slab->max_used);
+	} while ((used > max) && !atomic_cas(&slab->max_used, max, used));
+#else
+	(void)atomic_inc(&slab->num_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+
+	*mem = free_list_pop(slab);
+	if (*mem != NULL) {
+		account_alloc(slab);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || !IS_ENABLED(CONFIG_MULTITHREADING)) {
+		/* don't wait for a free block to become available */
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, -ENOMEM);
+
+		return -ENOMEM;
+	}
+
+	/* Announce ourselves before looking at the free list one last
+	 * time: a concurrent k_mem_slab_free() either pushed its block
+	 * early enough for us to see it, or sees num_waiters and takes
+	 * the lock to hand the block over once we are pending.
+	 */
+	key = k_spin_lock(&slab->lock);
+	(void)atomic_inc(&slab->num_waiters);
+
+	*mem = free_list_pop(slab);
+	if (*mem != NULL) {
+		(void)atomic_dec(&slab->num_waiters);
+		k_spin_unlock(&slab->lock, key);
+		account_alloc(slab);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mem_slab, alloc, slab, timeout);
+
+	/* wait for a free block or timeout */
+	result = z_pend_curr(&slab->lock, key, &slab->wait_q, timeout);
+	(void)atomic_dec(&slab->num_waiters);
+	if (result == 0) {
+		*mem = _current->base.swap_data;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
+
+	return result;
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
+{
+	if (!slab_ptr_is_good(slab, mem)) {
+		__ASSERT(false, "Invalid memory pointer provided");
+		k_panic();
+		return;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+	(void)atomic_dec(&slab->num_used);
+	free_list_push(slab, mem);
+
+	if (likely(atomic_get(&slab->num_waiters) == 0) || !IS_ENABLED(CONFIG_MULTITHREADING)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+
+	/* Some thread may be pending: take a block back (not
+	 * necessarily ours) before looking for it, as it may time out
+	 * until it is unpended under the scheduler lock.
+	 */
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	char *block = free_list_pop(slab);
+
+	if (block != NULL) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+		if (pending_thread != NULL) {
+			account_alloc(slab);
+
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+			z_thread_return_value_set_with_data(pending_thread, 0, block);
+			z_ready_thread(pending_thread);
+			z_reschedule(&slab->lock, key);
+			return;
+		}
+
+		free_list_push(slab, block);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+	k_spin_unlock(&slab->lock, key);
+}
+#else
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
@@ -299,6 +498,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 
 	k_spin_unlock(&slab->lock, key);
 }
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
 
 int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stats *stats)
 {
@@ -308,15 +508,10 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			    slab->info.block_size;
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	stats->max_allocated_bytes = slab->info.max_used *
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	stats->max_allocated_bytes = k_mem_slab_max_used_get(slab) *
 				     slab->info.block_size;
-#else
-	stats->max_allocated_bytes = 0;
-#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
 	k_spin_unlock(&slab->lock, key);
 
@@ -332,7 +527,11 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	atomic_set(&slab->max_used, atomic_get(&slab->num_used));
+#else
 	slab->info.max_used = slab->info.num_used;
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
 
 	k_spin_unlock(&slab->lock, key);
 
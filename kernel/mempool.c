@@ -5,12 +5,276 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/init.h>
 #include <string.h>
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/util.h>
+#include <wait_q.h>
 
 typedef void * (sys_heap_allocator_t)(struct sys_heap *heap, size_t align, size_t bytes);
 
+#if defined(CONFIG_KERNEL_MEM_POOL_CACHE) && (K_HEAP_MEM_POOL_SIZE > 0)
+
+/* Size classes are powers of two, from 16 bytes up to the configured
+ * maximum.  A class holds blocks whose usable size is at least the
+ * class size, so any block of a class can serve any request of it.
+ */
+#define CACHE_MIN_SHIFT   4
+#define CACHE_NUM_CLASSES (LOG2CEIL(CONFIG_KERNEL_MEM_POOL_CACHE_MAX_SIZE) - CACHE_MIN_SHIFT + 1)
+#define CACHE_DEPTH       CONFIG_KERNEL_MEM_POOL_CACHE_DEPTH
+#define CACHE_BATCH       (CACHE_DEPTH / 2)
+
+struct malloc_cache {
+	struct k_spinlock lock;
+	uint8_t count[CACHE_NUM_CLASSES];
+	void *blocks[CACHE_NUM_CLASSES][CACHE_DEPTH];
+};
+
+extern struct k_heap _system_heap;
+
+static struct malloc_cache malloc_caches[CONFIG_MP_MAX_NUM_CPUS];
+
+#ifdef CONFIG_SYS_HEAP_CACHE_STATS
+static struct sys_heap_cache_stats malloc_cache_stats[CONFIG_MP_MAX_NUM_CPUS];
+
+#define CACHE_STATS_INC(cpu, field)      (malloc_cache_stats[cpu].field++)
+#define CACHE_STATS_ADD(cpu, field, val) (malloc_cache_stats[cpu].field += (val))
+#define CACHE_STATS_SUB(cpu, field, val) (malloc_cache_stats[cpu].field -= (val))
+#else
+#define CACHE_STATS_INC(cpu, field)      do { } while (false)
+#define CACHE_STATS_ADD(cpu, field, val) do { } while (false)
+#define CACHE_STATS_SUB(cpu, field, val) do { } while (false)
+#endif /* CONFIG_SYS_HEAP_CACHE_STATS */
+
+static inline size_t class_size(int cls)
+{
+	return (size_t)1 << (cls + CACHE_MIN_SHIFT);
+}
+
+/* Smallest class able to serve a request, or -1 */
+static int alloc_class(size_t bytes)
+{
+	int cls = 0;
+
+	while ((cls < CACHE_NUM_CLASSES) && (class_size(cls) < bytes)) {
+		cls++;
+	}
+
+	return cls < CACHE_NUM_CLASSES ? cls : -1;
+}
+
+/* Largest class a block of the given usable size fits in, or -1 if the
+ * block is so much larger than any class that caching it would waste
+ * memory.
+ */
+static int free_class(size_t usable)
+{
+	int cls = CACHE_NUM_CLASSES - 1;
+
+	while ((cls >= 0) && (class_size(cls) > usable)) {
+		cls--;
+	}
+
+	return ((cls >= 0) && (usable < 2 * class_size(cls))) ? cls : -1;
+}
+
+/* Locks and returns the cache of the CPU we run on.  Interrupts are
+ * masked before picking the cache, so we cannot migrate between
+ * picking the cache and locking it.  The returned key carries the
+ * interrupt state from before that, so that k_spin_unlock() restores
+ * it.
+ */
+static struct malloc_cache *local_cache_lock(k_spinlock_key_t *key, int *cpu)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct malloc_cache *cache;
+
+	*cpu = _current_cpu->id;
+	cache = &malloc_caches[*cpu];
+	*key = k_spin_lock(&cache->lock);
+	key->key = irq_key;
+
+	return cache;
+}
+
+static void *malloc_cache_alloc(struct k_heap *heap, size_t align, size_t bytes)
+{
+	struct malloc_cache *cache;
+	k_spinlock_key_t key;
+	void *mem = NULL;
+	int cls = alloc_class(bytes);
+	int cpu;
+
+	if ((heap != &_system_heap) || (align > sizeof(void *)) || (cls < 0)) {
+		return NULL;
+	}
+
+	cache = local_cache_lock(&key, &cpu);
+
+	if (cache->count[cls] == 0U) {
+		k_spinlock_key_t heap_key = k_spin_lock(&heap->lock);
+
+		CACHE_STATS_INC(cpu, misses);
+
+		while (cache->count[cls] < CACHE_BATCH) {
+			mem = sys_heap_alloc(&heap->heap, class_size(cls));
+			if (mem == NULL) {
+				break;
+			}
+			cache->blocks[cls][cache->count[cls]++] = mem;
+			CACHE_STATS_ADD(cpu, cached_bytes, class_size(cls));
+		}
+
+		k_spin_unlock(&heap->lock, heap_key);
+
+		if (cache->count[cls] != 0U) {
+			CACHE_STATS_INC(cpu, refills);
+		}
+	} else {
+		CACHE_STATS_INC(cpu, hits);
+	}
+
+	if (cache->count[cls] != 0U) {
+		mem = cache->blocks[cls][--cache->count[cls]];
+		CACHE_STATS_SUB(cpu, cached_bytes, class_size(cls));
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	return mem;
+}
+
+static bool malloc_cache_flush(struct k_heap *heap);
+
+static bool malloc_cache_free(struct k_heap *heap, void *mem)
+{
+	struct malloc_cache *cache;
+	k_spinlock_key_t key;
+	int cls;
+	int cpu;
+
+	if (heap != &_system_heap) {
+		return false;
+	}
+
+	/* Threads blocked in k_heap_alloc() on the system heap are only
+	 * woken by k_heap_free() and never look into the caches, so hand
+	 * them every cached block as well as this one.  Peeking at the
+	 * wait queue without the heap lock is fine: a thread that pends
+	 * right after we looked is no worse off than one that pended
+	 * after the block had been cached.
+	 */
+	if (IS_ENABLED(CONFIG_MULTITHREADING) && (z_waitq_head(&heap->wait_q) != NULL)) {
+		(void)malloc_cache_flush(heap);
+		return false;
+	}
+
+	/* The size of an allocated chunk cannot change under our feet,
+	 * so it is safe to look at it without the heap lock.
+	 */
+	cls = free_class(sys_heap_usable_size(&heap->heap, mem));
+	if (cls < 0) {
+		return false;
+	}
+
+	cache = local_cache_lock(&key, &cpu);
+
+	if (cache->count[cls] == CACHE_DEPTH) {
+		/* Return the oldest half of the cached blocks */
+		k_spinlock_key_t heap_key = k_spin_lock(&heap->lock);
+
+		for (int i = 0; i < CACHE_BATCH; i++) {
+			sys_heap_free(&heap->heap, cache->blocks[cls][i]);
+		}
+
+		k_spin_unlock(&heap->lock, heap_key);
+
+		cache->count[cls] -= CACHE_BATCH;
+		memmove(&cache->blocks[cls][0], &cache->blocks[cls][CACHE_BATCH],
+			cache->count[cls] * sizeof(void *));
+		CACHE_STATS_INC(cpu, drains);
+		CACHE_STATS_SUB(cpu, cached_bytes, CACHE_BATCH * class_size(cls));
+	}
+
+	cache->blocks[cls][cache->count[cls]++] = mem;
+	CACHE_STATS_ADD(cpu, cached_bytes, class_size(cls));
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+/* Returns every cached block to the heap, so that an allocation which
+ * failed can be retried against the whole heap.  Must not be called
+ * with a cache or the heap lock held.
+ */
+static bool malloc_cache_flush(struct k_heap *heap)
+{
+	bool flushed = false;
+
+	if (heap != &_system_heap) {
+		return false;
+	}
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct malloc_cache *cache = &malloc_caches[cpu];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+		k_spinlock_key_t heap_key = k_spin_lock(&heap->lock);
+
+		for (int cls = 0; cls < CACHE_NUM_CLASSES; cls++) {
+			while (cache->count[cls] != 0U) {
+				sys_heap_free(&heap->heap, cache->blocks[cls][--cache->count[cls]]);
+				CACHE_STATS_SUB(cpu, cached_bytes, class_size(cls));
+				flushed = true;
+			}
+		}
+
+		k_spin_unlock(&heap->lock, heap_key);
+		k_spin_unlock(&cache->lock, key);
+	}
+
+	return flushed;
+}
+
+#ifdef CONFIG_SYS_HEAP_CACHE_STATS
+static int malloc_cache_init(void)
+{
+	_system_heap.heap.cache_stats = malloc_cache_stats;
+
+	return 0;
+}
+
+SYS_INIT(malloc_cache_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_SYS_HEAP_CACHE_STATS */
+
+#else
+
+static inline void *malloc_cache_alloc(struct k_heap *heap, size_t align, size_t bytes)
+{
+	ARG_UNUSED(heap);
+	ARG_UNUSED(align);
+	ARG_UNUSED(bytes);
+
+	return NULL;
+}
+
+static inline bool malloc_cache_free(struct k_heap *heap, void *mem)
+{
+	ARG_UNUSED(heap);
+	ARG_UNUSED(mem);
+
+	return false;
+}
+
+static inline bool malloc_cache_flush(struct k_heap *heap)
+{
+	ARG_UNUSED(heap);
+
+	return false;
+}
+
+#endif /* CONFIG_KERNEL_MEM_POOL_CACHE && K_HEAP_MEM_POOL_SIZE > 0 */
+
 static void *z_alloc_helper(struct k_heap *heap, size_t align, size_t size,
 			    sys_heap_allocator_t sys_heap_allocator)
 {
@@ -34,16 +298,21 @@ static void *z_alloc_helper(struct k_heap *heap, size_t align, size_t size,
 	}
 	__align = align | sizeof(heap_ref);
 
+	mem = malloc_cache_alloc(heap, align, size);
+
 	/*
 	 * No point calling k_heap_malloc/k_heap_aligned_alloc with K_NO_WAIT.
 	 * Better bypass them and go directly to sys_heap_*() instead.
 	 */
-	key = k_spin_lock(&heap->lock);
-	mem = sys_heap_allocator(&heap->heap, __align, size);
-	k_spin_unlock(&heap->lock, key);
-
-	if (mem == NULL) {
-		return NULL;
+	while (mem == NULL) {
+		key = k_spin_lock(&heap->lock);
+		mem = sys_heap_allocator(&heap->heap, __align, size);
+		k_spin_unlock(&heap->lock, key);
+
+		/* Free memory may be sitting in the per-CPU caches */
+		if ((mem == NULL) && !malloc_cache_flush(heap)) {
+			return NULL;
+		}
 	}
 
 	heap_ref = mem;
@@ -66,7 +335,9 @@ void k_free(void *ptr)
 
 		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_free, *heap_ref, heap_ref);
 
-		k_heap_free(*heap_ref, ptr);
+		if (!malloc_cache_free(*heap_ref, ptr)) {
+			k_heap_free(*heap_ref, ptr);
+		}
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_free, *heap_ref, heap_ref);
 	}
@@ -1519,13 +1519,18 @@ out:
 }
 
 static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
-					   int key)
+					   int key, void *addr)
 {
 #ifdef CONFIG_DEMAND_PAGING_STATS
 	bool is_irq_unlocked = arch_irq_unlocked(key);
+	bool is_refault = z_paging_stats_refault(addr);
 
 	paging_stats.pagefaults.cnt++;
 
+	if (is_refault) {
+		paging_stats.pagefaults.refaults++;
+	}
+
 	if (is_irq_unlocked) {
 		paging_stats.pagefaults.irq_unlocked++;
 	} else {
@@ -1535,6 +1540,10 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 #ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
 	faulting_thread->paging_stats.pagefaults.cnt++;
 
+	if (is_refault) {
+		faulting_thread->paging_stats.pagefaults.refaults++;
+	}
+
 	if (is_irq_unlocked) {
 		faulting_thread->paging_stats.pagefaults.irq_unlocked++;
 	} else {
@@ -1553,13 +1562,18 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
 	}
 #endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+#else
+	ARG_UNUSED(addr);
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
 static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
+					     struct k_mem_page_frame *pf,
 					     bool dirty)
 {
 #ifdef CONFIG_DEMAND_PAGING_STATS
+	z_paging_stats_evicted(k_mem_page_frame_to_virt(pf));
+
 	if (dirty) {
 		paging_stats.eviction.dirty++;
 	} else {
@@ -1574,6 +1588,8 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #else
 	ARG_UNUSED(faulting_thread);
 #endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#else
+	ARG_UNUSED(pf);
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
@@ -1709,7 +1725,7 @@ static bool do_page_fault(void *addr, bool pin)
 	__ASSERT(status == ARCH_PAGE_LOCATION_PAGED_OUT,
 		 "unexpected status value %d", status);
 
-	paging_stats_faults_inc(faulting_thread, key.key);
+	paging_stats_faults_inc(faulting_thread, key.key, addr);
 
 	pf = free_page_frame_list_get();
 	if (pf == NULL) {
@@ -1720,7 +1736,7 @@ static bool do_page_fault(void *addr, bool pin)
 			k_mem_page_frame_to_virt(pf),
 			k_mem_page_frame_to_phys(pf));
 
-		paging_stats_eviction_inc(faulting_thread, dirty);
+		paging_stats_eviction_inc(faulting_thread, pf, dirty);
 	}
 	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
 	__ASSERT(ret == 0, "failed to prepare page frame");
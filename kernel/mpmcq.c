@@ -0,0 +1,345 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Bounded multi-producer multi-consumer queue object
+ *
+ * Values are stored in a ring of slots. Each slot carries a sequence number
+ * telling whether it is free for, or holds a value for, a given position in
+ * the queue. Producers and consumers claim positions with a compare and swap
+ * on the tail and head, then write or read the slot and publish its new
+ * sequence number, so that no lock is taken while the queue is neither full
+ * nor empty.
+ *
+ * The queue lock is only used to pend threads on a full or empty queue, and
+ * to wake them up. Pending threads are counted, so that putting and getting
+ * values does not take the lock unless somebody waits.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <kernel_internal.h>
+
+/*
+ * With a single slot, the sequence number of a slot holding a value (lap + 1)
+ * would equal that of a slot free for the next lap (lap + size), so that a
+ * producer could overwrite a value nobody has read yet.
+ */
+static inline bool mpmcq_size_valid(uint32_t num_slots)
+{
+	return IS_POWER_OF_TWO(num_slots) && (num_slots >= 2U);
+}
+
+/* Positions wrap around, do the arithmetic on unsigned values */
+static inline atomic_val_t pos_add(atomic_val_t pos, unsigned long n)
+{
+	return (atomic_val_t)((unsigned long)pos + n);
+}
+
+static inline atomic_val_t pos_diff(atomic_val_t a, atomic_val_t b)
+{
+	return (atomic_val_t)((unsigned long)a - (unsigned long)b);
+}
+
+/*
+ * The sequence number of a slot is kept relative to its index, so that a
+ * zeroed slot array is a valid empty queue. For the position pos, whose
+ * slot index is (pos & mask) and whose lap is (pos & ~mask), the slot
+ * sequence number is:
+ *
+ * - lap when the slot is free to be written,
+ * - lap + 1 when the slot holds the value written at pos,
+ * - lap + size once that value has been read, i.e. the slot is free for the
+ *   next lap.
+ */
+static int mpmcq_try_put(struct k_mpmcq *mpmcq, uintptr_t data)
+{
+	atomic_val_t pos = atomic_get(&mpmcq->tail);
+	struct k_mpmcq_slot *slot;
+	atomic_val_t lap;
+
+	while (true) {
+		slot = &mpmcq->slots[pos & mpmcq->mask];
+		lap = pos & ~(atomic_val_t)mpmcq->mask;
+
+		atomic_val_t diff = pos_diff(atomic_get(&slot->seq), lap);
+
+		if (diff == 0) {
+			if (atomic_cas(&mpmcq->tail, pos, pos_add(pos, 1))) {
+				break;
+			}
+			pos = atomic_get(&mpmcq->tail);
+		} else if (diff < 0) {
+			/* Slot still holds the value of the previous lap */
+			return -ENOMSG;
+		} else {
+			/* Another producer claimed the position */
+			pos = atomic_get(&mpmcq->tail);
+		}
+	}
+
+	slot->data = data;
+	(void)atomic_set(&slot->seq, pos_add(lap, 1));
+
+	return 0;
+}
+
+static int mpmcq_try_get(struct k_mpmcq *mpmcq, uintptr_t *data)
+{
+	atomic_val_t pos = atomic_get(&mpmcq->head);
+	struct k_mpmcq_slot *slot;
+	atomic_val_t lap;
+
+	while (true) {
+		slot = &mpmcq->slots[pos & mpmcq->mask];
+		lap = pos & ~(atomic_val_t)mpmcq->mask;
+
+		atomic_val_t diff = pos_diff(atomic_get(&slot->seq), pos_add(lap, 1));
+
+		if (diff == 0) {
+			if (atomic_cas(&mpmcq->head, pos, pos_add(pos, 1))) {
+				break;
+			}
+			pos = atomic_get(&mpmcq->head);
+		} else if (diff < 0) {
+			/* Nothing written at this position yet */
+			return -ENOMSG;
+		} else {
+			/* Another consumer claimed the position */
+			pos = atomic_get(&mpmcq->head);
+		}
+	}
+
+	*data = slot->data;
+	(void)atomic_set(&slot->seq, pos_add(lap, (unsigned long)mpmcq->mask + 1UL));
+
+	return 0;
+}
+
+/* Wake up one thread pending on the queue, if any. */
+static void mpmcq_wake(struct k_mpmcq *mpmcq, atomic_t *waiters, _wait_q_t *wait_q)
+{
+	k_spinlock_key_t key;
+
+	if (atomic_get(waiters) == 0) {
+		return;
+	}
+
+	key = k_spin_lock(&mpmcq->lock);
+	if (z_sched_wake(wait_q, 0, NULL)) {
+		z_reschedule(&mpmcq->lock, key);
+	} else {
+		k_spin_unlock(&mpmcq->lock, key);
+	}
+}
+
+/*
+ * Pend until an operation succeeds or the timeout expires.
+ *
+ * The waiter count is raised before the operation is retried under the
+ * lock: a thread completing the opposite operation after that retry is
+ * bound to see the count and wake the pending thread up.
+ */
+static int mpmcq_pend(struct k_mpmcq *mpmcq, atomic_t *waiters, _wait_q_t *wait_q,
+		      int (*op)(struct k_mpmcq *mpmcq, uintptr_t *data), uintptr_t *data,
+		      k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int ret;
+
+	do {
+		key = k_spin_lock(&mpmcq->lock);
+		atomic_inc(waiters);
+
+		ret = op(mpmcq, data);
+		if (ret == 0) {
+			atomic_dec(waiters);
+			k_spin_unlock(&mpmcq->lock, key);
+			break;
+		}
+
+		ret = z_pend_curr(&mpmcq->lock, key, wait_q, timeout);
+		atomic_dec(waiters);
+		if (ret == 0) {
+			/* Woken up, but another thread may have been first */
+			ret = op(mpmcq, data);
+		}
+
+		timeout = sys_timepoint_timeout(end);
+	} while ((ret != 0) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT));
+
+	return (ret == 0) ? 0 : -EAGAIN;
+}
+
+static int mpmcq_put_op(struct k_mpmcq *mpmcq, uintptr_t *data)
+{
+	return mpmcq_try_put(mpmcq, *data);
+}
+
+void k_mpmcq_init(struct k_mpmcq *mpmcq, struct k_mpmcq_slot *buffer,
+		  uint32_t num_slots)
+{
+	__ASSERT(mpmcq_size_valid(num_slots),
+		 "MPMC queue size must be a power of two, at least 2");
+
+	atomic_set(&mpmcq->tail, 0);
+	atomic_set(&mpmcq->head, 0);
+	mpmcq->slots = buffer;
+	mpmcq->mask = num_slots - 1U;
+	atomic_set(&mpmcq->put_waiters, 0);
+	atomic_set(&mpmcq->get_waiters, 0);
+	mpmcq->lock = (struct k_spinlock) {};
+	z_waitq_init(&mpmcq->put_wait_q);
+	z_waitq_init(&mpmcq->get_wait_q);
+	mpmcq->flags = 0U;
+
+	for (uint32_t i = 0; i < num_slots; i++) {
+		atomic_set(&buffer[i].seq, 0);
+	}
+
+	SYS_PORT_TRACING_OBJ_INIT(k_mpmcq, mpmcq);
+
+	k_object_init(mpmcq);
+}
+
+int z_impl_k_mpmcq_alloc_init(struct k_mpmcq *mpmcq, uint32_t num_slots)
+{
+	void *buffer;
+	int ret;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mpmcq, alloc_init, mpmcq);
+
+	if (!mpmcq_size_valid(num_slots)) {
+		ret = -EINVAL;
+	} else {
+		buffer = z_thread_malloc(num_slots * sizeof(struct k_mpmcq_slot));
+		if (buffer != NULL) {
+			k_mpmcq_init(mpmcq, buffer, num_slots);
+			mpmcq->flags = K_MPMCQ_FLAG_ALLOC;
+			ret = 0;
+		} else {
+			ret = -ENOMEM;
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mpmcq, alloc_init, mpmcq, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_mpmcq_alloc_init(struct k_mpmcq *mpmcq, uint32_t num_slots)
+{
+	size_t total_size;
+
+	K_OOPS(K_SYSCALL_OBJ_NEVER_INIT(mpmcq, K_OBJ_MPMCQ));
+	K_OOPS(K_SYSCALL_VERIFY(!size_mul_overflow(num_slots, sizeof(struct k_mpmcq_slot),
+						   &total_size)));
+	return z_impl_k_mpmcq_alloc_init(mpmcq, num_slots);
+}
+#include <zephyr/syscalls/k_mpmcq_alloc_init_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int k_mpmcq_cleanup(struct k_mpmcq *mpmcq)
+{
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mpmcq, cleanup, mpmcq);
+
+	CHECKIF((z_waitq_head(&mpmcq->put_wait_q) != NULL) ||
+		(z_waitq_head(&mpmcq->get_wait_q) != NULL)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mpmcq, cleanup, mpmcq, -EBUSY);
+
+		return -EBUSY;
+	}
+
+	if ((mpmcq->flags & K_MPMCQ_FLAG_ALLOC) != 0U) {
+		k_free(mpmcq->slots);
+		mpmcq->slots = NULL;
+		mpmcq->flags &= ~K_MPMCQ_FLAG_ALLOC;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mpmcq, cleanup, mpmcq, 0);
+
+	return 0;
+}
+
+int z_impl_k_mpmcq_put(struct k_mpmcq *mpmcq, uintptr_t data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mpmcq, put, mpmcq, timeout);
+
+	int ret = mpmcq_try_put(mpmcq, data);
+
+	if ((ret != 0) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mpmcq, put, mpmcq, timeout);
+
+		ret = mpmcq_pend(mpmcq, &mpmcq->put_waiters, &mpmcq->put_wait_q,
+				 mpmcq_put_op, &data, timeout);
+	}
+
+	if (ret == 0) {
+		mpmcq_wake(mpmcq, &mpmcq->get_waiters, &mpmcq->get_wait_q);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mpmcq, put, mpmcq, timeout, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_mpmcq_put(struct k_mpmcq *mpmcq, uintptr_t data,
+				     k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(mpmcq, K_OBJ_MPMCQ));
+
+	return z_impl_k_mpmcq_put(mpmcq, data, timeout);
+}
+#include <zephyr/syscalls/k_mpmcq_put_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_mpmcq_get(struct k_mpmcq *mpmcq, uintptr_t *data, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mpmcq, get, mpmcq, timeout);
+
+	int ret = mpmcq_try_get(mpmcq, data);
+
+	if ((ret != 0) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mpmcq, get, mpmcq, timeout);
+
+		ret = mpmcq_pend(mpmcq, &mpmcq->get_waiters, &mpmcq->get_wait_q,
+				 mpmcq_try_get, data, timeout);
+	}
+
+	if (ret == 0) {
+		mpmcq_wake(mpmcq, &mpmcq->put_waiters, &mpmcq->put_wait_q);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mpmcq, get, mpmcq, timeout, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_mpmcq_get(struct k_mpmcq *mpmcq, uintptr_t *data,
+				     k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(mpmcq, K_OBJ_MPMCQ));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(uintptr_t)));
+
+	return z_impl_k_mpmcq_get(mpmcq, data, timeout);
+}
+#include <zephyr/syscalls/k_mpmcq_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
@@ -253,6 +253,123 @@ static inline int z_vrfy_k_msgq_put_front(struct k_msgq *msgq, const void *data)
 #include <zephyr/syscalls/k_msgq_put_front_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Copies as many of @a num_msgs messages as fit from @a data to the back
+ * of the ring buffer, and returns the number of messages copied.
+ */
+static uint32_t copy_to_buffer(struct k_msgq *msgq, const char *data,
+			       uint32_t num_msgs)
+{
+	uint32_t count = MIN(num_msgs, msgq->max_msgs - msgq->used_msgs);
+	size_t bytes = count * msgq->msg_size;
+	size_t bytes_to_end = msgq->buffer_end - msgq->write_ptr;
+
+	if (bytes >= bytes_to_end) {
+		/* wrap-around */
+		(void)memcpy(msgq->write_ptr, data, bytes_to_end);
+		(void)memcpy(msgq->buffer_start, data + bytes_to_end,
+			     bytes - bytes_to_end);
+		msgq->write_ptr = msgq->buffer_start + (bytes - bytes_to_end);
+	} else {
+		(void)memcpy(msgq->write_ptr, data, bytes);
+		msgq->write_ptr += bytes;
+	}
+	msgq->used_msgs += count;
+
+	return count;
+}
+
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	int result;
+	bool resched = false;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_many, msgq, timeout);
+
+	/* give messages to waiting threads first */
+	while ((count < num_msgs) && (msgq->used_msgs < msgq->max_msgs)) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)memcpy(pending_thread->base.swap_data,
+			     src + (count * msgq->msg_size), msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+		count++;
+	}
+
+	if (count < num_msgs) {
+		uint32_t copied = copy_to_buffer(msgq,
+						 src + (count * msgq->msg_size),
+						 num_msgs - count);
+
+		if (copied != 0U) {
+			count += copied;
+			resched = handle_poll_events(msgq) || resched;
+		}
+	}
+
+	if ((count != 0U) || (num_msgs == 0U)) {
+		result = (int)count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put_many, msgq, timeout);
+
+		/* wait until the first message is taken, then send the rest
+		 * without waiting again
+		 */
+		_current->base.swap_data = (void *)src;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if ((result == 0) && (num_msgs > 1U)) {
+			int more = z_impl_k_msgq_put_many(msgq, src + msgq->msg_size,
+							  num_msgs - 1U, K_NO_WAIT);
+
+			result = (more > 0) ? (more + 1) : 1;
+		} else if (result == 0) {
+			result = 1;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_put_many_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
@@ -352,6 +469,112 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <zephyr/syscalls/k_msgq_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Copies up to @a num_msgs messages from the front of the ring buffer to
+ * @a data, and returns the number of messages copied.
+ */
+static uint32_t copy_from_buffer(struct k_msgq *msgq, char *data,
+				 uint32_t num_msgs)
+{
+	uint32_t count = MIN(num_msgs, msgq->used_msgs);
+	size_t bytes = count * msgq->msg_size;
+	size_t bytes_to_end = msgq->buffer_end - msgq->read_ptr;
+
+	if (bytes >= bytes_to_end) {
+		/* wrap-around */
+		(void)memcpy(data, msgq->read_ptr, bytes_to_end);
+		(void)memcpy(data + bytes_to_end, msgq->buffer_start,
+			     bytes - bytes_to_end);
+		msgq->read_ptr = msgq->buffer_start + (bytes - bytes_to_end);
+	} else {
+		(void)memcpy(data, msgq->read_ptr, bytes);
+		msgq->read_ptr += bytes;
+	}
+	msgq->used_msgs -= count;
+
+	return count;
+}
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	char *dst = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count;
+	int result;
+	bool resched = false;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_many, msgq, timeout);
+
+	count = copy_from_buffer(msgq, dst, num_msgs);
+
+	/* refill the space just freed from threads waiting to write */
+	while ((count != 0U) && (msgq->used_msgs < msgq->max_msgs)) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		(void)copy_to_buffer(msgq, pending_thread->base.swap_data, 1U);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+	}
+
+	if ((count != 0U) || (num_msgs == 0U)) {
+		result = (int)count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get_many, msgq, timeout);
+
+		/* wait for a first message, then take what else is
+		 * available without waiting again
+		 */
+		_current->base.swap_data = dst;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if ((result == 0) && (num_msgs > 1U)) {
+			int more = z_impl_k_msgq_get_many(msgq, dst + msgq->msg_size,
+							  num_msgs - 1U, K_NO_WAIT);
+
+			result = (more > 0) ? (more + 1) : 1;
+		} else if (result == 0) {
+			result = 1;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_get_many_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -52,6 +52,35 @@ static struct k_spinlock lock;
 static struct k_obj_type obj_type_mutex;
 #endif /* CONFIG_OBJ_CORE_MUTEX */
 
+/* Statistics are updated with the lock held */
+static inline void mutex_stats_acquired(struct k_mutex *mutex)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex->stats.acquired++;
+	mutex->owned_since = k_cycle_get_32();
+#else
+	ARG_UNUSED(mutex);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+}
+
+static inline void mutex_stats_released(struct k_mutex *mutex)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	uint32_t held = k_cycle_get_32() - mutex->owned_since;
+
+	mutex->stats.hold_cycles += held;
+	mutex->stats.hold_max = MAX(mutex->stats.hold_max, held);
+#else
+	ARG_UNUSED(mutex);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+#define MUTEX_STATS_INC(mutex, counter) ((mutex)->stats.counter++)
+#else
+#define MUTEX_STATS_INC(mutex, counter) do { } while (false)
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
@@ -65,6 +94,12 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 	k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
 #endif /* CONFIG_OBJ_CORE_MUTEX */
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	memset(&mutex->stats, 0, sizeof(mutex->stats));
+	k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->stats,
+				  sizeof(struct k_mutex_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
 
 	return 0;
@@ -102,6 +137,72 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static bool owner_running(struct k_thread *owner)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		if (_kernel.cpus[i].current == owner) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Spin while the owner of the mutex is running on another CPU, for at most
+ * CONFIG_MUTEX_ADAPTIVE_SPIN_US, in the hope that it unlocks the mutex
+ * soon. The lock is released while spinning, so that the owner can unlock
+ * the mutex and the caller can be preempted. It is held again on return.
+ *
+ * Returns true if the mutex was acquired.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+	struct k_thread *owner = mutex->owner;
+
+	if (!owner_running(owner)) {
+		return false;
+	}
+
+	MUTEX_STATS_INC(mutex, spun);
+
+	do {
+		k_spin_unlock(&lock, *key);
+
+		/* Unlocked reads, only used as hints */
+		while ((mutex->owner == owner) && owner_running(owner) &&
+		       ((k_cycle_get_32() - start) < budget)) {
+			arch_spin_relax();
+			compiler_barrier();
+		}
+
+		*key = k_spin_lock(&lock);
+
+		if (mutex->lock_count == 0U) {
+			mutex->owner_orig_prio = _current->base.prio;
+			mutex->lock_count = 1U;
+			mutex->owner = _current;
+			MUTEX_STATS_INC(mutex, spin_acquired);
+			mutex_stats_acquired(mutex);
+
+			LOG_DBG("%p took mutex %p after spinning", _current, mutex);
+
+			return true;
+		}
+
+		/* The mutex was handed over to a pending thread */
+		owner = mutex->owner;
+	} while (owner_running(owner) && ((k_cycle_get_32() - start) < budget));
+
+	return false;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -116,9 +217,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
+		if (mutex->lock_count == 0U) {
+			mutex->owner_orig_prio = _current->base.prio;
+			mutex_stats_acquired(mutex);
+		}
 
 		mutex->lock_count++;
 		mutex->owner = _current;
@@ -134,6 +236,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return 0;
 	}
 
+	MUTEX_STATS_INC(mutex, contended);
+
 	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
 		k_spin_unlock(&lock, key);
 
@@ -142,8 +246,20 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if (mutex_spin(mutex, &key)) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
+	MUTEX_STATS_INC(mutex, blocked);
+
 	new_prio = new_prio_for_inheritance(_current->base.prio,
 					    mutex->owner->base.prio);
 
@@ -253,6 +369,8 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
 
+	mutex_stats_released(mutex);
+
 	/* Get the new owner, if any */
 	new_owner = z_unpend_first_thread(&mutex->wait_q);
 
@@ -268,6 +386,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		 * adjust its priority
 		 */
 		mutex->owner_orig_prio = new_owner->base.prio;
+		mutex_stats_acquired(mutex);
 		arch_thread_return_value_set(new_owner, 0);
 		z_ready_thread(new_owner);
 		z_reschedule(&lock, key);
@@ -293,6 +412,45 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_OBJ_CORE_MUTEX
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+static int mutex_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_mutex *mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+
+	K_SPINLOCK(&lock) {
+		memcpy(stats, &mutex->stats, sizeof(mutex->stats));
+	}
+
+	return 0;
+}
+
+static int mutex_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_mutex *mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+
+	K_SPINLOCK(&lock) {
+		memset(&mutex->stats, 0, sizeof(mutex->stats));
+		mutex->owned_since = k_cycle_get_32();
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc mutex_stats_desc = {
+	.raw_size = sizeof(struct k_mutex_stats),
+	.query_size = sizeof(struct k_mutex_stats),
+	.raw   = mutex_stats_raw,
+	.query = mutex_stats_raw,
+	.reset = mutex_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 static int init_mutex_obj_core_list(void)
 {
 	/* Initialize mutex object type */
@@ -300,10 +458,18 @@ static int init_mutex_obj_core_list(void)
 	z_obj_type_init(&obj_type_mutex, K_OBJ_TYPE_MUTEX_ID,
 			offsetof(struct k_mutex, obj_core));
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_type_stats_init(&obj_type_mutex, &mutex_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	/* Initialize and link statically defined mutexes */
 
 	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
 		k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->stats,
+					  sizeof(struct k_mutex_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 	}
 
 	return 0;
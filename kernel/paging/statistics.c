@@ -88,6 +88,45 @@ unsigned long k_mem_num_pagefaults_get(void)
 	return ret;
 }
 
+#if CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY > 0
+/*
+ * Ring of the data pages last evicted to make room for other pages.
+ * This only ever gets accessed with z_mm_lock held.
+ */
+static void *paging_evicted[CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY];
+static unsigned int paging_evicted_next;
+#endif /* CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY > 0 */
+
+void z_paging_stats_evicted(void *addr)
+{
+#if CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY > 0
+	paging_evicted[paging_evicted_next] = addr;
+	paging_evicted_next = (paging_evicted_next + 1U) %
+			      CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY;
+#else
+	ARG_UNUSED(addr);
+#endif /* CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY > 0 */
+}
+
+bool z_paging_stats_refault(void *addr)
+{
+#if CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY > 0
+	void *page = UINT_TO_POINTER(ROUND_DOWN(POINTER_TO_UINT(addr), CONFIG_MMU_PAGE_SIZE));
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(paging_evicted); i++) {
+		if (paging_evicted[i] == page) {
+			/* Count a page evicted once as refaulting once */
+			paging_evicted[i] = NULL;
+			return true;
+		}
+	}
+#else
+	ARG_UNUSED(addr);
+#endif /* CONFIG_DEMAND_PAGING_STATS_REFAULT_HISTORY > 0 */
+
+	return false;
+}
+
 void z_impl_k_mem_paging_stats_get(struct k_mem_paging_stats_t *stats)
 {
 	if (stats == NULL) {
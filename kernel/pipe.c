@@ -24,6 +24,26 @@ static inline bool pipe_resetting(struct k_pipe *pipe)
 	return (pipe->flags & PIPE_FLAG_RESET) != 0;
 }
 
+static inline bool pipe_write_claimed(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_WRITE_CLAIM) != 0;
+}
+
+static inline bool pipe_read_claimed(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_READ_CLAIM) != 0;
+}
+
+static inline bool pipe_write_canceled(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_WRITE_CANCELED) != 0;
+}
+
+static inline bool pipe_read_canceled(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_READ_CANCELED) != 0;
+}
+
 static inline bool pipe_full(struct k_pipe *pipe)
 {
 	return ring_buf_space_get(&pipe->buf) == 0;
@@ -165,6 +185,11 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 			break;
 		}
 
+		if (unlikely(pipe_write_claimed(pipe))) {
+			/* data written in place comes first: wait for its commit */
+			goto wait;
+		}
+
 		if (pipe_empty(pipe)) {
 			if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
 				/*
@@ -199,6 +224,7 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 			break;
 		}
 
+wait:
 		rc = wait_for(&pipe->space, pipe, &key, end, &need_resched);
 		if (rc != 0) {
 			if (rc == -EAGAIN) {
@@ -233,6 +259,11 @@ int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout
 	}
 
 	for (;;) {
+		if (unlikely(pipe_read_claimed(pipe))) {
+			/* data being read in place comes first: wait for its commit */
+			goto check_closed;
+		}
+
 		if (pipe_full(pipe)) {
 			/* One or more pending writers may exist. */
 			need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
@@ -244,6 +275,7 @@ int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout
 			break;
 		}
 
+check_closed:
 		if (unlikely(pipe_closed(pipe))) {
 			rc = buf.used ? buf.used : -EPIPE;
 			break;
@@ -270,11 +302,211 @@ exit:
 	return rc;
 }
 
+int k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+		       k_timeout_t timeout)
+{
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	bool need_resched = false;
+
+	if ((len == 0) || (ring_buf_capacity_get(&pipe->buf) == 0)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		if (!pipe_write_claimed(pipe) && !pipe_full(pipe)) {
+			rc = ring_buf_put_claim(&pipe->buf, data, MIN(len, INT_MAX));
+			pipe->flags |= PIPE_FLAG_WRITE_CLAIM;
+			break;
+		}
+
+		rc = wait_for(&pipe->space, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int k_pipe_write_commit(struct k_pipe *pipe, size_t len)
+{
+	int rc;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (!pipe_write_claimed(pipe)) {
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	if (unlikely(pipe_write_canceled(pipe))) {
+		/* the reset already gave the claimed space back */
+		rc = -ECANCELED;
+	} else if (unlikely(pipe_closed(pipe))) {
+		/* nobody will read this: give the claimed space back */
+		(void)ring_buf_put_finish(&pipe->buf, 0);
+		rc = -EPIPE;
+	} else {
+		rc = ring_buf_put_finish(&pipe->buf, len);
+		if (rc != 0) {
+			/* keep the claim, the caller may retry with a valid size */
+			goto exit;
+		}
+	}
+	pipe->flags &= ~(PIPE_FLAG_WRITE_CLAIM | PIPE_FLAG_WRITE_CANCELED);
+
+	if (pipe->waiting != 0) {
+		/* Wake up readers waiting for data and writers waiting for
+		 * the claim to be released: they all recheck the pipe state.
+		 */
+		if ((rc == 0) && (len != 0)) {
+			need_resched = z_sched_wake_all(&pipe->data, 0, NULL);
+		}
+		need_resched |= z_sched_wake_all(&pipe->space, 0, NULL);
+	}
+
+#ifdef CONFIG_POLL
+	if ((rc == 0) && (len != 0)) {
+		need_resched |= z_handle_obj_poll_events(&pipe->poll_events,
+							 K_POLL_STATE_PIPE_DATA_AVAILABLE);
+	}
+#endif /* CONFIG_POLL */
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+		      k_timeout_t timeout)
+{
+	/* An empty "direct copy" spec: writers just wake us up */
+	struct pipe_buf_spec buf = { pipe->buf.buffer, 0, 0 };
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	bool need_resched = false;
+
+	if ((len == 0) || (ring_buf_capacity_get(&pipe->buf) == 0)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		if (!pipe_read_claimed(pipe) && !pipe_empty(pipe)) {
+			rc = ring_buf_get_claim(&pipe->buf, data, MIN(len, INT_MAX));
+			pipe->flags |= PIPE_FLAG_READ_CLAIM;
+			break;
+		}
+
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		_current->base.swap_data = &buf;
+
+		rc = wait_for(&pipe->data, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int k_pipe_read_commit(struct k_pipe *pipe, size_t len)
+{
+	int rc;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (!pipe_read_claimed(pipe)) {
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	if (unlikely(pipe_read_canceled(pipe))) {
+		/* the reset already discarded the claimed data */
+		rc = -ECANCELED;
+	} else {
+		rc = ring_buf_get_finish(&pipe->buf, len);
+		if (rc != 0) {
+			/* keep the claim, the caller may retry with a valid size */
+			goto exit;
+		}
+	}
+	pipe->flags &= ~(PIPE_FLAG_READ_CLAIM | PIPE_FLAG_READ_CANCELED);
+
+	if (pipe->waiting != 0) {
+		/* Wake up writers waiting for space and readers waiting for
+		 * the claim to be released: they all recheck the pipe state.
+		 */
+		if (len != 0) {
+			need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
+		}
+		if (!pipe_empty(pipe)) {
+			need_resched |= z_sched_wake_all(&pipe->data, 0, NULL);
+		}
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
 void z_impl_k_pipe_reset(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, reset, pipe);
 	K_SPINLOCK(&pipe->lock) {
 		ring_buf_reset(&pipe->buf);
+		/* Outstanding claims point to discarded data.  They stay
+		 * in place, so that the pipe is not read or written in
+		 * their direction until the holder commits, but that
+		 * commit fails with -ECANCELED.
+		 */
+		if (pipe_write_claimed(pipe)) {
+			pipe->flags |= PIPE_FLAG_WRITE_CANCELED;
+		}
+		if (pipe_read_claimed(pipe)) {
+			pipe->flags |= PIPE_FLAG_READ_CANCELED;
+		}
 		if (likely(pipe->waiting != 0)) {
 			pipe->flags |= PIPE_FLAG_RESET;
 			z_sched_wake_all(&pipe->data, 0, NULL);
@@ -288,7 +520,8 @@ void z_impl_k_pipe_close(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, close, pipe);
 	K_SPINLOCK(&pipe->lock) {
-		pipe->flags = 0;
+		/* keep claims: data claimed for reading can still be released */
+		pipe->flags &= ~(PIPE_FLAG_OPEN | PIPE_FLAG_RESET);
 		z_sched_wake_all(&pipe->data, 0, NULL);
 		z_sched_wake_all(&pipe->space, 0, NULL);
 	}
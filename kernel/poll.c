@@ -35,10 +35,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -108,6 +109,24 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Tells whether events of @a poller should be signaled before those of
+ * @a other.  Poll sets have no priority of their own: their events queue
+ * behind those of polling threads.
+ */
+static inline bool poller_has_precedence(struct z_poller *poller,
+					 struct z_poller *other)
+{
+	if (poller->mode == MODE_SET) {
+		return false;
+	}
+
+	if (other->mode == MODE_SET) {
+		return true;
+	}
+
+	return z_sched_prio_cmp(poller_thread(poller), poller_thread(other)) > 0;
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
@@ -115,15 +134,13 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+		poller_has_precedence(pending->poller, poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (poller_has_precedence(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -437,6 +454,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	int retcode = 0;
 
 	if (poller != NULL) {
+		if (poller->mode == MODE_SET) {
+			/* the event stays attached to its set */
+			return signal_poll_set(event, state);
+		}
+
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
@@ -562,6 +584,162 @@ static inline void z_vrfy_k_poll_signal_reset(struct k_poll_signal *sig)
 
 #endif /* CONFIG_USERSPACE */
 
+/* must be called with interrupts locked */
+static bool wake_poll_set_waiter(struct k_poll_set *set)
+{
+	struct k_thread *thread = z_unpend_first_thread(&set->wait_q);
+
+	if (thread == NULL) {
+		return false;
+	}
+
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+
+	return true;
+}
+
+/* must be called with interrupts locked */
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller, struct k_poll_set, poller);
+
+	/* The signaling object already unlinked the event from its list */
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+	(void)wake_poll_set_waiter(set);
+
+	return 0;
+}
+
+/* Registers an event of a set with its object, or queues it on the ready
+ * list straight away if its condition is already met.  Returns true in the
+ * latter case.  Must be called with interrupts locked.
+ */
+static bool arm_poll_set_event(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (is_condition_met(event, &state)) {
+		event->state = state;
+		sys_dlist_append(&set->ready, &event->_node);
+		return true;
+	}
+
+	register_event(event, &set->poller);
+
+	return false;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+	z_waitq_init(&set->wait_q);
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT(event != NULL, "NULL event\n");
+
+	if (event->type == K_POLL_TYPE_IGNORE) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	event->poller = &set->poller;
+	if (arm_poll_set_event(set, event) && wake_poll_set_waiter(set)) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int ret = 0;
+
+	if (event->poller != &set->poller) {
+		ret = -EINVAL;
+	} else {
+		/* on its object's list, the ready list or the returned list */
+		if (sys_dnode_is_linked(&event->_node)) {
+			sys_dlist_remove(&event->_node);
+		}
+		event->poller = NULL;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	int count = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(events != NULL, "NULL events\n");
+
+	if (max_events <= 0) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Rearm the events returned last time, they have been processed */
+	while ((node = sys_dlist_get(&set->returned)) != NULL) {
+		(void)arm_poll_set_event(set, CONTAINER_OF(node, struct k_poll_event, _node));
+		k_spin_unlock(&lock, key);
+		key = k_spin_lock(&lock);
+	}
+
+	while (sys_dlist_is_empty(&set->ready)) {
+		int swap_rc;
+
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		swap_rc = z_pend_curr(&lock, key, &set->wait_q, timeout);
+		if (swap_rc != 0) {
+			return swap_rc;
+		}
+
+		key = k_spin_lock(&lock);
+	}
+
+	while ((count < max_events) && ((node = sys_dlist_get(&set->ready)) != NULL)) {
+		sys_dlist_append(&set->returned, node);
+		events[count++] = CONTAINER_OF(node, struct k_poll_event, _node);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
+
 static void triggered_work_handler(struct k_work *work)
 {
 	struct k_work_poll *twork =
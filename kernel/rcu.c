@@ -0,0 +1,284 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * Read-copy-update (RCU)
+ *
+ * Readers only count their nesting depth in their own thread structure,
+ * with a memory barrier on entry and exit on SMP.
+ * A grace period ends once every CPU has passed through a quiescent state,
+ * and every reader that was switched out within a read-side critical
+ * section before or during the grace period has left it.
+ *
+ * A CPU passes through a quiescent state when it switches threads, when a
+ * timer tick interrupts a thread outside of a read-side critical section,
+ * and whenever its current thread is seen outside of a read-side critical
+ * section. Interrupt handlers count as part of the thread they interrupt,
+ * the idle thread included, so their critical sections are seen as well.
+ * Readers switched out within a critical section are put on a list of
+ * blocked readers by the context switch, and take themselves off it when
+ * they leave the critical section.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/rcu.h>
+#include <zephyr/sys/barrier.h>
+#include <ksched.h>
+
+BUILD_ASSERT(CONFIG_MP_MAX_NUM_CPUS <= 32, "Too many CPUs for the RCU CPU mask");
+
+struct rcu_gp {
+	/* Grace period sequence number */
+	uint32_t seq;
+
+	/* CPUs that have yet to pass through a quiescent state */
+	uint32_t pending;
+
+	/* Quiescent state counts of the CPUs when the grace period started */
+	uint32_t qs[CONFIG_MP_MAX_NUM_CPUS];
+};
+
+static struct k_spinlock rcu_lock;
+static uint32_t rcu_gp_seq;
+static sys_dlist_t rcu_blocked = SYS_DLIST_STATIC_INIT(&rcu_blocked);
+
+/* Callbacks waiting for the next grace period, and for the current one */
+static sys_slist_t rcu_pending = SYS_SLIST_STATIC_INIT(&rcu_pending);
+static sys_slist_t rcu_batch = SYS_SLIST_STATIC_INIT(&rcu_batch);
+static struct rcu_gp rcu_batch_gp;
+
+static void rcu_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(rcu_work, rcu_work_handler);
+
+static inline void rcu_note_qs(struct _cpu *cpu)
+{
+	/* Accesses of the readers that ran on this CPU come first */
+	barrier_dmem_fence_full();
+	cpu->rcu_qs++;
+}
+
+/* gp_done() reads the nesting depth of the threads running on other CPUs.
+ * On SMP, a full barrier orders the store of the depth against the loads
+ * of the protected data, which even total store order CPUs would otherwise
+ * reorder, and the loads against the store leaving the critical section.
+ * This puts a memory barrier on both ends of every critical section.
+ */
+static inline void rcu_reader_fence(void)
+{
+	if (IS_ENABLED(CONFIG_SMP)) {
+		barrier_dmem_fence_full();
+	} else {
+		compiler_barrier();
+	}
+}
+
+void k_rcu_read_lock(void)
+{
+	struct k_thread *thread = _current;
+
+	thread->rcu.nesting++;
+	rcu_reader_fence();
+}
+
+void k_rcu_read_unlock(void)
+{
+	struct k_thread *thread = _current;
+
+	__ASSERT(thread->rcu.nesting != 0U, "not in an RCU read-side critical section");
+
+	rcu_reader_fence();
+	thread->rcu.nesting--;
+	compiler_barrier();
+
+	/* Only readers switched out within the critical section get here */
+	if ((thread->rcu.nesting == 0U) && thread->rcu.blocked) {
+		K_SPINLOCK(&rcu_lock) {
+			sys_dlist_remove(&thread->rcu.node);
+			thread->rcu.blocked = false;
+		}
+	}
+}
+
+void z_rcu_switched_out(struct k_thread *thread)
+{
+	struct _cpu *cpu = _current_cpu;
+
+	if ((thread != NULL) && (thread->rcu.nesting != 0U) && !thread->rcu.blocked) {
+		K_SPINLOCK(&rcu_lock) {
+			thread->rcu.blocked = true;
+			thread->rcu.cpu = cpu->id;
+			thread->rcu.gp_seq = rcu_gp_seq;
+			thread->rcu.qs = cpu->rcu_qs;
+			sys_dlist_append(&rcu_blocked, &thread->rcu.node);
+		}
+	}
+
+	rcu_note_qs(cpu);
+}
+
+void z_rcu_tick(void)
+{
+	if (_current->rcu.nesting == 0U) {
+		rcu_note_qs(_current_cpu);
+	}
+}
+
+void z_rcu_thread_abort(struct k_thread *thread)
+{
+	K_SPINLOCK(&rcu_lock) {
+		if (thread->rcu.blocked) {
+			sys_dlist_remove(&thread->rcu.node);
+			thread->rcu.blocked = false;
+		}
+		thread->rcu.nesting = 0U;
+	}
+}
+
+static void gp_start(struct rcu_gp *gp)
+{
+	K_SPINLOCK(&rcu_lock) {
+		unsigned int self = _current_cpu->id;
+
+		gp->seq = ++rcu_gp_seq;
+		gp->pending = 0U;
+
+		for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+			gp->qs[i] = _kernel.cpus[i].rcu_qs;
+
+			/* The caller is not a reader, so its CPU is quiescent */
+			if (i != self) {
+				gp->pending |= BIT(i);
+			}
+		}
+	}
+
+	/* Unpublishing the data comes before the grace period */
+	barrier_dmem_fence_full();
+}
+
+/* A reader blocked before the grace period started, or that had been
+ * running since before it started, may hold references to old data.
+ */
+static bool blocks_gp(const struct k_thread *thread, const struct rcu_gp *gp)
+{
+	return ((int32_t)(thread->rcu.gp_seq - gp->seq) < 0) ||
+	       (thread->rcu.qs == gp->qs[thread->rcu.cpu]);
+}
+
+static bool gp_done(struct rcu_gp *gp)
+{
+	struct k_thread *thread;
+	bool done = true;
+
+	K_SPINLOCK(&rcu_lock) {
+		for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+			struct _cpu *cpu = &_kernel.cpus[i];
+
+			if ((gp->pending & BIT(i)) == 0U) {
+				continue;
+			}
+
+			/* A reader that started before the grace period is
+			 * either still running on the CPU, so that its thread
+			 * is within a critical section, or was switched out,
+			 * which is a quiescent state.
+			 */
+			if ((cpu->rcu_qs != gp->qs[i]) || (cpu->current == NULL) ||
+			    (cpu->current->rcu.nesting == 0U)) {
+				gp->pending &= ~BIT(i);
+			}
+		}
+
+		if (gp->pending != 0U) {
+			done = false;
+			K_SPINLOCK_BREAK;
+		}
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&rcu_blocked, thread, rcu.node) {
+			if (blocks_gp(thread, gp)) {
+				done = false;
+				break;
+			}
+		}
+	}
+
+	if (done) {
+		/* Reclaiming the data comes after the grace period */
+		barrier_dmem_fence_full();
+	}
+
+	return done;
+}
+
+void k_rcu_synchronize(void)
+{
+	struct rcu_gp gp;
+
+	__ASSERT(!arch_is_in_isr(), "RCU synchronize called from ISR");
+	__ASSERT(_current->rcu.nesting == 0U,
+		 "RCU synchronize called within a read-side critical section");
+
+	gp_start(&gp);
+
+	while (!gp_done(&gp)) {
+		/* Let blocked readers run, and other CPUs switch threads */
+		k_sleep(K_TICKS(1));
+	}
+}
+
+void k_rcu_call(struct k_rcu_head *head, k_rcu_callback_t func)
+{
+	head->func = func;
+
+	K_SPINLOCK(&rcu_lock) {
+		sys_slist_append(&rcu_pending, &head->node);
+	}
+
+	(void)k_work_schedule(&rcu_work, K_NO_WAIT);
+}
+
+/* Only ever runs on the system work queue, which owns rcu_batch */
+static void rcu_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct k_rcu_head *head;
+	sys_snode_t *node;
+	bool again = false;
+
+	if (sys_slist_is_empty(&rcu_batch)) {
+		K_SPINLOCK(&rcu_lock) {
+			rcu_batch = rcu_pending;
+			sys_slist_init(&rcu_pending);
+		}
+
+		if (sys_slist_is_empty(&rcu_batch)) {
+			return;
+		}
+
+		gp_start(&rcu_batch_gp);
+	}
+
+	if (!gp_done(&rcu_batch_gp)) {
+		(void)k_work_reschedule(dwork, K_TICKS(1));
+		return;
+	}
+
+	while ((node = sys_slist_get(&rcu_batch)) != NULL) {
+		head = CONTAINER_OF(node, struct k_rcu_head, node);
+		head->func(head);
+	}
+
+	/* Callbacks queued in the meantime need a grace period of their own */
+	K_SPINLOCK(&rcu_lock) {
+		again = !sys_slist_is_empty(&rcu_pending);
+	}
+
+	if (again) {
+		(void)k_work_reschedule(dwork, K_NO_WAIT);
+	}
+}
@@ -0,0 +1,374 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief reader-writer lock kernel services
+ *
+ * A reader-writer lock is held either by any number of readers, or by a
+ * single writer. Writers are preferred: once a thread waits to write, new
+ * readers wait too, so that a steady flow of readers cannot starve writers.
+ *
+ * The lock is handed over directly on release: the last reader gives it to
+ * the first waiting writer, and a writer gives it to the next waiting
+ * writer or, if there is none, to all waiting readers at once.
+ *
+ * Readers are only counted, not tracked, so priority inheritance, when
+ * enabled, only boosts the writer holding the lock. It follows the same
+ * rules as for mutexes.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <errno.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/tracing/tracing.h>
+#include <zephyr/sys/check.h>
+
+int z_impl_k_rwlock_init(struct k_rwlock *rwlock, uint32_t options)
+{
+	CHECKIF((options & ~K_RWLOCK_PRIO_INHERIT) != 0U) {
+		return -EINVAL;
+	}
+
+	rwlock->lock = (struct k_spinlock) {};
+	z_waitq_init(&rwlock->rd_wait_q);
+	z_waitq_init(&rwlock->wr_wait_q);
+	rwlock->writer = NULL;
+	rwlock->readers = 0U;
+	rwlock->writer_orig_prio = K_LOWEST_APPLICATION_THREAD_PRIO;
+	rwlock->options = options;
+
+	k_object_init(rwlock);
+
+	SYS_PORT_TRACING_OBJ_INIT(k_rwlock, rwlock);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_init(struct k_rwlock *rwlock, uint32_t options)
+{
+	K_OOPS(K_SYSCALL_OBJ_INIT(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_init(rwlock, options);
+}
+#include <zephyr/syscalls/k_rwlock_init_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Priority the writer should run at, given the threads waiting for it */
+static int writer_prio(struct k_rwlock *rwlock)
+{
+	struct k_thread *rd_waiter = z_waitq_head(&rwlock->rd_wait_q);
+	struct k_thread *wr_waiter = z_waitq_head(&rwlock->wr_wait_q);
+	int prio = rwlock->writer_orig_prio;
+
+	if ((rwlock->options & K_RWLOCK_PRIO_INHERIT) == 0U) {
+		return prio;
+	}
+
+	if ((rd_waiter != NULL) && z_is_prio_higher(rd_waiter->base.prio, prio)) {
+		prio = z_get_new_prio_with_ceiling(rd_waiter->base.prio);
+	}
+
+	if ((wr_waiter != NULL) && z_is_prio_higher(wr_waiter->base.prio, prio)) {
+		prio = z_get_new_prio_with_ceiling(wr_waiter->base.prio);
+	}
+
+	return prio;
+}
+
+static bool adjust_writer_prio(struct k_rwlock *rwlock, int new_prio)
+{
+	if ((rwlock->options & K_RWLOCK_PRIO_INHERIT) == 0U) {
+		return false;
+	}
+
+	if ((rwlock->writer != NULL) && (rwlock->writer->base.prio != new_prio)) {
+		return z_thread_prio_set(rwlock->writer, new_prio);
+	}
+
+	return false;
+}
+
+/* Raise the writer priority to that of a thread about to wait for it */
+static bool boost_writer(struct k_rwlock *rwlock)
+{
+	int new_prio;
+
+	if (rwlock->writer == NULL) {
+		return false;
+	}
+
+	new_prio = z_get_new_prio_with_ceiling(_current->base.prio);
+	if (z_is_prio_higher(new_prio, rwlock->writer->base.prio)) {
+		return adjust_writer_prio(rwlock, new_prio);
+	}
+
+	return false;
+}
+
+static void give_to_writer(struct k_rwlock *rwlock, struct k_thread *thread)
+{
+	rwlock->writer = thread;
+	rwlock->writer_orig_prio = thread->base.prio;
+
+	/* Waiting readers may have a higher priority than the new writer */
+	(void)adjust_writer_prio(rwlock, writer_prio(rwlock));
+
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+}
+
+/* Hand the lock to all waiting readers. Returns true if any was woken. */
+static bool give_to_readers(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+	bool woken = false;
+
+	while ((thread = z_unpend_first_thread(&rwlock->rd_wait_q)) != NULL) {
+		rwlock->readers++;
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
+/*
+ * Undo what a thread that timed out waiting did: lower the writer priority
+ * it may have raised, and let readers in if it was the last writer holding
+ * them off.
+ */
+static void lock_timed_out(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key = k_spin_lock(&rwlock->lock);
+	bool resched;
+
+	resched = adjust_writer_prio(rwlock, writer_prio(rwlock));
+
+	if ((rwlock->writer == NULL) && (z_waitq_head(&rwlock->wr_wait_q) == NULL)) {
+		resched = give_to_readers(rwlock) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+}
+
+int z_impl_k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "reader-writer locks cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_rwlock, read_lock, rwlock, timeout);
+
+	key = k_spin_lock(&rwlock->lock);
+
+	if (likely((rwlock->writer == NULL) &&
+		   (z_waitq_head(&rwlock->wr_wait_q) == NULL))) {
+		rwlock->readers++;
+		k_spin_unlock(&rwlock->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_lock, rwlock, timeout, 0);
+
+		return 0;
+	}
+
+	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		k_spin_unlock(&rwlock->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_lock, rwlock, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_rwlock, read_lock, rwlock, timeout);
+
+	(void)boost_writer(rwlock);
+
+	ret = z_pend_curr(&rwlock->lock, key, &rwlock->rd_wait_q, timeout);
+	if (ret != 0) {
+		lock_timed_out(rwlock);
+		ret = -EAGAIN;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_lock, rwlock, timeout, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_lock(struct k_rwlock *rwlock,
+					    k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_lock(rwlock, timeout);
+}
+#include <zephyr/syscalls/k_rwlock_read_lock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "reader-writer locks cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_rwlock, write_lock, rwlock, timeout);
+
+	key = k_spin_lock(&rwlock->lock);
+
+	if (likely((rwlock->writer == NULL) && (rwlock->readers == 0U))) {
+		rwlock->writer = _current;
+		rwlock->writer_orig_prio = _current->base.prio;
+		k_spin_unlock(&rwlock->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, 0);
+
+		return 0;
+	}
+
+	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		k_spin_unlock(&rwlock->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
+	if (rwlock->writer == _current) {
+		k_spin_unlock(&rwlock->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, -EDEADLK);
+
+		return -EDEADLK;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_rwlock, write_lock, rwlock, timeout);
+
+	(void)boost_writer(rwlock);
+
+	ret = z_pend_curr(&rwlock->lock, key, &rwlock->wr_wait_q, timeout);
+	if (ret != 0) {
+		lock_timed_out(rwlock);
+		ret = -EAGAIN;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_lock(struct k_rwlock *rwlock,
+					     k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_lock(rwlock, timeout);
+}
+#include <zephyr/syscalls/k_rwlock_write_lock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "reader-writer locks cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_rwlock, read_unlock, rwlock);
+
+	key = k_spin_lock(&rwlock->lock);
+
+	CHECKIF(rwlock->readers == 0U) {
+		k_spin_unlock(&rwlock->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_unlock, rwlock, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	rwlock->readers--;
+
+	thread = (rwlock->readers == 0U) ? z_unpend_first_thread(&rwlock->wr_wait_q) : NULL;
+	if (thread != NULL) {
+		give_to_writer(rwlock, thread);
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_unlock, rwlock, 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_unlock(rwlock);
+}
+#include <zephyr/syscalls/k_rwlock_read_unlock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+	bool resched;
+
+	__ASSERT(!arch_is_in_isr(), "reader-writer locks cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_rwlock, write_unlock, rwlock);
+
+	key = k_spin_lock(&rwlock->lock);
+
+	CHECKIF(rwlock->writer != _current) {
+		k_spin_unlock(&rwlock->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_unlock, rwlock, -EPERM);
+
+		return -EPERM;
+	}
+
+	resched = adjust_writer_prio(rwlock, rwlock->writer_orig_prio);
+	rwlock->writer = NULL;
+
+	thread = z_unpend_first_thread(&rwlock->wr_wait_q);
+	if (thread != NULL) {
+		give_to_writer(rwlock, thread);
+		resched = true;
+	} else {
+		resched = give_to_readers(rwlock) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_unlock, rwlock, 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_unlock(rwlock);
+}
+#include <zephyr/syscalls/k_rwlock_write_unlock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
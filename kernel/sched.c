@@ -59,6 +59,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_WORK_STEALING)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -67,18 +69,72 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_WORK_STEALING)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_WORK_STEALING */
+}
+
+#ifdef CONFIG_SCHED_WORK_STEALING
+/* Pick a queue for a thread that is about to become runnable: the
+ * queue of the CPU it last ran on or, for a thread that has never
+ * been queued, the queue of the CPU making it runnable.  If its CPU
+ * mask does not allow that CPU, the first CPU it may run on is used.
+ */
+static ALWAYS_INLINE void runq_place(struct k_thread *thread)
+{
+	int cpu = (thread->base.runq_cpu == RUNQ_CPU_NONE) ?
+		  _current_cpu->id : thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	int m = thread->base.cpu_mask;
+
+	if ((m & BIT(cpu)) == 0) {
+		/* Same edge case as thread_runq() in PIN_ONLY mode:
+		 * a thread with all CPUs masked off is legal.
+		 */
+		cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	thread->base.runq_cpu = cpu;
+}
+
+/* Returns the best thread this CPU may run.  The best thread of
+ * the local queue is compared against the heads of every other
+ * CPU's queue, and a strictly higher priority thread found there
+ * is stolen, so that priority ordering holds across the whole
+ * system.  Ties stay local.
+ */
+static ALWAYS_INLINE struct k_thread *runq_steal_best(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int cpu = _current_cpu->id;
+	struct k_thread *best = _priq_run_best(&_current_cpu->ready_q.runq);
+
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		unsigned int victim_cpu = (cpu + i) % num_cpus;
+		struct k_thread *thread = _priq_run_best(&_kernel.cpus[victim_cpu].ready_q.runq);
+
+		if ((thread != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
 }
+#endif /* CONFIG_SCHED_WORK_STEALING */
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 	__ASSERT_NO_MSG(!is_thread_dummy(thread));
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	runq_place(thread);
+#endif /* CONFIG_SCHED_WORK_STEALING */
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -97,7 +153,11 @@ static ALWAYS_INLINE void runq_yield(void)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_WORK_STEALING
+	return runq_steal_best();
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_WORK_STEALING */
 }
 
 /* _current is never in the run queue until context switch on
@@ -338,6 +398,7 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_usage_ready(thread);
 		queue_thread(thread);
 		update_cache(0);
 
@@ -890,6 +951,7 @@ void *z_get_next_switch_handle(void *interrupted)
 		new_thread = next_up();
 
 		z_sched_usage_switch(new_thread);
+		z_ipi_switch_account(old_thread != new_thread);
 
 		if (old_thread != new_thread) {
 			uint8_t  cpu_id;
@@ -968,13 +1030,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_WORK_STEALING)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_WORK_STEALING */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1313,6 +1375,9 @@ static ALWAYS_INLINE void halt_thread(struct k_thread *thread, uint8_t new_state
 		SYS_PORT_TRACING_FUNC(k_thread, sched_abort, thread);
 
 		z_thread_monitor_exit(thread);
+#ifdef CONFIG_RCU
+		z_rcu_thread_abort(thread);
+#endif /* CONFIG_RCU */
 #ifdef CONFIG_THREAD_ABORT_HOOK
 		thread_abort_hook(thread);
 #endif /* CONFIG_THREAD_ABORT_HOOK */
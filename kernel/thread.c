@@ -656,6 +656,10 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 #ifdef CONFIG_EVENTS
 	new_thread->no_wake_on_timeout = false;
 #endif /* CONFIG_EVENTS */
+#ifdef CONFIG_RCU
+	new_thread->rcu.nesting = 0U;
+	new_thread->rcu.blocked = false;
+#endif /* CONFIG_RCU */
 #ifdef CONFIG_THREAD_MONITOR
 	new_thread->entry.pEntry = entry;
 	new_thread->entry.parameter1 = p1;
@@ -892,6 +896,10 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->is_idle = 0;
 #endif /* CONFIG_SMP */
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	thread_base->runq_cpu = RUNQ_CPU_NONE;
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	thread_base->slice_ticks = 0;
 	thread_base->slice_expired = NULL;
@@ -1134,6 +1142,10 @@ void z_thread_mark_switched_in(void)
 
 void z_thread_mark_switched_out(void)
 {
+#ifdef CONFIG_RCU
+	z_rcu_switched_out(_current);
+#endif /* CONFIG_RCU */
+
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
 	z_sched_usage_stop();
 #endif /*CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
@@ -1195,6 +1207,14 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+		for (int j = 0; j < CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS; j++) {
+			stats->wakeup_latency.buckets[j] += tmp_stats.wakeup_latency.buckets[j];
+			stats->run_length.buckets[j]     += tmp_stats.run_length.buckets[j];
+		}
+		stats->wakeup_latency.sum += tmp_stats.wakeup_latency.sum;
+		stats->run_length.sum     += tmp_stats.run_length.sum;
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
@@ -1360,5 +1380,10 @@ void z_dummy_thread_init(struct k_thread *dummy_thread)
 	dummy_thread->base.slice_ticks = 0;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_RCU
+	dummy_thread->rcu.nesting = 0U;
+	dummy_thread->rcu.blocked = false;
+#endif /* CONFIG_RCU */
+
 	z_current_thread_set(dummy_thread);
 }
@@ -7,23 +7,96 @@
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
 #include <ksched.h>
+#include <ipi.h>
 #include <timeout_q.h>
+#include <zephyr/init.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <string.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+/*
+ * Pending timeouts are kept in a single timeout queue or, with
+ * CONFIG_TIMEOUT_QUEUE_PER_CPU, in one queue per CPU. A timeout is added to
+ * the queue of the CPU arming it. Each CPU then programs its own system
+ * timer comparator for the first timeout of its queue, and expires the
+ * timeouts of its queue when it announces ticks, so that CPUs only take the
+ * lock of another queue to abort, query or migrate a timeout armed there.
+ * A CPU changing the first timeout of another CPU's queue has that CPU
+ * reprogram its timer with an IPI.
+ */
+struct timeout_q {
+	struct k_spinlock lock;
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct rbtree tree;
+
+	/* Source of order_key values, so that timeouts expiring on the same
+	 * tick fire in the order they were added, just like with the delta
+	 * list.
+	 */
+	uint32_t next_order_key;
+#else
+	sys_dlist_t list;
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Set while the owning CPU expires the timeouts of the queue */
+	bool announcing;
+
+	/* Tick of the timeout being expired while announcing */
+	uint64_t announce_tick;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+#ifdef CONFIG_OBJ_CORE_TIMEOUT_QUEUE
+	struct k_obj_core obj_core;
+#endif /* CONFIG_OBJ_CORE_TIMEOUT_QUEUE */
+#ifdef CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE
+	struct k_timeout_q_stats stats;
+#endif /* CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE */
+};
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+#define NUM_TIMEOUT_QS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define NUM_TIMEOUT_QS 1
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b);
+
+static struct timeout_q timeout_qs[NUM_TIMEOUT_QS] = {
+	[0 ... (NUM_TIMEOUT_QS - 1)] = {
+		.tree = {
+			.lessthan_fn = timeout_lessthan,
+		},
+	},
+};
+#else
+static struct timeout_q timeout_qs[NUM_TIMEOUT_QS] = {
+	{
+		.list = SYS_DLIST_STATIC_INIT(&timeout_qs[0].list),
+	},
+};
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 
 /*
- * The timeout code shall take no locks other than its own (timeout_lock), nor
- * shall it call any other subsystem while holding this lock.
+ * The timeout code shall take no locks other than its own (the timeout queue
+ * locks and tick_lock), nor shall it call any other subsystem while holding
+ * these locks.
+ */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Protects curr_tick, which every CPU advances by the ticks it announces.
+ * Nests inside the timeout queue locks.
  */
-static struct k_spinlock timeout_lock;
+static struct k_spinlock tick_lock;
 
+/* CPUs whose timer is to be reprogrammed from their IPI handler */
+static atomic_t reprogram_cpus;
+#else
 /* Ticks left to process in the currently-executing sys_clock_announce() */
 static int announce_remaining;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 unsigned int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
@@ -37,35 +110,229 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+static k_spinlock_key_t timeout_q_lock(struct timeout_q *q)
+{
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE
+	if (k_spin_trylock(&q->lock, &key) != 0) {
+		key = k_spin_lock(&q->lock);
+		q->stats.lock_contended++;
+	}
+	q->stats.lock_acquired++;
+#else
+	key = k_spin_lock(&q->lock);
+#endif /* CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE */
+
+	return key;
+}
+
+static void timeout_q_unlock(struct timeout_q *q, k_spinlock_key_t key)
+{
+	k_spin_unlock(&q->lock, key);
+}
+
+/* Queue of the current CPU, which timeouts are added to and expired from */
+static struct timeout_q *local_timeout_q(void)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Being migrated right after reading the CPU id is harmless, the
+	 * timeout then just ends up on another CPU's queue.
+	 */
+	return &timeout_qs[arch_curr_cpu()->id];
+#else
+	return &timeout_qs[0];
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+/* Queue that the timeout is, or was last, queued on */
+static struct timeout_q *timeout_q_of(const struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	return &timeout_qs[to->cpu];
+#else
+	ARG_UNUSED(to);
+
+	return &timeout_qs[0];
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+static struct timeout_q *lock_timeout_q_of(const struct _timeout *to,
+					   k_spinlock_key_t *key)
+{
+	struct timeout_q *q = timeout_q_of(to);
+
+	*key = timeout_q_lock(q);
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* The timeout may have been added again on another CPU while we
+	 * waited for the lock
+	 */
+	while (q != timeout_q_of(to)) {
+		timeout_q_unlock(q, *key);
+		q = timeout_q_of(to);
+		*key = timeout_q_lock(q);
+	}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+	return q;
+}
+
+/* q must be locked */
+static bool is_announcing(struct timeout_q *q)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	return q->announcing;
+#else
+	ARG_UNUSED(q);
+
+	return announce_remaining != 0;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+/* Has the CPU owning a queue reprogram its timer for the first timeout of
+ * the queue. Must be called with the queue unlocked.
+ */
+static void reprogram_remote(struct timeout_q *q)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	unsigned int cpu = q - timeout_qs;
+
+	atomic_set_bit(&reprogram_cpus, cpu);
+	flag_ipi(BIT(cpu));
+	signal_pending_ipi();
+#else
+	ARG_UNUSED(q);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	struct _timeout *ta = CONTAINER_OF(a, struct _timeout, node);
+	struct _timeout *tb = CONTAINER_OF(b, struct _timeout, node);
+
+	if (ta->tick != tb->tick) {
+		return ta->tick < tb->tick;
+	}
+
+	return (int32_t)(ta->order_key - tb->order_key) < 0;
+}
+
+static struct _timeout *first(struct timeout_q *q)
+{
+	struct rbnode *n = rb_get_min(&q->tree);
+
+	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* Ticks between base and the expiry of the first timeout of a queue */
+static k_ticks_t first_dticks(const struct _timeout *t, uint64_t base)
+{
+	return (k_ticks_t)(t->tick - base);
+}
+
+/* Queues a timeout expiring to->dticks ticks after base */
+static void insert_timeout(struct timeout_q *q, struct _timeout *to, uint64_t base)
+{
+	to->tick = base + to->dticks;
+	to->order_key = q->next_order_key++;
+	rb_insert(&q->tree, &to->node);
+}
+
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
+{
+	rb_remove(&q->tree, &t->node);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_q *q, const struct _timeout *timeout,
+			     uint64_t base)
+{
+	ARG_UNUSED(q);
+
+	return (k_ticks_t)(timeout->tick - base);
+}
+#else
+static struct _timeout *first(struct timeout_q *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
 
 	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
-static struct _timeout *next(struct _timeout *t)
+static struct _timeout *next(struct timeout_q *q, struct _timeout *t)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
 
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+/* Ticks between base and the expiry of the first timeout of a queue */
+static k_ticks_t first_dticks(const struct _timeout *t, uint64_t base)
+{
+	ARG_UNUSED(base);
+
+	return t->dticks;
+}
+
+/* Queues a timeout expiring to->dticks ticks after base */
+static void insert_timeout(struct timeout_q *q, struct _timeout *to, uint64_t base)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	struct _timeout *t;
+
+	ARG_UNUSED(base);
+
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+}
+
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
+{
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_q *q, const struct _timeout *timeout,
+			     uint64_t base)
+{
+	k_ticks_t ticks = 0;
+
+	ARG_UNUSED(base);
+
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
+/* Returns the tick that the timeouts of a locked queue are relative to,
+ * and the ticks elapsed since then in @p ticks_elapsed.
+ */
+static uint64_t queue_tick(struct timeout_q *q, int32_t *ticks_elapsed)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
 	 * scheduled relatively to the currently firing timeout's original tick
-	 * value (=curr_tick) rather than relative to the current
-	 * sys_clock_elapsed().
+	 * value rather than relative to the current sys_clock_elapsed().
 	 *
 	 * This means that timeouts being scheduled from within timeout callbacks
 	 * will be scheduled at well-defined offsets from the currently firing
@@ -74,31 +341,64 @@ static int32_t elapsed(void)
 	 * As a side effect, the same will happen if an ISR with higher priority
 	 * preempts a timeout callback and schedules a timeout.
 	 *
-	 * The distinction is implemented by looking at announce_remaining which
-	 * will be non-zero while sys_clock_announce() is executing and zero
-	 * otherwise.
+	 * The distinction is implemented by looking at announce_remaining, or
+	 * at the announcing flag of the queue with per-CPU queues.
 	 */
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	uint64_t tick;
+
+	if (q->announcing) {
+		*ticks_elapsed = 0;
+		return q->announce_tick;
+	}
+
+	/* Read both at once, another CPU may be announcing ticks */
+	K_SPINLOCK(&tick_lock) {
+		tick = curr_tick;
+		*ticks_elapsed = sys_clock_elapsed();
+	}
+
+	return tick;
+#else
+	ARG_UNUSED(q);
+
+	*ticks_elapsed = (announce_remaining == 0) ? sys_clock_elapsed() : 0U;
+
+	return curr_tick;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 }
 
-static int32_t next_timeout(int32_t ticks_elapsed)
+static int32_t timeout_to_wait(const struct _timeout *to, uint64_t base,
+			       int32_t ticks_elapsed)
 {
-	struct _timeout *to = first();
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(first_dticks(to, base) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = SYS_CLOCK_MAX_WAIT;
 	} else {
-		ret = max(0, to->dticks - ticks_elapsed);
+		ret = max(0, first_dticks(to, base) - ticks_elapsed);
 	}
 
 	return ret;
 }
 
+/* must be locked */
+static int32_t next_timeout(struct timeout_q *q)
+{
+	int32_t ticks_elapsed;
+	uint64_t base = queue_tick(q, &ticks_elapsed);
+
+	return timeout_to_wait(first(q), base, ticks_elapsed);
+}
+
 k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
 {
+	struct timeout_q *q;
+	k_spinlock_key_t key;
+	int32_t ticks_elapsed;
 	k_ticks_t ticks = 0;
+	uint64_t base;
 
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		return 0;
@@ -108,128 +408,277 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	__ASSERT_NO_MSG(sys_cache_is_mem_coherent(to));
 #endif /* CONFIG_KERNEL_COHERENCE */
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
-		int32_t ticks_elapsed;
-		bool has_elapsed = false;
+	q = local_timeout_q();
+	key = timeout_q_lock(q);
 
-		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
-			ticks_elapsed = elapsed();
-			has_elapsed = true;
-			to->dticks = timeout.ticks + 1 + ticks_elapsed;
-			ticks = curr_tick + to->dticks;
-		} else {
-			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+	base = queue_tick(q, &ticks_elapsed);
 
-			to->dticks = max(1, dticks);
-			ticks = timeout.ticks;
-		}
+	if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
+		to->dticks = timeout.ticks + 1 + ticks_elapsed;
+		ticks = base + to->dticks;
+	} else {
+		k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - base;
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+		to->dticks = max(1, dticks);
+		ticks = timeout.ticks;
+	}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	to->cpu = q - timeout_qs;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+	insert_timeout(q, to, base);
+#ifdef CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE
+	q->stats.added++;
+#endif /* CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE */
 
-		if (to == first() && announce_remaining == 0) {
-			if (!has_elapsed) {
-				/* In case of absolute timeout that is first to expire
-				 * elapsed need to be read from the system clock.
-				 */
-				ticks_elapsed = elapsed();
-			}
-			sys_clock_set_timeout(next_timeout(ticks_elapsed), false);
-		}
+	if (to == first(q) && !is_announcing(q)) {
+		sys_clock_set_timeout(timeout_to_wait(to, base, ticks_elapsed), false);
 	}
 
+	timeout_q_unlock(q, key);
+
 	return ticks;
 }
 
 int z_abort_timeout(struct _timeout *to)
 {
+	struct timeout_q *q;
+	k_spinlock_key_t key;
+	bool remote = false;
 	int ret = -EINVAL;
 
-	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
+	q = lock_timeout_q_of(to, &key);
 
-			remove_timeout(to);
-			to->dticks = TIMEOUT_DTICKS_ABORTED;
-			ret = 0;
-			if (is_first) {
-				sys_clock_set_timeout(next_timeout(elapsed()), false);
+	if (!z_is_inactive_timeout(to)) {
+		bool is_first = (to == first(q));
+
+		remove_timeout(q, to);
+		to->dticks = TIMEOUT_DTICKS_ABORTED;
+		ret = 0;
+
+		if (is_first) {
+			if (q == local_timeout_q()) {
+				sys_clock_set_timeout(next_timeout(q), false);
+			} else {
+				remote = true;
 			}
 		}
 	}
 
+	timeout_q_unlock(q, key);
+
+	if (remote) {
+		reprogram_remote(q);
+	}
+
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Reprograms the timer for a new first timeout of a locked queue, or
+ * returns true if the queue belongs to another CPU.
+ */
+static bool reprogram_first(struct timeout_q *q)
 {
-	k_ticks_t ticks = 0;
+	if (q != local_timeout_q()) {
+		return true;
+	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
+	if (!q->announcing) {
+		sys_clock_set_timeout(next_timeout(q), false);
+	}
+
+	return false;
+}
+
+void z_migrate_timeout(struct _timeout *to, int cpu)
+{
+	struct timeout_q *dst = &timeout_qs[cpu];
+	struct timeout_q *src;
+	struct timeout_q *lo;
+	struct timeout_q *hi;
+	k_spinlock_key_t lo_key;
+	k_spinlock_key_t hi_key;
+	bool src_remote = false;
+	bool dst_remote = false;
+
+	/* Lock both queues in index order, the timeout may be added again
+	 * on another CPU until its queue is locked.
+	 */
+	while (true) {
+		src = timeout_q_of(to);
+		if (src == dst) {
+			return;
+		}
+
+		lo = MIN(src, dst);
+		hi = MAX(src, dst);
+		lo_key = timeout_q_lock(lo);
+		hi_key = timeout_q_lock(hi);
+
+		if (src == timeout_q_of(to)) {
 			break;
 		}
+
+		timeout_q_unlock(hi, hi_key);
+		timeout_q_unlock(lo, lo_key);
 	}
 
-	return ticks;
+	if (!z_is_inactive_timeout(to)) {
+		bool src_first = (to == first(src));
+
+		remove_timeout(src, to);
+		to->cpu = cpu;
+		/* Absolute tick is kept, only the tie-break is from dst */
+		to->order_key = dst->next_order_key++;
+		rb_insert(&dst->tree, &to->node);
+
+		src_remote = src_first && reprogram_first(src);
+		dst_remote = (to == first(dst)) && reprogram_first(dst);
+	}
+
+	timeout_q_unlock(hi, hi_key);
+	timeout_q_unlock(lo, lo_key);
+
+	if (src_remote) {
+		reprogram_remote(src);
+	}
+
+	if (dst_remote) {
+		reprogram_remote(dst);
+	}
+}
+
+void z_timeout_ipi(void)
+{
+	struct timeout_q *q = local_timeout_q();
+	k_spinlock_key_t key;
+
+	if (!atomic_test_and_clear_bit(&reprogram_cpus, q - timeout_qs)) {
+		return;
+	}
+
+	key = timeout_q_lock(q);
+	(void)reprogram_first(q);
+	timeout_q_unlock(q, key);
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
+	struct timeout_q *q;
+	k_spinlock_key_t key;
+	int32_t ticks_elapsed;
 	k_ticks_t ticks = 0;
+	uint64_t base;
 
-	K_SPINLOCK(&timeout_lock) {
-		if (!z_is_inactive_timeout(timeout)) {
-			ticks = timeout_rem(timeout) - elapsed();
-		}
+	q = lock_timeout_q_of(timeout, &key);
+
+	if (!z_is_inactive_timeout(timeout)) {
+		base = queue_tick(q, &ticks_elapsed);
+		ticks = timeout_rem(q, timeout, base) - ticks_elapsed;
 	}
 
+	timeout_q_unlock(q, key);
+
 	return ticks;
 }
 
 k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 {
+	struct timeout_q *q;
+	k_spinlock_key_t key;
+	int32_t ticks_elapsed;
 	k_ticks_t ticks = 0;
+	uint64_t base;
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = curr_tick;
-		if (!z_is_inactive_timeout(timeout)) {
-			ticks += timeout_rem(timeout);
-		}
+	q = lock_timeout_q_of(timeout, &key);
+
+	base = queue_tick(q, &ticks_elapsed);
+	ticks = base;
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks += timeout_rem(q, timeout, base);
 	}
 
+	timeout_q_unlock(q, key);
+
 	return ticks;
 }
 
 int32_t z_get_next_timeout_expiry(void)
 {
-	int32_t ret = (int32_t) K_TICKS_FOREVER;
+	struct timeout_q *q = local_timeout_q();
+	k_spinlock_key_t key;
+	int32_t ret;
+
+	key = timeout_q_lock(q);
+	ret = next_timeout(q);
+	timeout_q_unlock(q, key);
 
-	K_SPINLOCK(&timeout_lock) {
-		ret = next_timeout(elapsed());
-	}
 	return ret;
 }
 
-void sys_clock_announce(int32_t ticks)
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Every CPU announces the ticks of its own timer, which are added to the
+ * clock right away, and then only expires the timeouts of its own queue.
+ */
+static void announce_local(struct timeout_q *q, int32_t ticks)
+{
+	k_spinlock_key_t key;
+	struct _timeout *t;
+	uint64_t now;
+
+	key = timeout_q_lock(q);
+
+	K_SPINLOCK(&tick_lock) {
+		curr_tick += ticks;
+		now = curr_tick;
+	}
+
+	/* We release the lock around the callbacks below, so an ISR may
+	 * announce ticks while the loop runs. The loop then expires the
+	 * timeouts these ticks are due for.
+	 */
+	if (q->announcing) {
+		timeout_q_unlock(q, key);
+		return;
+	}
+
+	q->announcing = true;
+
+	for (t = first(q); (t != NULL) && (t->tick <= now); t = first(q)) {
+		q->announce_tick = t->tick;
+		t->dticks = 0;
+		remove_timeout(q, t);
+#ifdef CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE
+		q->stats.expired++;
+#endif /* CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE */
+
+		timeout_q_unlock(q, key);
+		t->fn(t);
+		key = timeout_q_lock(q);
+
+		K_SPINLOCK(&tick_lock) {
+			now = curr_tick;
+		}
+	}
+
+	q->announcing = false;
+
+	sys_clock_set_timeout(next_timeout(q), false);
+
+	timeout_q_unlock(q, key);
+}
+#else
+static void announce_local(struct timeout_q *q, int32_t ticks)
 {
-	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	k_spinlock_key_t key;
+	struct _timeout *t;
+
+	key = timeout_q_lock(q);
 
 	/* We release the lock around the callbacks below, so on SMP
 	 * systems someone might be already running the loop.  Don't
@@ -239,52 +688,70 @@ void sys_clock_announce(int32_t ticks)
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
 		announce_remaining += ticks;
-		k_spin_unlock(&timeout_lock, key);
+		timeout_q_unlock(q, key);
 		return;
 	}
 
 	announce_remaining = ticks;
 
-	struct _timeout *t;
-
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
+	for (t = first(q);
+	     (t != NULL) && (first_dticks(t, curr_tick) <= announce_remaining);
+	     t = first(q)) {
+		int dt = first_dticks(t, curr_tick);
 
 		curr_tick += dt;
 		t->dticks = 0;
-		remove_timeout(t);
+		remove_timeout(q, t);
+#ifdef CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE
+		q->stats.expired++;
+#endif /* CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE */
 
-		k_spin_unlock(&timeout_lock, key);
+		timeout_q_unlock(q, key);
 		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
+		key = timeout_q_lock(q);
 		announce_remaining -= dt;
 	}
 
+#ifndef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* The delta list is relative to curr_tick, which moves below */
 	if (t != NULL) {
 		t->dticks -= announce_remaining;
 	}
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
-	sys_clock_set_timeout(next_timeout(0), false);
+	sys_clock_set_timeout(timeout_to_wait(first(q), curr_tick, 0), false);
 
-	k_spin_unlock(&timeout_lock, key);
+	timeout_q_unlock(q, key);
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+void sys_clock_announce(int32_t ticks)
+{
+	announce_local(local_timeout_q(), ticks);
 
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
 #endif /* CONFIG_TIMESLICING */
+
+#ifdef CONFIG_RCU
+	z_rcu_tick();
+#endif /* CONFIG_RCU */
 }
 
 int64_t sys_clock_tick_get(void)
 {
-	uint64_t t = 0U;
+	struct timeout_q *q = local_timeout_q();
+	k_spinlock_key_t key;
+	int32_t ticks_elapsed;
+	uint64_t t;
+
+	key = timeout_q_lock(q);
+	t = queue_tick(q, &ticks_elapsed) + ticks_elapsed;
+	timeout_q_unlock(q, key);
 
-	K_SPINLOCK(&timeout_lock) {
-		t = curr_tick + elapsed();
-	}
 	return t;
 }
 
@@ -350,6 +817,16 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct _timeout *t;
+
+	/* Queued timeouts hold absolute ticks, keep them relative to curr_tick */
+	for (int i = 0; i < NUM_TIMEOUT_QS; i++) {
+		RB_FOR_EACH_CONTAINER(&timeout_qs[i].tree, t, node) {
+			t->tick = t->tick - curr_tick + tick;
+		}
+	}
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
 	curr_tick = tick;
 }
 
@@ -358,3 +835,74 @@ void z_vrfy_sys_clock_tick_set(uint64_t tick)
 	z_impl_sys_clock_tick_set(tick);
 }
 #endif /* CONFIG_ZTEST */
+
+#ifdef CONFIG_OBJ_CORE_TIMEOUT_QUEUE
+static struct k_obj_type obj_type_timeout_q;
+
+#ifdef CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE
+static int timeout_q_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct timeout_q *q = CONTAINER_OF(obj_core, struct timeout_q, obj_core);
+
+	K_SPINLOCK(&q->lock) {
+		memcpy(stats, &q->stats, sizeof(q->stats));
+	}
+
+	return 0;
+}
+
+static int timeout_q_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct timeout_q *q = CONTAINER_OF(obj_core, struct timeout_q, obj_core);
+
+	K_SPINLOCK(&q->lock) {
+		memset(&q->stats, 0, sizeof(q->stats));
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc timeout_q_stats_desc = {
+	.raw_size = sizeof(struct k_timeout_q_stats),
+	.query_size = sizeof(struct k_timeout_q_stats),
+	.raw   = timeout_q_stats_raw,
+	.query = timeout_q_stats_raw,
+	.reset = timeout_q_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif /* CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE */
+
+static int init_timeout_q_obj_core_list(void)
+{
+	/* Initialize timeout queue object type */
+
+	z_obj_type_init(&obj_type_timeout_q, K_OBJ_TYPE_TIMEOUT_Q_ID,
+			offsetof(struct timeout_q, obj_core));
+
+#ifdef CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE
+	k_obj_type_stats_init(&obj_type_timeout_q, &timeout_q_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE */
+
+	/* Initialize and link the timeout queues */
+
+	for (int i = 0; i < NUM_TIMEOUT_QS; i++) {
+		k_obj_core_init_and_link(K_OBJ_CORE(&timeout_qs[i]),
+					 &obj_type_timeout_q);
+#ifdef CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE
+		k_obj_core_stats_register(K_OBJ_CORE(&timeout_qs[i]),
+					  &timeout_qs[i].stats,
+					  sizeof(struct k_timeout_q_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_TIMEOUT_QUEUE */
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_timeout_q_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_TIMEOUT_QUEUE */
@@ -71,6 +71,61 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+static void sched_histogram_add(struct k_cycle_histogram *hist, uint32_t cycles)
+{
+	int bucket = MAX(LOG2(cycles), 0);
+
+	hist->buckets[MIN(bucket, CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS - 1)]++;
+	hist->sum += cycles;
+}
+
+/* Account for the time <thread> waited between being made ready and now */
+static void sched_wakeup_update(struct _cpu *cpu, struct k_thread *thread,
+				uint32_t now)
+{
+	uint32_t ready_at = thread->base.usage.ready_at;
+
+	if (ready_at == 0) {
+		return;
+	}
+
+	thread->base.usage.ready_at = 0;
+
+	if (thread->base.usage.track_usage) {
+		sched_histogram_add(&thread->base.usage.wakeup_latency, now - ready_at);
+	}
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	if (cpu->usage->track_usage) {
+		sched_histogram_add(&cpu->usage->wakeup_latency, now - ready_at);
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
+}
+
+/* Account for the usage window of <thread> that just ended */
+static void sched_run_length_update(struct _cpu *cpu, struct k_thread *thread)
+{
+	uint32_t cycles = (uint32_t)MIN(thread->base.usage.current, UINT32_MAX);
+
+	sched_histogram_add(&thread->base.usage.run_length, cycles);
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	if (cpu->usage->track_usage && (thread != cpu->idle_thread)) {
+		sched_histogram_add(&cpu->usage->run_length, cycles);
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
+}
+
+void z_sched_usage_ready(struct k_thread *thread)
+{
+	thread->base.usage.ready_at = usage_now();
+}
+#else
+#define sched_wakeup_update(cpu, thread, now)       do { } while (0)
+#define sched_run_length_update(cpu, thread)        do { } while (0)
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 void z_sched_usage_start(struct k_thread *thread)
 {
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
@@ -85,6 +140,8 @@ void z_sched_usage_start(struct k_thread *thread)
 		thread->base.usage.current = 0;
 	}
 
+	sched_wakeup_update(_current_cpu, thread, _current_cpu->usage0);
+
 	k_spin_unlock(&usage_lock, key);
 #else
 	/* One write through a volatile pointer doesn't require
@@ -109,6 +166,7 @@ void z_sched_usage_stop(void)
 
 		if (cpu->current->base.usage.track_usage) {
 			sched_thread_update_usage(cpu->current, cycles);
+			sched_run_length_update(cpu, cpu->current);
 		}
 
 		sched_cpu_update_usage(cpu, cycles);
@@ -163,6 +221,11 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 	stats->idle_cycles =
 		_kernel.cpus[cpu_id].idle_thread->base.usage.total;
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	stats->wakeup_latency = cpu->usage->wakeup_latency;
+	stats->run_length     = cpu->usage->run_length;
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
 	k_spin_unlock(&usage_lock, key);
@@ -220,6 +283,11 @@ void z_sched_thread_usage(struct k_thread *thread,
 	stats->idle_cycles = 0;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	stats->wakeup_latency = thread->base.usage.wakeup_latency;
+	stats->run_length     = thread->base.usage.run_length;
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 	k_spin_unlock(&usage_lock, key);
 }
 
@@ -381,6 +449,10 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->longest = 0ULL;
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	memset(&stats->wakeup_latency, 0, sizeof(stats->wakeup_latency));
+	memset(&stats->run_length, 0, sizeof(stats->run_length));
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 
 	if (thread != _current_cpu->current) {
 
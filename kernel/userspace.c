@@ -596,6 +596,9 @@ static void unref_check(struct k_object *ko, uintptr_t index)
 	case K_OBJ_STACK:
 		k_stack_cleanup((struct k_stack *)ko->name);
 		break;
+	case K_OBJ_MPMCQ:
+		(void)k_mpmcq_cleanup((struct k_mpmcq *)ko->name);
+		break;
 	default:
 		/* Nothing to do */
 		break;
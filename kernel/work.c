@@ -150,6 +150,198 @@ static void finalize_cancel_locked(struct k_work *work)
 	}
 }
 
+/* Mark a work item as no longer running and deal with any
+ * cancellation and flushing issued while it was running.
+ *
+ * Invoked with work lock held.
+ *
+ * Invoked from a work queue thread.
+ *
+ * @param work the work structure that has completed.
+ */
+static void work_done_locked(struct k_work *work)
+{
+	flag_clear(&work->flags, K_WORK_RUNNING_BIT);
+	if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+		finalize_flush_locked(work);
+	}
+	if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
+		finalize_cancel_locked(work);
+	}
+}
+
+#if defined(CONFIG_WORKQUEUE_MULTI)
+static inline bool queue_is_multi(const struct k_work_q *queue)
+{
+	return queue->workers != NULL;
+}
+
+/* Find the worker of a multi-threaded queue the current thread belongs
+ * to, if any.
+ */
+static struct k_work_q_worker *worker_current(struct k_work_q *queue)
+{
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (&queue->workers[i].thread == _current) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the worker of a multi-threaded queue that is running a work item.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work_q_worker *worker_running_locked(struct k_work_q *queue,
+						     const struct k_work *work)
+{
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (queue->workers[i].work == work) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the worker of a multi-threaded queue holding a queued work item.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work_q_worker *worker_pending_locked(struct k_work_q *queue,
+						     const struct k_work *work)
+{
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (sys_slist_find(&queue->workers[i].pending, &work->node, NULL)) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Wake one idle worker of a multi-threaded queue, trying workers in
+ * round-robin order.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the worker that was woken, or NULL if all workers are busy.
+ */
+static struct k_work_q_worker *workers_wake_locked(struct k_work_q *queue)
+{
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		struct k_work_q_worker *worker = &queue->workers[queue->next_worker];
+
+		queue->next_worker = (queue->next_worker + 1U) % queue->num_workers;
+		if (z_sched_wake(&worker->notifyq, 0, NULL)) {
+			return worker;
+		}
+	}
+
+	return NULL;
+}
+
+/* Add a work item to one of the workers of a multi-threaded queue.
+ *
+ * Work that is running is added to the worker running it, so that the
+ * handler is never invoked on two workers at once.  Work submitted from a
+ * worker is added to that worker.  Other work is given to an idle worker if
+ * there is one.  In all cases an idle worker is woken so that it can take
+ * the work if the worker it was added to is busy.
+ *
+ * Invoked with work lock held.
+ */
+static void workers_append_locked(struct k_work_q *queue, struct k_work *work)
+{
+	struct k_work_q_worker *worker = NULL;
+	struct k_work_q_worker *idle;
+
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		worker = worker_running_locked(queue, work);
+		__ASSERT_NO_MSG(worker != NULL);
+	} else if (!k_is_in_isr()) {
+		worker = worker_current(queue);
+	}
+
+	idle = workers_wake_locked(queue);
+	if ((worker == NULL) && (idle != NULL)) {
+		worker = idle;
+	} else if (worker == NULL) {
+		/* All workers are busy, spread the work over them */
+		worker = &queue->workers[queue->next_worker];
+		queue->next_worker = (queue->next_worker + 1U) % queue->num_workers;
+	} else {
+		/* Keep the work with its worker */
+		;
+	}
+
+	sys_slist_append(&worker->pending, &work->node);
+}
+
+/* Check whether the first item of another worker's list may be taken.
+ *
+ * Work running on its worker must stay there, and so must work followed
+ * by a flusher, as the flusher is only done after the work completes.
+ * Flushers themselves are never taken.
+ */
+static bool work_can_steal(sys_snode_t *node)
+{
+	struct k_work *work = CONTAINER_OF(node, struct k_work, node);
+	sys_snode_t *next = sys_slist_peek_next(node);
+
+	if ((flags_get(&work->flags) & (K_WORK_RUNNING | K_WORK_FLUSHING)) != 0U) {
+		return false;
+	}
+
+	return (next == NULL) ||
+	       !flag_test(&CONTAINER_OF(next, struct k_work, node)->flags,
+			  K_WORK_FLUSHING_BIT);
+}
+
+/* Get the next work item for a worker, taking it from another worker
+ * if the worker has no work of its own.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work *worker_next_locked(struct k_work_q *queue,
+					 struct k_work_q_worker *worker)
+{
+	size_t self = worker - queue->workers;
+	sys_snode_t *node = sys_slist_get(&worker->pending);
+
+	for (size_t i = 1; (node == NULL) && (i < queue->num_workers); i++) {
+		struct k_work_q_worker *other =
+			&queue->workers[(self + i) % queue->num_workers];
+
+		node = sys_slist_peek_head(&other->pending);
+		if ((node != NULL) && work_can_steal(node)) {
+			(void)sys_slist_get(&other->pending);
+		} else {
+			node = NULL;
+		}
+	}
+
+	return (node != NULL) ? CONTAINER_OF(node, struct k_work, node) : NULL;
+}
+
+/* Check whether any worker of a multi-threaded queue is running work.
+ *
+ * Invoked with work lock held.
+ */
+static bool workers_busy_locked(const struct k_work_q *queue)
+{
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (queue->workers[i].work != NULL) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
+
 void k_work_init(struct k_work *work,
 		  k_work_handler_t handler)
 {
@@ -193,6 +385,24 @@ static void queue_flusher_locked(struct k_work_q *queue,
 {
 	init_flusher(flusher);
 
+#if defined(CONFIG_WORKQUEUE_MULTI)
+	if (queue_is_multi(queue)) {
+		struct k_work_q_worker *worker;
+
+		if ((flags_get(&work->flags) & K_WORK_QUEUED) != 0U) {
+			worker = worker_pending_locked(queue, work);
+			__ASSERT_NO_MSG(worker != NULL);
+			sys_slist_insert(&worker->pending, &work->node,
+					 &flusher->work.node);
+		} else {
+			worker = worker_running_locked(queue, work);
+			__ASSERT_NO_MSG(worker != NULL);
+			sys_slist_prepend(&worker->pending, &flusher->work.node);
+		}
+		return;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
+
 	if ((flags_get(&work->flags) & K_WORK_QUEUED) != 0U) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -212,10 +422,41 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+#if defined(CONFIG_WORKQUEUE_MULTI)
+		if (queue_is_multi(queue)) {
+			for (size_t i = 0; i < queue->num_workers; i++) {
+				if (sys_slist_find_and_remove(&queue->workers[i].pending,
+							      &work->node)) {
+					break;
+				}
+			}
+			return;
+		}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
 	}
 }
 
+/* Check whether a queue has work items waiting to be processed.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_has_pending_locked(const struct k_work_q *queue)
+{
+#if defined(CONFIG_WORKQUEUE_MULTI)
+	if (queue_is_multi(queue)) {
+		for (size_t i = 0; i < queue->num_workers; i++) {
+			if (!sys_slist_is_empty(&queue->workers[i].pending)) {
+				return true;
+			}
+		}
+		return false;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
+
+	return !sys_slist_is_empty(&queue->pending);
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -232,12 +473,35 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	bool rv = false;
 
 	if (queue != NULL) {
+#if defined(CONFIG_WORKQUEUE_MULTI)
+		if (queue_is_multi(queue)) {
+			return workers_wake_locked(queue) != NULL;
+		}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
 		rv = z_sched_wake(&queue->notifyq, 0, NULL);
 	}
 
 	return rv;
 }
 
+/* Check whether the current thread animates a queue, i.e. whether a
+ * submission to the queue is chained from one of its work items.
+ */
+static inline bool queue_is_current(struct k_work_q *queue)
+{
+	if (k_is_in_isr()) {
+		return false;
+	}
+
+#if defined(CONFIG_WORKQUEUE_MULTI)
+	if (queue_is_multi(queue)) {
+		return worker_current(queue) != NULL;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
+
+	return _current == queue->thread_id;
+}
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -265,7 +529,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
-	bool chained = (_current == queue->thread_id) && !k_is_in_isr();
+	bool chained = queue_is_current(queue);
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -283,6 +547,12 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
+#if defined(CONFIG_WORKQUEUE_MULTI)
+		if (queue_is_multi(queue)) {
+			workers_append_locked(queue, work);
+			return 1;
+		}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
 		(void)notify_queue_locked(queue);
@@ -747,13 +1017,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		work_timeout_stop_locked(queue);
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
 
-		flag_clear(&work->flags, K_WORK_RUNNING_BIT);
-		if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
-			finalize_flush_locked(work);
-		}
-		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
-			finalize_cancel_locked(work);
-		}
+		work_done_locked(work);
 
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
@@ -768,6 +1032,82 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	}
 }
 
+#if defined(CONFIG_WORKQUEUE_MULTI)
+/* Loop executed by a worker thread of a multi-threaded work queue.
+ *
+ * @param worker_ptr pointer to the worker structure
+ */
+static void work_queue_worker_main(void *worker_ptr, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct k_work_q_worker *worker = (struct k_work_q_worker *)worker_ptr;
+	struct k_work_q *queue = worker->queue;
+
+	while (true) {
+		struct k_work *work;
+		k_work_handler_t handler;
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		bool yield;
+
+		work = worker_next_locked(queue, worker);
+		if (work == NULL) {
+			/* Draining and stopping complete only once no
+			 * worker has any work left.  The workers exit
+			 * without touching the queue flags, which are
+			 * cleared by k_work_queue_stop() once all of them
+			 * are gone.
+			 */
+			if (!workers_busy_locked(queue) &&
+			    !queue_has_pending_locked(queue)) {
+				if (flag_test_and_clear(&queue->flags,
+							K_WORK_QUEUE_DRAIN_BIT)) {
+					(void)z_sched_wake_all(&queue->drainq, 1, NULL);
+				} else if (flag_test(&queue->flags, K_WORK_QUEUE_STOP_BIT)) {
+					k_spin_unlock(&lock, key);
+					return;
+				} else {
+					/* Nothing to do */
+					;
+				}
+			}
+
+			(void)z_sched_wait(&lock, key, &worker->notifyq,
+					   K_FOREVER, NULL);
+			continue;
+		}
+
+		worker->work = work;
+		flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		flag_set(&work->flags, K_WORK_RUNNING_BIT);
+		flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+		handler = work->handler;
+
+		k_spin_unlock(&lock, key);
+
+		__ASSERT_NO_MSG(handler != NULL);
+		handler(work);
+
+		key = k_spin_lock(&lock);
+
+		worker->work = NULL;
+		work_done_locked(work);
+
+		/* The queue stays busy while any worker runs a handler. */
+		if (!workers_busy_locked(queue)) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
+		k_spin_unlock(&lock, key);
+
+		if (yield) {
+			k_yield();
+		}
+	}
+}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
+
 void k_work_queue_init(struct k_work_q *queue)
 {
 	__ASSERT_NO_MSG(queue != NULL);
@@ -804,6 +1144,9 @@ void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#if defined(CONFIG_WORKQUEUE_MULTI)
+	queue->workers = NULL;
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
 	queue->thread_id = _current;
 	flags_set(&queue->flags, flags);
 	work_queue_main(queue, NULL, NULL);
@@ -826,6 +1169,9 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#if defined(CONFIG_WORKQUEUE_MULTI)
+	queue->workers = NULL;
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -863,6 +1209,75 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#if defined(CONFIG_WORKQUEUE_MULTI)
+void k_work_queue_start_workers(struct k_work_q *queue,
+				struct k_work_q_worker *workers, size_t num_workers,
+				k_thread_stack_t *stacks, size_t stack_size,
+				int prio, const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(workers);
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG((num_workers > 0U) && (num_workers <= UINT16_MAX));
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	uint32_t flags = K_WORK_QUEUE_STARTED;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	sys_slist_init(&queue->pending);
+	z_waitq_init(&queue->notifyq);
+	z_waitq_init(&queue->drainq);
+	queue->workers = workers;
+	queue->num_workers = (uint16_t)num_workers;
+	queue->next_worker = 0U;
+
+	if ((cfg != NULL) && cfg->no_yield) {
+		flags |= K_WORK_QUEUE_NO_YIELD;
+	}
+
+#if defined(CONFIG_WORKQUEUE_WORK_TIMEOUT)
+	queue->work_timeout = K_FOREVER;
+#endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
+
+	/* As for single-threaded queues, all the state is in place before
+	 * the workers get control, so work can be submitted right away.
+	 */
+	flags_set(&queue->flags, flags);
+
+	for (size_t i = 0; i < num_workers; i++) {
+		struct k_work_q_worker *worker = &workers[i];
+
+		worker->queue = queue;
+		worker->work = NULL;
+		sys_slist_init(&worker->pending);
+		z_waitq_init(&worker->notifyq);
+
+		/* Stack array elements are K_THREAD_STACK_LEN() bytes apart */
+		(void)k_thread_create(&worker->thread,
+				      &stacks[i * K_THREAD_STACK_LEN(stack_size)],
+				      stack_size, work_queue_worker_main, worker,
+				      NULL, NULL, prio, 0, K_FOREVER);
+
+		if ((cfg != NULL) && (cfg->name != NULL)) {
+			k_thread_name_set(&worker->thread, cfg->name);
+		}
+
+		if ((cfg != NULL) && (cfg->essential)) {
+			worker->thread.base.user_options |= K_ESSENTIAL;
+		}
+	}
+
+	queue->thread_id = &workers[0].thread;
+
+	for (size_t i = 0; i < num_workers; i++) {
+		k_thread_start(&workers[i].thread);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -877,7 +1292,7 @@ int k_work_queue_drain(struct k_work_q *queue,
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
 	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	    || queue_has_pending_locked(queue)) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -915,12 +1330,56 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	return ret;
 }
 
+/* Wait for the thread(s) animating a queue that is being stopped to exit.
+ *
+ * @retval 0 if all threads exited
+ * @retval -EAGAIN if a thread did not exit before the timeout
+ */
+static int queue_join(struct k_work_q *queue, k_timeout_t timeout)
+{
+#if defined(CONFIG_WORKQUEUE_MULTI)
+	if (queue_is_multi(queue)) {
+		k_timepoint_t end = sys_timepoint_calc(timeout);
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		/* All idle workers must see the stop request */
+		for (size_t i = 0; i < queue->num_workers; i++) {
+			(void)z_sched_wake(&queue->workers[i].notifyq, 0, NULL);
+		}
+		k_spin_unlock(&lock, key);
+
+		for (size_t i = 0; i < queue->num_workers; i++) {
+			int ret = k_thread_join(&queue->workers[i].thread,
+						sys_timepoint_timeout(end));
+
+			if (ret != 0) {
+				return ret;
+			}
+		}
+
+		key = k_spin_lock(&lock);
+		flags_set(&queue->flags, 0);
+		k_spin_unlock(&lock, key);
+
+		return 0;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
+
+	return k_thread_join(queue->thread_id, timeout);
+}
+
 int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 {
 	__ASSERT_NO_MSG(queue);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, stop, queue, timeout);
 
+#if defined(CONFIG_WORKQUEUE_MULTI)
+	if (queue_is_multi(queue) && z_is_thread_essential(queue->thread_id)) {
+		return -ENOTSUP;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_MULTI) */
+
 	if (z_is_thread_essential(&queue->thread)) {
 		return -ENOTSUP;
 	}
@@ -943,7 +1402,7 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 	notify_queue_locked(queue);
 	k_spin_unlock(&lock, key);
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work_queue, stop, queue, timeout);
-	if (k_thread_join(queue->thread_id, timeout)) {
+	if (queue_join(queue, timeout)) {
 		key = k_spin_lock(&lock);
 		flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
 		k_spin_unlock(&lock, key);
@@ -0,0 +1,445 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_swiss.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define GROUP_SSE2 1
+#elif defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__ARM_NEON) &&                           \
+	(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_neon.h>
+#define GROUP_NEON 1
+#endif
+
+/*
+ * Every bucket has a control byte. Buckets in use hold the 7 low bits of the
+ * hash of their key (H2), free buckets have the top bit set. The remaining
+ * bits of the hash (H1) select where probing starts.
+ */
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xfe
+
+#define H1(_hash) ((_hash) >> 7)
+#define H2(_hash) ((uint8_t)((_hash) & 0x7f))
+
+struct swiss_slot {
+	uint64_t key;
+	uint64_t value;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+/*
+ * Group matching: each function returns a mask of the control bytes of the
+ * group starting at @p ctrl that match, and mask_first() gives the position
+ * in the group of the first one.
+ */
+#ifdef GROUP_SSE2
+
+#define GROUP_WIDTH 16
+
+/* One bit per control byte */
+typedef uint32_t group_mask_t;
+
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+	__m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2)));
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *ctrl)
+{
+	return group_match(ctrl, CTRL_EMPTY);
+}
+
+static inline group_mask_t group_match_free(const uint8_t *ctrl)
+{
+	return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+
+static inline size_t mask_first(group_mask_t mask)
+{
+	return u32_count_trailing_zeros(mask);
+}
+
+#else
+
+#define GROUP_WIDTH 8
+
+/* Top bit of each control byte */
+typedef uint64_t group_mask_t;
+
+#define GROUP_LSBS 0x0101010101010101ULL
+#define GROUP_MSBS 0x8080808080808080ULL
+
+static inline uint64_t group_load(const uint8_t *ctrl)
+{
+	/* The first control byte goes to the low bits on any byte order */
+	return sys_get_le64(ctrl);
+}
+
+/* May report bytes following a matching one as matching too */
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+#ifdef GROUP_NEON
+	uint8x8_t eq = vceq_u8(vld1_u8(ctrl), vdup_n_u8(h2));
+
+	return vget_lane_u64(vreinterpret_u64_u8(eq), 0) & GROUP_MSBS;
+#else
+	uint64_t x = group_load(ctrl) ^ (GROUP_LSBS * h2);
+
+	return (x - GROUP_LSBS) & ~x & GROUP_MSBS;
+#endif
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *ctrl)
+{
+	uint64_t x = group_load(ctrl);
+
+	/* Deleted buckets have bit 1 set, empty ones do not */
+	return x & ~(x << 6) & GROUP_MSBS;
+}
+
+static inline group_mask_t group_match_free(const uint8_t *ctrl)
+{
+	return group_load(ctrl) & GROUP_MSBS;
+}
+
+static inline size_t mask_first(group_mask_t mask)
+{
+	return u64_count_trailing_zeros(mask) / 8;
+}
+
+#endif
+
+/* Slots come first in the allocation, followed by the control bytes */
+static inline struct swiss_slot *swiss_slots(const struct sys_hashmap_swiss_data *data)
+{
+	return (struct swiss_slot *)data->buckets;
+}
+
+static inline uint8_t *swiss_ctrl(const struct sys_hashmap_swiss_data *data)
+{
+	return (uint8_t *)&swiss_slots(data)[data->n_buckets];
+}
+
+static inline size_t swiss_alloc_size(size_t n_buckets)
+{
+	/* The first group is mirrored past the end, so that groups can be
+	 * loaded from any bucket without wrapping
+	 */
+	return n_buckets * (sizeof(struct swiss_slot) + 1) + GROUP_WIDTH;
+}
+
+static inline void swiss_set_ctrl(struct sys_hashmap_swiss_data *data, size_t i, uint8_t c)
+{
+	uint8_t *ctrl = swiss_ctrl(data);
+
+	ctrl[i] = c;
+	if (i < GROUP_WIDTH) {
+		ctrl[data->n_buckets + i] = c;
+	}
+}
+
+/*
+ * Return the bucket holding @p key, or SIZE_MAX if there is none. In that
+ * case, @p free is set to the first free bucket that the key may be
+ * inserted in.
+ */
+static size_t sys_hashmap_swiss_find(const struct sys_hashmap *map, uint64_t key, uint32_t hash,
+				     size_t *free)
+{
+	size_t pos;
+	group_mask_t match;
+	const struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	const size_t mask = data->n_buckets - 1;
+	const struct swiss_slot *slots = swiss_slots(data);
+	const uint8_t *ctrl = swiss_ctrl(data);
+
+	if (free != NULL) {
+		*free = SIZE_MAX;
+	}
+
+	pos = H1(hash) & mask;
+
+	/* Triangular probing over groups visits every bucket */
+	for (size_t probed = 0; probed < data->n_buckets; probed += GROUP_WIDTH) {
+		for (match = group_match(&ctrl[pos], H2(hash)); match != 0; match &= match - 1) {
+			size_t i = (pos + mask_first(match)) & mask;
+
+			if (ctrl[i] == H2(hash) && slots[i].key == key) {
+				return i;
+			}
+		}
+
+		if (free != NULL && *free == SIZE_MAX) {
+			match = group_match_free(&ctrl[pos]);
+			if (match != 0) {
+				*free = (pos + mask_first(match)) & mask;
+			}
+		}
+
+		/* The key would have been inserted in an empty bucket */
+		if (group_match_empty(&ctrl[pos]) != 0) {
+			break;
+		}
+
+		pos = (pos + probed + GROUP_WIDTH) & mask;
+	}
+
+	return SIZE_MAX;
+}
+
+static int sys_hashmap_swiss_insert_no_rehash(struct sys_hashmap *map, uint64_t key,
+					      uint64_t value, uint64_t *old_value)
+{
+	size_t i;
+	size_t free;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_slot *slots = swiss_slots(data);
+	uint32_t hash = map->hash_func(&key, sizeof(key));
+
+	i = sys_hashmap_swiss_find(map, key, hash, &free);
+	if (i != SIZE_MAX) {
+		if (old_value != NULL) {
+			*old_value = slots[i].value;
+		}
+		slots[i].value = value;
+
+		return 0;
+	}
+
+	__ASSERT_NO_MSG(free != SIZE_MAX);
+
+	if (swiss_ctrl(data)[free] == CTRL_DELETED) {
+		--data->n_tombstones;
+	}
+
+	swiss_set_ctrl(data, free, H2(hash));
+	slots[free].key = key;
+	slots[free].value = value;
+	++data->size;
+
+	return 1;
+}
+
+static int sys_hashmap_swiss_rehash(struct sys_hashmap *map, bool grow)
+{
+	uint8_t *old_ctrl;
+	size_t old_n_buckets;
+	size_t new_n_buckets = 0;
+	struct swiss_slot *old_slots;
+	void *new_buckets;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+
+	if (!sys_hashmap_should_rehash(map, grow, data->n_tombstones, &new_n_buckets)) {
+		return 0;
+	}
+
+	if (map->data->size != SIZE_MAX && map->data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	/* probing needs at least one whole group */
+	if (new_n_buckets != 0) {
+		new_n_buckets = MAX(new_n_buckets, GROUP_WIDTH);
+	}
+
+	if (new_n_buckets == data->n_buckets) {
+		return 0;
+	}
+
+	/* extract all entries from the hashmap */
+	old_n_buckets = data->n_buckets;
+	old_slots = swiss_slots(data);
+	old_ctrl = swiss_ctrl(data);
+
+	new_buckets = NULL;
+	if (new_n_buckets != 0) {
+		new_buckets = map->alloc_func(NULL, swiss_alloc_size(new_n_buckets));
+		if (new_buckets == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	data->size = 0;
+	data->n_tombstones = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	if (new_buckets != NULL) {
+		/* ensure all buckets are empty */
+		memset(swiss_ctrl(data), CTRL_EMPTY, new_n_buckets + GROUP_WIDTH);
+	}
+
+	/* re-insert all entries into the hashmap */
+	for (size_t i = 0; i < old_n_buckets; ++i) {
+		if ((old_ctrl[i] & CTRL_EMPTY) == 0) {
+			sys_hashmap_swiss_insert_no_rehash(map, old_slots[i].key, old_slots[i].value,
+							   NULL);
+		}
+	}
+
+	/* free the old Hashmap */
+	if (old_slots != NULL) {
+		map->alloc_func(old_slots, 0);
+	}
+
+	return 0;
+}
+
+static void sys_hashmap_swiss_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_slot *slots = swiss_slots(data);
+	uint8_t *ctrl = swiss_ctrl(data);
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = ctrl;
+	}
+
+	i = (uint8_t *)it->state - ctrl;
+	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < map->data->n_buckets; ++i) {
+		if ((ctrl[i] & CTRL_EMPTY) == 0) {
+			it->state = &ctrl[i + 1];
+			it->key = slots[i].key;
+			it->value = slots[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Swiss Table Hashmap API
+ */
+
+static void sys_hashmap_swiss_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_swiss_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_swiss_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_slot *slots = swiss_slots(data);
+	uint8_t *ctrl = swiss_ctrl(data);
+
+	for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size; ++i) {
+		if ((ctrl[i] & CTRL_EMPTY) == 0) {
+			cb(slots[i].key, slots[i].value, cookie);
+			++j;
+		}
+	}
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+	data->n_tombstones = 0;
+}
+
+static int sys_hashmap_swiss_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	int ret;
+
+	ret = sys_hashmap_swiss_rehash(map, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return sys_hashmap_swiss_insert_no_rehash(map, key, value, old_value);
+}
+
+static bool sys_hashmap_swiss_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t i;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+
+	if (data->n_buckets == 0) {
+		return false;
+	}
+
+	i = sys_hashmap_swiss_find(map, key, map->hash_func(&key, sizeof(key)), NULL);
+	if (i == SIZE_MAX) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = swiss_slots(data)[i].value;
+	}
+
+	swiss_set_ctrl(data, i, CTRL_DELETED);
+	--data->size;
+	++data->n_tombstones;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	(void)sys_hashmap_swiss_rehash(map, false);
+
+	return true;
+}
+
+static bool sys_hashmap_swiss_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t i;
+
+	if (map->data->n_buckets == 0) {
+		return false;
+	}
+
+	i = sys_hashmap_swiss_find(map, key, map->hash_func(&key, sizeof(key)), NULL);
+	if (i == SIZE_MAX) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = swiss_slots((struct sys_hashmap_swiss_data *)map->data)[i].value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_swiss_api = {
+	.iter = sys_hashmap_swiss_iter,
+	.clear = sys_hashmap_swiss_clear,
+	.insert = sys_hashmap_swiss_insert,
+	.remove = sys_hashmap_swiss_remove,
+	.get = sys_hashmap_swiss_get,
+};
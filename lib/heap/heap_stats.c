@@ -8,6 +8,7 @@
 #include <zephyr/kernel.h>
 #include "heap.h"
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 int sys_heap_runtime_stats_get(struct sys_heap *heap,
 		struct sys_memory_stats *stats)
 {
@@ -32,3 +33,30 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 
 	return 0;
 }
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
+#ifdef CONFIG_SYS_HEAP_CACHE_STATS
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+		struct sys_heap_cache_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	if (heap->cache_stats == NULL) {
+		return -ENOTSUP;
+	}
+
+	*stats = (struct sys_heap_cache_stats) {};
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		stats->hits += heap->cache_stats[i].hits;
+		stats->misses += heap->cache_stats[i].misses;
+		stats->refills += heap->cache_stats[i].refills;
+		stats->drains += heap->cache_stats[i].drains;
+		stats->cached_bytes += heap->cache_stats[i].cached_bytes;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_HEAP_CACHE_STATS */
@@ -16,10 +16,48 @@ LOG_MODULE_REGISTER(p4wq, CONFIG_LOG_DEFAULT_LEVEL);
 
 struct device;
 
+#ifdef CONFIG_P4WQ_AGING
+/* 64-bit cycle count used to age items, which does not wrap while
+ * they wait.  Tick precision is plenty for aging intervals.
+ */
+static uint64_t aging_now(void)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	return k_cycle_get_64();
+#else
+	return k_ticks_to_cyc_floor64(k_uptime_ticks());
+#endif
+}
+#endif
+
+/* Priority of an item, after aging while it waited in the queue */
+static int32_t item_prio(struct k_p4wq_work *item)
+{
+#ifdef CONFIG_P4WQ_AGING
+	uint32_t aging = item->queue->aging;
+
+	if (aging != 0U) {
+		/* Don't age preemptible items into cooperative ones */
+		int32_t limit = item->priority < 0 ? K_HIGHEST_THREAD_PRIO : 0;
+		uint64_t levels = (aging_now() - item->aging_start) / aging;
+
+		/* Saturates at the limit however long the item waited */
+		if (item->priority <= limit ||
+		    levels >= (uint64_t)(item->priority - limit)) {
+			return MIN(item->priority, limit);
+		}
+
+		return item->priority - (int32_t)levels;
+	}
+#endif
+
+	return item->priority;
+}
+
 static void set_prio(struct k_thread *th, struct k_p4wq_work *item)
 {
 	__ASSERT_NO_MSG(!IS_ENABLED(CONFIG_SMP) || !z_is_thread_queued(th));
-	th->base.prio = item->priority;
+	th->base.prio = item_prio(item);
 	th->base.prio_deadline = item->deadline;
 }
 
@@ -28,6 +66,35 @@ static bool rb_lessthan(struct rbnode *a, struct rbnode *b)
 	struct k_p4wq_work *aw = CONTAINER_OF(a, struct k_p4wq_work, rbnode);
 	struct k_p4wq_work *bw = CONTAINER_OF(b, struct k_p4wq_work, rbnode);
 
+#ifdef CONFIG_P4WQ_AGING
+	uint32_t aging = aw->queue->aging;
+
+	/* Aging saturates at the highest preemptible priority, so a
+	 * cooperative item always runs before a preemptible one.  Within
+	 * a class, items gain a priority level per aging interval, all at
+	 * the same rate and up to the same limit, so their order only
+	 * depends on the time at which they reach a given priority and
+	 * stays stable in the tree.  Saturated items run in the order in
+	 * which they reached the limit.
+	 */
+	if (aging != 0U) {
+		bool a_coop = aw->priority < 0;
+		bool b_coop = bw->priority < 0;
+		int64_t d;
+
+		if (a_coop != b_coop) {
+			return b_coop;
+		}
+
+		d = (int64_t)(aw->priority - bw->priority) * aging +
+		    (int64_t)(aw->aging_start - bw->aging_start);
+
+		if (d != 0) {
+			return d > 0;
+		}
+	}
+#endif
+
 	if (aw->priority != bw->priority) {
 		return aw->priority > bw->priority;
 	}
@@ -92,12 +159,27 @@ static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 			set_prio(_current, w);
 			thread_clear_requeued(_current);
 
+#ifdef CONFIG_P4WQ_STATS
+			uint32_t start = k_cycle_get_32();
+			uint32_t wait = start - w->submitted;
+#endif
+
 			k_spin_unlock(&queue->lock, k);
 
 			w->handler(w);
 
 			k = k_spin_lock(&queue->lock);
 
+#ifdef CONFIG_P4WQ_STATS
+			uint32_t run = k_cycle_get_32() - start;
+
+			queue->stats.count++;
+			queue->stats.wait_total += wait;
+			queue->stats.wait_max = MAX(queue->stats.wait_max, wait);
+			queue->stats.run_total += run;
+			queue->stats.run_max = MAX(queue->stats.run_max, run);
+#endif
+
 			/* Remove from the active list only if it
 			 * wasn't resubmitted already
 			 */
@@ -224,15 +306,22 @@ SYS_INIT(static_init, POST_KERNEL, 1);
 SYS_INIT(static_init, APPLICATION, 99);
 #endif
 
-void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+static void queue_item(struct k_p4wq *queue, struct k_p4wq_work *item,
+		       uint32_t now, uint64_t now64)
 {
-	k_spinlock_key_t k = k_spin_lock(&queue->lock);
-
 	/* Input is a delta time from now (to match
 	 * k_thread_deadline_set()), but we store and use the absolute
 	 * cycle count.
 	 */
-	item->deadline += k_cycle_get_32();
+	item->deadline += now;
+#ifdef CONFIG_P4WQ_AGING
+	item->aging_start = now64;
+#else
+	ARG_UNUSED(now64);
+#endif
+#ifdef CONFIG_P4WQ_STATS
+	item->submitted = now;
+#endif
 
 	/* Resubmission from within handler?  Remove from active list */
 	if (item->thread == _current) {
@@ -244,22 +333,49 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	}
 	__ASSERT_NO_MSG(item->thread == NULL);
 
-	rb_insert(&queue->queue, &item->rbnode);
+	/* The tree ordering may depend on the queue */
 	item->queue = queue;
+	rb_insert(&queue->queue, &item->rbnode);
+}
 
-	/* If there were other items already ahead of it in the queue,
-	 * then we don't need to revisit active thread state and can
-	 * return.
+void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+{
+	k_p4wq_submit_many(queue, &item, 1);
+}
+
+void k_p4wq_submit_many(struct k_p4wq *queue, struct k_p4wq_work **items,
+			size_t count)
+{
+	k_spinlock_key_t k = k_spin_lock(&queue->lock);
+	struct rbnode *prev_max = rb_get_max(&queue->queue);
+	uint32_t now = k_cycle_get_32();
+	uint64_t now64 = 0U;
+	bool woken = false;
+
+#ifdef CONFIG_P4WQ_AGING
+	now64 = aging_now();
+#endif
+
+	for (size_t i = 0; i < count; i++) {
+		queue_item(queue, items[i], now, now64);
+	}
+
+	/* If there were other items already ahead of the new ones in
+	 * the queue, then we don't need to revisit active thread
+	 * state and can return.
 	 */
-	if (rb_get_max(&queue->queue) != &item->rbnode) {
+	struct rbnode *max = rb_get_max(&queue->queue);
+
+	if (max == prev_max) {
 		goto out;
 	}
 
 	/* Check the list of active (running or preempted) items, if
 	 * there are at least an "active target" of those that are
-	 * higher priority than the new item, then no one needs to be
-	 * preempted and we can return.
+	 * higher priority than the best new item, then no one needs
+	 * to be preempted and we can return.
 	 */
+	struct k_p4wq_work *item = CONTAINER_OF(max, struct k_p4wq_work, rbnode);
 	struct k_p4wq_work *wi;
 	uint32_t n_beaten_by = 0, active_target = arch_num_cpus();
 
@@ -274,28 +390,29 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 		}
 	}
 
-	if (n_beaten_by >= active_target) {
-		/* Too many already have higher priority, not preempting */
-		goto out;
-	}
-
-	/* Grab a thread, set its priority and queue it.  If there are
-	 * no threads available to unpend, this is a soft runtime
-	 * error: we are breaking our promise about run order.
-	 * Complain.
+	/* Grab a thread for each new item up to the active target, set
+	 * its priority and queue it.  The threads pick the items to
+	 * run themselves, starting with the best one.  If there are no
+	 * threads available to unpend, this is a soft runtime error:
+	 * we are breaking our promise about run order.  Complain.
 	 */
-	struct k_thread *th = z_unpend_first_thread(&queue->waitq);
+	for (size_t i = 0; (i < count) && (n_beaten_by + i < active_target); i++) {
+		struct k_thread *th = z_unpend_first_thread(&queue->waitq);
 
-	if (th == NULL) {
-		LOG_WRN("Out of worker threads, priority guarantee violated");
-		goto out;
-	}
+		if (th == NULL) {
+			LOG_WRN("Out of worker threads, priority guarantee violated");
+			break;
+		}
 
-	set_prio(th, item);
-	z_ready_thread(th);
-	z_reschedule(&queue->lock, k);
+		set_prio(th, item);
+		z_ready_thread(th);
+		woken = true;
+	}
 
-	return;
+	if (woken) {
+		z_reschedule(&queue->lock, k);
+		return;
+	}
 
 out:
 	k_spin_unlock(&queue->lock, k);
@@ -321,3 +438,38 @@ bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
 	k_spin_unlock(&queue->lock, k);
 	return ret;
 }
+
+#ifdef CONFIG_P4WQ_AGING
+int k_p4wq_aging_set(struct k_p4wq *queue, uint32_t interval)
+{
+	int ret = 0;
+
+	K_SPINLOCK(&queue->lock) {
+		/* Queued items are ordered according to the interval */
+		if (rb_get_min(&queue->queue) != NULL) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		queue->aging = interval;
+	}
+
+	return ret;
+}
+#endif
+
+#ifdef CONFIG_P4WQ_STATS
+void k_p4wq_stats_get(struct k_p4wq *queue, struct k_p4wq_stats *stats)
+{
+	K_SPINLOCK(&queue->lock) {
+		*stats = queue->stats;
+	}
+}
+
+void k_p4wq_stats_reset(struct k_p4wq *queue)
+{
+	K_SPINLOCK(&queue->lock) {
+		queue->stats = (struct k_p4wq_stats){};
+	}
+}
+#endif
@@ -14,28 +14,16 @@
 #include <zephyr/sys/bitarray.h>
 #include <zephyr/sys/sem.h>
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_POSIX_THREAD_THREADS_MAX + 1)
-
-struct posix_rwlock {
-	struct sys_sem rd_sem;
-	struct sys_sem wr_sem;
-	struct sys_sem reader_active; /* blocks WR till reader has acquired lock */
-	k_tid_t wr_owner;
-};
-
 struct posix_rwlockattr {
 	bool initialized: 1;
 	bool pshared: 1;
 };
 
-static uint32_t read_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout);
-static uint32_t write_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout);
-
 LOG_MODULE_REGISTER(pthread_rwlock, CONFIG_PTHREAD_RWLOCK_LOG_LEVEL);
 
 static SYS_SEM_DEFINE(posix_rwlock_lock, 1, 1);
 
-static struct posix_rwlock posix_rwlock_pool[CONFIG_MAX_PTHREAD_RWLOCK_COUNT];
+static struct k_rwlock posix_rwlock_pool[CONFIG_MAX_PTHREAD_RWLOCK_COUNT];
 SYS_BITARRAY_DEFINE_STATIC(posix_rwlock_bitarray, CONFIG_MAX_PTHREAD_RWLOCK_COUNT);
 
 /*
@@ -46,7 +34,7 @@ SYS_BITARRAY_DEFINE_STATIC(posix_rwlock_bitarray, CONFIG_MAX_PTHREAD_RWLOCK_COUN
 BUILD_ASSERT(CONFIG_MAX_PTHREAD_RWLOCK_COUNT < PTHREAD_OBJ_MASK_INIT,
 	     "CONFIG_MAX_PTHREAD_RWLOCK_COUNT is too high");
 
-static inline size_t posix_rwlock_to_offset(struct posix_rwlock *rwl)
+static inline size_t posix_rwlock_to_offset(struct k_rwlock *rwl)
 {
 	return rwl - posix_rwlock_pool;
 }
@@ -56,7 +44,7 @@ static inline size_t to_posix_rwlock_idx(pthread_rwlock_t rwlock)
 	return mark_pthread_obj_uninitialized(rwlock);
 }
 
-static struct posix_rwlock *get_posix_rwlock(pthread_rwlock_t rwlock)
+static struct k_rwlock *get_posix_rwlock(pthread_rwlock_t rwlock)
 {
 	int actually_initialized;
 	size_t bit = to_posix_rwlock_idx(rwlock);
@@ -82,10 +70,10 @@ static struct posix_rwlock *get_posix_rwlock(pthread_rwlock_t rwlock)
 	return &posix_rwlock_pool[bit];
 }
 
-struct posix_rwlock *to_posix_rwlock(pthread_rwlock_t *rwlock)
+struct k_rwlock *to_posix_rwlock(pthread_rwlock_t *rwlock)
 {
 	size_t bit;
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
 
 	if (*rwlock != PTHREAD_RWLOCK_INITIALIZER) {
 		return get_posix_rwlock(*rwlock);
@@ -114,7 +102,7 @@ struct posix_rwlock *to_posix_rwlock(pthread_rwlock_t *rwlock)
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
 
 	ARG_UNUSED(attr);
 	*rwlock = PTHREAD_RWLOCK_INITIALIZER;
@@ -124,10 +112,7 @@ int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 		return ENOMEM;
 	}
 
-	sys_sem_init(&rwl->rd_sem, CONCURRENT_READER_LIMIT, CONCURRENT_READER_LIMIT);
-	sys_sem_init(&rwl->wr_sem, 1, 1);
-	sys_sem_init(&rwl->reader_active, 1, 1);
-	rwl->wr_owner = NULL;
+	(void)k_rwlock_init(rwl, 0);
 
 	LOG_DBG("Initialized rwlock %p", rwl);
 
@@ -144,7 +129,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 	int err;
 	size_t bit;
 	int ret = EINVAL;
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
 
 	SYS_SEM_LOCK(&posix_rwlock_lock) {
 		rwl = get_posix_rwlock(*rwlock);
@@ -153,7 +138,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 			SYS_SEM_LOCK_BREAK;
 		}
 
-		if (rwl->wr_owner != NULL) {
+		if ((rwl->writer != NULL) || (rwl->readers != 0U)) {
 			ret = EBUSY;
 			SYS_SEM_LOCK_BREAK;
 		}
@@ -167,39 +152,51 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 	return ret;
 }
 
+/* Translate the result of a k_rwlock lock call to a POSIX error number */
+static int lock_result(int ret)
+{
+	switch (ret) {
+	case 0:
+		return 0;
+	case -EBUSY:
+		return EBUSY;
+	case -EDEADLK:
+		return EDEADLK;
+	default:
+		return ETIMEDOUT;
+	}
+}
+
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
+ * Writers are preferred: a thread holding a read lock that locks it again
+ * may deadlock if another thread waits for a write lock in the meantime.
  *
  * See IEEE 1003.1
  */
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 {
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
 
 	rwl = get_posix_rwlock(*rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwl, SYS_FOREVER_MS);
+	return lock_result(k_rwlock_read_lock(rwl, K_FOREVER));
 }
 
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
-	uint32_t ret = 0U;
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
+	k_timeout_t timeout;
 
 	if ((abstime == NULL) || !timespec_is_valid(abstime)) {
 		LOG_DBG("%s is invalid", "abstime");
@@ -211,66 +208,65 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 		return EINVAL;
 	}
 
-	if (read_lock_acquire(rwl, timespec_to_timeoutms(CLOCK_REALTIME, abstime)) != 0U) {
-		ret = ETIMEDOUT;
+	timeout = SYS_TIMEOUT_MS(timespec_to_timeoutms(CLOCK_REALTIME, abstime));
+	if (k_rwlock_read_lock(rwl, timeout) != 0) {
+		return ETIMEDOUT;
 	}
 
-	return ret;
+	return 0;
 }
 
 /**
  * @brief Lock a read-write lock object for reading immediately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 {
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
 
 	rwl = get_posix_rwlock(*rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwl, 0);
+	return lock_result(k_rwlock_read_lock(rwl, K_NO_WAIT));
 }
 
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Write lock has priority over reader lock: readers wait while a
+ * thread waits for the write lock.
  *
  * See IEEE 1003.1
  */
 int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 {
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
 
 	rwl = get_posix_rwlock(*rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwl, SYS_FOREVER_MS);
+	return lock_result(k_rwlock_write_lock(rwl, K_FOREVER));
 }
 
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Write lock has priority over reader lock: readers wait while a
+ * thread waits for the write lock.
  *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
-	uint32_t ret = 0U;
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
+	k_timeout_t timeout;
+	int ret;
 
 	if ((abstime == NULL) || !timespec_is_valid(abstime)) {
 		LOG_DBG("%s is invalid", "abstime");
@@ -282,31 +278,34 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 		return EINVAL;
 	}
 
-	if (write_lock_acquire(rwl, timespec_to_timeoutms(CLOCK_REALTIME, abstime)) != 0U) {
-		ret = ETIMEDOUT;
+	timeout = SYS_TIMEOUT_MS(timespec_to_timeoutms(CLOCK_REALTIME, abstime));
+	ret = k_rwlock_write_lock(rwl, timeout);
+	if (ret == -EBUSY) {
+		/* The deadline has already passed */
+		ret = -EAGAIN;
 	}
 
-	return ret;
+	return lock_result(ret);
 }
 
 /**
  * @brief Lock a read-write lock object for writing immediately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * Write lock has priority over reader lock: readers wait while a
+ * thread waits for the write lock.
  *
  * See IEEE 1003.1
  */
 int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 {
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
 
 	rwl = get_posix_rwlock(*rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwl, 0);
+	return lock_result(k_rwlock_write_lock(rwl, K_NO_WAIT));
 }
 
 /**
@@ -317,76 +316,20 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
  */
 int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
-	struct posix_rwlock *rwl;
+	struct k_rwlock *rwl;
 
 	rwl = get_posix_rwlock(*rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	if (k_current_get() == rwl->wr_owner) {
-		/* Write unlock */
-		rwl->wr_owner = NULL;
-		(void)sys_sem_give(&rwl->reader_active);
-		(void)sys_sem_give(&rwl->wr_sem);
-	} else {
-		/* Read unlock */
-		(void)sys_sem_give(&rwl->rd_sem);
-
-		if (sys_sem_count_get(&rwl->rd_sem) == CONCURRENT_READER_LIMIT) {
-			/* Last read lock, unlock writer */
-			(void)sys_sem_give(&rwl->reader_active);
-		}
-	}
-	return 0;
-}
-
-static uint32_t read_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout)
-{
-	uint32_t ret = 0U;
-
-	if (sys_sem_take(&rwl->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
-		(void)sys_sem_take(&rwl->reader_active, K_NO_WAIT);
-		(void)sys_sem_take(&rwl->rd_sem, K_NO_WAIT);
-		(void)sys_sem_give(&rwl->wr_sem);
-	} else {
-		ret = EBUSY;
+	if (rwl->writer == k_current_get()) {
+		(void)k_rwlock_write_unlock(rwl);
+	} else if (k_rwlock_read_unlock(rwl) != 0) {
+		return EPERM;
 	}
 
-	return ret;
-}
-
-static uint32_t write_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout)
-{
-	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
-
-	k_timeout = SYS_TIMEOUT_MS(timeout);
-
-	/* waiting for release of write lock */
-	if (sys_sem_take(&rwl->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
-		}
-
-		k_timeout = SYS_TIMEOUT_MS(timeout);
-
-		/* waiting for reader to complete operation */
-		if (sys_sem_take(&rwl->reader_active, k_timeout) == 0) {
-			rwl->wr_owner = k_current_get();
-		} else {
-			(void)sys_sem_give(&rwl->wr_sem);
-			ret = EBUSY;
-		}
-
-	} else {
-		ret = EBUSY;
-	}
-	return ret;
+	return 0;
 }
 
 int pthread_rwlockattr_getpshared(const pthread_rwlockattr_t *ZRESTRICT attr,
@@ -0,0 +1,357 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * A tree of N leaves where every interior node has at least two children
+ * has at most N - 1 interior nodes. Each leaf thus brings along the
+ * storage for one interior node: inserting a leaf either adds it to an
+ * existing interior node, or splits an edge with a new interior node
+ * taken from the leaf itself. Removing a leaf may collapse its parent,
+ * and frees the leaf's own storage, so an interior node living there is
+ * moved to the storage of the collapsed parent, or to any unused one.
+ */
+
+#include <errno.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/radix_tree.h>
+
+BUILD_ASSERT(Z_RADIX_FANOUT <= 16, "Interior node bitmap too small");
+
+#define DIGIT_MASK (Z_RADIX_FANOUT - 1U)
+#define LEAF_TAG   1U
+
+static inline bool is_leaf(uintptr_t ref)
+{
+	return (ref & LEAF_TAG) != 0U;
+}
+
+static inline struct radix_node *to_leaf(uintptr_t ref)
+{
+	return (struct radix_node *)(ref & ~(uintptr_t)LEAF_TAG);
+}
+
+static inline struct z_radix_inner *to_inner(uintptr_t ref)
+{
+	return (struct z_radix_inner *)ref;
+}
+
+static inline unsigned int digit(uint64_t key, unsigned int shift)
+{
+	return (unsigned int)(key >> shift) & DIGIT_MASK;
+}
+
+/* Position of the most significant digit in which two keys differ */
+static inline unsigned int crit_shift(uint64_t diff)
+{
+	unsigned int msb = 63U - (unsigned int)__builtin_clzll(diff);
+
+	return msb - (msb % Z_RADIX_BITS);
+}
+
+static void set_parent(uintptr_t ref, struct z_radix_inner *parent, unsigned int slot)
+{
+	if (is_leaf(ref)) {
+		to_leaf(ref)->parent = parent;
+	} else {
+		to_inner(ref)->parent = parent;
+		to_inner(ref)->slot = slot;
+	}
+}
+
+static void replace(struct radix_tree *tree, struct z_radix_inner *parent,
+		    unsigned int slot, uintptr_t ref)
+{
+	if (parent != NULL) {
+		parent->child[slot] = ref;
+	} else {
+		tree->root = ref;
+	}
+}
+
+static void attach(struct z_radix_inner *in, unsigned int slot, uintptr_t ref)
+{
+	in->child[slot] = ref;
+	in->bitmap |= BIT(slot);
+	set_parent(ref, in, slot);
+}
+
+static struct radix_node *edge_leaf(uintptr_t ref, bool max)
+{
+	while (!is_leaf(ref)) {
+		struct z_radix_inner *in = to_inner(ref);
+		unsigned int slot = max ? 31U - __builtin_clz(in->bitmap)
+					: __builtin_ctz(in->bitmap);
+
+		ref = in->child[slot];
+	}
+
+	return to_leaf(ref);
+}
+
+/* Leaf sharing the longest prefix with the key */
+static struct radix_node *closest_leaf(uintptr_t ref, uint64_t key)
+{
+	while (!is_leaf(ref)) {
+		struct z_radix_inner *in = to_inner(ref);
+		unsigned int slot = digit(key, in->shift);
+
+		if ((in->bitmap & BIT(slot)) == 0U) {
+			/* All leaves below share the same prefix */
+			return edge_leaf(ref, false);
+		}
+		ref = in->child[slot];
+	}
+
+	return to_leaf(ref);
+}
+
+/* First node on the path of the key that is a leaf, or that branches at
+ * or below the given digit position, along with its parent.
+ */
+static uintptr_t descend(struct radix_tree *tree, uint64_t key, unsigned int shift,
+			 struct z_radix_inner **parent)
+{
+	uintptr_t ref = tree->root;
+
+	*parent = NULL;
+	while (!is_leaf(ref) && (to_inner(ref)->shift > shift)) {
+		*parent = to_inner(ref);
+		ref = (*parent)->child[digit(key, (*parent)->shift)];
+	}
+
+	return ref;
+}
+
+/* First leaf after a given child slot of an interior node */
+static struct radix_node *next_after(struct z_radix_inner *in, unsigned int slot)
+{
+	while (in != NULL) {
+		uint32_t later = in->bitmap & ~(BIT(slot + 1U) - 1U);
+
+		if (later != 0U) {
+			return edge_leaf(in->child[__builtin_ctz(later)], false);
+		}
+		slot = in->slot;
+		in = in->parent;
+	}
+
+	return NULL;
+}
+
+/* Last leaf before a given child slot of an interior node */
+static struct radix_node *prev_before(struct z_radix_inner *in, unsigned int slot)
+{
+	while (in != NULL) {
+		uint32_t earlier = in->bitmap & (BIT(slot) - 1U);
+
+		if (earlier != 0U) {
+			return edge_leaf(in->child[31U - __builtin_clz(earlier)], true);
+		}
+		slot = in->slot;
+		in = in->parent;
+	}
+
+	return NULL;
+}
+
+static void relocate(struct radix_tree *tree, struct z_radix_inner *from,
+		     struct z_radix_inner *to)
+{
+	*to = *from;
+	replace(tree, to->parent, to->slot, (uintptr_t)to);
+
+	for (uint32_t map = to->bitmap; map != 0U; map &= map - 1U) {
+		unsigned int slot = __builtin_ctz(map);
+
+		set_parent(to->child[slot], to, slot);
+	}
+
+	from->used = false;
+}
+
+int radix_tree_insert(struct radix_tree *tree, struct radix_node *node, uint64_t key)
+{
+	struct z_radix_inner *parent;
+	struct z_radix_inner *in;
+	struct radix_node *near;
+	unsigned int shift;
+	unsigned int slot;
+	uintptr_t ref;
+
+	if (tree->root == 0U) {
+		sys_dlist_init(&tree->free);
+		node->key = key;
+		node->parent = NULL;
+		node->inner.used = false;
+		sys_dlist_append(&tree->free, &node->inner.free_node);
+		tree->root = (uintptr_t)node | LEAF_TAG;
+		return 0;
+	}
+
+	near = closest_leaf(tree->root, key);
+	if (near->key == key) {
+		return -EEXIST;
+	}
+
+	node->key = key;
+	shift = crit_shift(key ^ near->key);
+	ref = descend(tree, key, shift, &parent);
+
+	if (!is_leaf(ref) && (to_inner(ref)->shift == shift)) {
+		/* The slot of the key is free in an existing interior node */
+		attach(to_inner(ref), digit(key, shift), (uintptr_t)node | LEAF_TAG);
+		node->inner.used = false;
+		sys_dlist_append(&tree->free, &node->inner.free_node);
+		return 0;
+	}
+
+	/* Split the edge above ref with the interior node of the new leaf */
+	slot = (parent != NULL) ? digit(key, parent->shift) : 0U;
+	in = &node->inner;
+	in->used = true;
+	in->shift = shift;
+	in->bitmap = 0U;
+	in->parent = parent;
+	in->slot = slot;
+	replace(tree, parent, slot, (uintptr_t)in);
+	attach(in, digit(near->key, shift), ref);
+	attach(in, digit(key, shift), (uintptr_t)node | LEAF_TAG);
+
+	return 0;
+}
+
+void radix_tree_remove(struct radix_tree *tree, struct radix_node *node)
+{
+	struct z_radix_inner *parent = node->parent;
+	struct z_radix_inner *freed = NULL;
+
+	if (parent == NULL) {
+		__ASSERT(tree->root == ((uintptr_t)node | LEAF_TAG), "node not in tree");
+		tree->root = 0U;
+		return;
+	}
+
+	parent->bitmap &= ~BIT(digit(node->key, parent->shift));
+
+	if ((parent->bitmap & (parent->bitmap - 1U)) == 0U) {
+		/* A single child is left, splice the parent out */
+		uintptr_t child = parent->child[__builtin_ctz(parent->bitmap)];
+
+		set_parent(child, parent->parent, parent->slot);
+		replace(tree, parent->parent, parent->slot, child);
+		parent->used = false;
+		freed = parent;
+
+		if (freed == &node->inner) {
+			return;
+		}
+	}
+
+	if (node->inner.used) {
+		/* Some interior node lives in the leaf, move it elsewhere */
+		if (freed == NULL) {
+			sys_dnode_t *dn = sys_dlist_get(&tree->free);
+
+			__ASSERT_NO_MSG(dn != NULL);
+			freed = CONTAINER_OF(dn, struct z_radix_inner, free_node);
+		}
+		relocate(tree, &node->inner, freed);
+		freed = NULL;
+	} else {
+		sys_dlist_remove(&node->inner.free_node);
+	}
+
+	if (freed != NULL) {
+		sys_dlist_append(&tree->free, &freed->free_node);
+	}
+}
+
+struct radix_node *radix_tree_find(struct radix_tree *tree, uint64_t key)
+{
+	uintptr_t ref = tree->root;
+	struct radix_node *leaf;
+
+	if (ref == 0U) {
+		return NULL;
+	}
+
+	while (!is_leaf(ref)) {
+		struct z_radix_inner *in = to_inner(ref);
+		unsigned int slot = digit(key, in->shift);
+
+		if ((in->bitmap & BIT(slot)) == 0U) {
+			return NULL;
+		}
+		ref = in->child[slot];
+	}
+
+	leaf = to_leaf(ref);
+
+	return (leaf->key == key) ? leaf : NULL;
+}
+
+struct radix_node *radix_tree_lower_bound(struct radix_tree *tree, uint64_t key)
+{
+	struct z_radix_inner *parent;
+	struct radix_node *near;
+	unsigned int shift;
+	uintptr_t ref;
+
+	if (tree->root == 0U) {
+		return NULL;
+	}
+
+	near = closest_leaf(tree->root, key);
+	if (near->key == key) {
+		return near;
+	}
+
+	shift = crit_shift(key ^ near->key);
+	ref = descend(tree, key, shift, &parent);
+
+	if (!is_leaf(ref) && (to_inner(ref)->shift == shift)) {
+		/* The key falls in a free slot of this interior node */
+		return next_after(to_inner(ref), digit(key, shift));
+	}
+
+	/* All keys below ref compare with the key as the closest leaf does */
+	if (key < near->key) {
+		return edge_leaf(ref, false);
+	}
+
+	return (parent != NULL) ? next_after(parent, digit(key, parent->shift)) : NULL;
+}
+
+struct radix_node *radix_tree_next(struct radix_tree *tree, struct radix_node *node)
+{
+	ARG_UNUSED(tree);
+
+	if (node->parent == NULL) {
+		return NULL;
+	}
+
+	return next_after(node->parent, digit(node->key, node->parent->shift));
+}
+
+struct radix_node *radix_tree_prev(struct radix_tree *tree, struct radix_node *node)
+{
+	ARG_UNUSED(tree);
+
+	if (node->parent == NULL) {
+		return NULL;
+	}
+
+	return prev_before(node->parent, digit(node->key, node->parent->shift));
+}
+
+struct radix_node *z_radix_tree_get_minmax(struct radix_tree *tree, bool max)
+{
+	if (tree->root == 0U) {
+		return NULL;
+	}
+
+	return edge_leaf(tree->root, max);
+}
@@ -28,6 +28,18 @@ uint32_t ring_buf_area_claim(struct ring_buf *buf, struct ring_buf_index *ring,
 	return size;
 }
 
+uint32_t ring_buf_area_claim_vec(struct ring_buf *buf, struct ring_buf_index *ring,
+				 struct ring_buf_vec vec[2], uint32_t size)
+{
+	/* The second claim starts at the beginning of the buffer area if
+	 * the first one stopped at the wrap point
+	 */
+	vec[0].size = ring_buf_area_claim(buf, ring, &vec[0].data, size);
+	vec[1].size = ring_buf_area_claim(buf, ring, &vec[1].data, size - vec[0].size);
+
+	return vec[0].size + vec[1].size;
+}
+
 int ring_buf_area_finish(struct ring_buf *buf, struct ring_buf_index *ring,
 			 uint32_t size)
 {
@@ -52,21 +64,13 @@ int ring_buf_area_finish(struct ring_buf *buf, struct ring_buf_index *ring,
 
 uint32_t ring_buf_put(struct ring_buf *buf, const uint8_t *data, uint32_t size)
 {
-	uint8_t *dst;
-	uint32_t partial_size;
-	uint32_t total_size = 0U;
+	struct ring_buf_vec vec[2];
+	uint32_t total_size;
 	int err;
 
-	do {
-		partial_size = ring_buf_put_claim(buf, &dst, size);
-		if (partial_size == 0) {
-			break;
-		}
-		memcpy(dst, data, partial_size);
-		total_size += partial_size;
-		size -= partial_size;
-		data += partial_size;
-	} while (size != 0);
+	total_size = ring_buf_put_claim_vec(buf, vec, size);
+	memcpy(vec[0].data, data, vec[0].size);
+	memcpy(vec[1].data, data + vec[0].size, vec[1].size);
 
 	err = ring_buf_put_finish(buf, total_size);
 	__ASSERT_NO_MSG(err == 0);
@@ -77,23 +81,15 @@ uint32_t ring_buf_put(struct ring_buf *buf, const uint8_t *data, uint32_t size)
 
 uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
 {
-	uint8_t *src;
-	uint32_t partial_size;
-	uint32_t total_size = 0U;
+	struct ring_buf_vec vec[2];
+	uint32_t total_size;
 	int err;
 
-	do {
-		partial_size = ring_buf_get_claim(buf, &src, size);
-		if (partial_size == 0) {
-			break;
-		}
-		if (data) {
-			memcpy(data, src, partial_size);
-			data += partial_size;
-		}
-		total_size += partial_size;
-		size -= partial_size;
-	} while (size != 0);
+	total_size = ring_buf_get_claim_vec(buf, vec, size);
+	if (data) {
+		memcpy(data, vec[0].data, vec[0].size);
+		memcpy(data + vec[0].size, vec[1].data, vec[1].size);
+	}
 
 	err = ring_buf_get_finish(buf, total_size);
 	__ASSERT_NO_MSG(err == 0);
@@ -104,22 +100,17 @@ uint32_t ring_buf_get(struct ring_buf *buf, uint8_t *data, uint32_t size)
 
 uint32_t ring_buf_peek(struct ring_buf *buf, uint8_t *data, uint32_t size)
 {
-	uint8_t *src;
-	uint32_t partial_size;
-	uint32_t total_size = 0U;
+	struct ring_buf_vec vec[2];
+	uint32_t total_size;
 	int err;
 
-	do {
-		partial_size = ring_buf_get_claim(buf, &src, size);
-		if (partial_size == 0) {
-			break;
-		}
+	total_size = ring_buf_get_claim_vec(buf, vec, size);
+	if (total_size != 0U) {
+		/* data may be NULL when nothing is copied */
 		__ASSERT_NO_MSG(data != NULL);
-		memcpy(data, src, partial_size);
-		data += partial_size;
-		total_size += partial_size;
-		size -= partial_size;
-	} while (size != 0);
+		memcpy(data, vec[0].data, vec[0].size);
+		memcpy(data + vec[0].size, vec[1].data, vec[1].size);
+	}
 
 	/* effectively unclaim total_size bytes */
 	err = ring_buf_get_finish(buf, 0);
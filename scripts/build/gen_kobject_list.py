@@ -93,9 +93,11 @@ kobjects = OrderedDict(
     [
         ("k_mem_slab", (None, False, True)),
         ("k_msgq", (None, False, True)),
+        ("k_mpmcq", (None, False, True)),
         ("k_mutex", (None, False, True)),
         ("k_pipe", (None, False, True)),
         ("k_queue", (None, False, True)),
+        ("k_rwlock", (None, False, True)),
         ("k_poll_signal", (None, False, True)),
         ("k_sem", (None, False, True)),
         ("k_stack", (None, False, True)),
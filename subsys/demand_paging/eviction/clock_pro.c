@@ -0,0 +1,308 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CLOCK-Pro eviction algorithm for demand paging.
+ *
+ * This is a scan-resistant variant of the CLOCK algorithm, after
+ * "CLOCK-Pro: An Effective Improvement of the CLOCK Replacement"
+ * (Jiang, Chen, Zhang, USENIX 2005). It only relies on the accessed flag
+ * of the page tables, so it does not need eviction tracking.
+ *
+ * Theory of Operation:
+ *
+ * - Resident pages are either hot or cold. Pages are cold when first seen
+ *   in a page frame, and only cold pages are ever evicted. A page accessed
+ *   once and never again, as with a sequential scan, thus stays cold and
+ *   is soon evicted, without displacing the hot pages.
+ *
+ * - A cold page which gets accessed is given a test period. If it is
+ *   accessed again during its test period, it becomes hot. Pages evicted
+ *   during their test period are remembered as non-resident pages: if one
+ *   of them is paged in again, it becomes hot right away.
+ *
+ * - The cold hand sweeps the page frames to find pages to evict, and the
+ *   hot hand sweeps them to turn hot pages which were not accessed since
+ *   its last pass into cold pages, and to end test periods.
+ *
+ * - The number of page frames set aside for cold pages adapts to the
+ *   workload: it grows when a page is accessed during its test period, as
+ *   a larger cold area would have kept it resident, and shrinks when a
+ *   test period ends without an access. The hot hand runs whenever there
+ *   are more hot pages than page frames left for them.
+ *
+ * Page frames do not report which page they are filled with, so the state
+ * of a page frame is reset when the virtual address of its page changes.
+ * Selecting a page to evict is O(N) in the worst case, like for NRU, and
+ * usually stops after a few page frames.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/sys/util.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#define NUM_FRAMES K_MEM_NUM_PAGE_FRAMES
+
+#if CONFIG_EVICTION_CLOCK_PRO_NONRESIDENT > 0
+#define NUM_NONRESIDENT CONFIG_EVICTION_CLOCK_PRO_NONRESIDENT
+#else
+#define NUM_NONRESIDENT NUM_FRAMES
+#endif
+
+/*
+ * The state of each page frame is the virtual address of its page, with
+ * the following flags in its low bits. All of this is only ever accessed
+ * with z_mm_lock held.
+ */
+#define PF_KNOWN BIT(0)
+#define PF_HOT   BIT(1)
+#define PF_TEST  BIT(2)
+#define PF_FLAGS (PF_KNOWN | PF_HOT | PF_TEST)
+
+BUILD_ASSERT(PF_FLAGS < CONFIG_MMU_PAGE_SIZE);
+
+static uintptr_t pf_state[NUM_FRAMES];
+
+/* Non-resident pages in their test period, oldest first from the cursor */
+static void *nonresident[NUM_NONRESIDENT];
+static uint32_t nonresident_next;
+
+static uint32_t hand_cold;
+static uint32_t hand_hot;
+static uint32_t last_victim = NUM_FRAMES;
+
+static uint32_t num_resident;
+static uint32_t num_hot;
+static uint32_t cold_target = 1U;
+
+static void cold_target_inc(void)
+{
+	if (cold_target < (NUM_FRAMES - 1U)) {
+		cold_target++;
+	}
+}
+
+static void cold_target_dec(void)
+{
+	if (cold_target > 1U) {
+		cold_target--;
+	}
+}
+
+static void nonresident_add(void *addr)
+{
+	if (nonresident[nonresident_next] != NULL) {
+		/* Oldest test period ends without the page being accessed */
+		cold_target_dec();
+	}
+
+	nonresident[nonresident_next] = addr;
+	nonresident_next = (nonresident_next + 1U) % NUM_NONRESIDENT;
+}
+
+static bool nonresident_take(void *addr)
+{
+	for (uint32_t i = 0; i < NUM_NONRESIDENT; i++) {
+		if (nonresident[i] == addr) {
+			nonresident[i] = NULL;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void pf_forget(uint32_t idx)
+{
+	if ((pf_state[idx] & PF_KNOWN) != 0U) {
+		num_resident--;
+		if ((pf_state[idx] & PF_HOT) != 0U) {
+			num_hot--;
+		}
+	}
+
+	pf_state[idx] = 0U;
+}
+
+static inline uintptr_t pf_flags_get(uint32_t idx, bool clear_accessed)
+{
+	struct k_mem_page_frame *pf = &k_mem_page_frames[idx];
+	uintptr_t flags = arch_page_info_get(k_mem_page_frame_to_virt(pf), NULL,
+					     clear_accessed);
+
+	/* Implies a mismatch with page frame ontology and page tables */
+	__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U, "non-present page");
+
+	return flags;
+}
+
+/*
+ * Bring the state of a page frame up to date with its page. Returns false
+ * if the page frame cannot be evicted.
+ */
+static bool pf_sync(uint32_t idx)
+{
+	struct k_mem_page_frame *pf = &k_mem_page_frames[idx];
+	uintptr_t va;
+
+	if (!k_mem_page_frame_is_evictable(pf)) {
+		pf_forget(idx);
+		return false;
+	}
+
+	va = (uintptr_t)k_mem_page_frame_to_virt(pf);
+	if ((pf_state[idx] & ~(uintptr_t)PF_FLAGS) == va &&
+	    (pf_state[idx] & PF_KNOWN) != 0U) {
+		return true;
+	}
+
+	/* A new page was loaded in this page frame, the access which loaded
+	 * it does not count.
+	 */
+	pf_forget(idx);
+	num_resident++;
+	(void)pf_flags_get(idx, true);
+
+	if (nonresident_take((void *)va)) {
+		/* Paged in again during its test period */
+		pf_state[idx] = va | PF_KNOWN | PF_HOT;
+		num_hot++;
+		cold_target_inc();
+	} else {
+		pf_state[idx] = va | PF_KNOWN | PF_TEST;
+	}
+
+	return true;
+}
+
+static inline uint32_t hot_target(void)
+{
+	return (num_resident > cold_target) ? (num_resident - cold_target) : 0U;
+}
+
+/*
+ * Run the hot hand until it turns a hot page into a cold one. Returns
+ * false if it found no hot page after two rounds.
+ */
+static bool hot_hand_run(void)
+{
+	for (uint32_t n = 0; n < (2U * NUM_FRAMES); n++) {
+		uint32_t idx = hand_hot;
+
+		hand_hot = (hand_hot + 1U) % NUM_FRAMES;
+
+		if (!pf_sync(idx)) {
+			continue;
+		}
+
+		if ((pf_state[idx] & PF_HOT) == 0U) {
+			if ((pf_state[idx] & PF_TEST) != 0U) {
+				/* Test period ends without the page being accessed again */
+				pf_state[idx] &= ~PF_TEST;
+				cold_target_dec();
+			}
+			continue;
+		}
+
+		if ((pf_flags_get(idx, true) & ARCH_DATA_PAGE_ACCESSED) == 0U) {
+			pf_state[idx] &= ~PF_HOT;
+			num_hot--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void hot_balance(void)
+{
+	while ((num_hot > hot_target()) && hot_hand_run()) {
+	}
+}
+
+struct k_mem_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	uint32_t idx = NUM_FRAMES;
+	uintptr_t flags = 0U;
+
+	/* The last victim page frame usually holds the page which faulted */
+	if (last_victim < NUM_FRAMES) {
+		(void)pf_sync(last_victim);
+		hot_balance();
+	}
+
+	/*
+	 * Each cold page is either evicted, turned hot or given a test period
+	 * when the cold hand first passes it, so this ends within a few rounds.
+	 */
+	for (uint32_t n = 0; n < (3U * NUM_FRAMES); n++) {
+		uint32_t cur = hand_cold;
+
+		hand_cold = (hand_cold + 1U) % NUM_FRAMES;
+
+		if (!pf_sync(cur) || ((pf_state[cur] & PF_HOT) != 0U)) {
+			continue;
+		}
+
+		/* Fall back to any cold page if all keep being accessed */
+		idx = cur;
+		flags = pf_flags_get(cur, true);
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) == 0U) {
+			break;
+		}
+
+		if ((pf_state[cur] & PF_TEST) != 0U) {
+			/* Accessed again during its test period */
+			pf_state[cur] = (pf_state[cur] & ~(uintptr_t)PF_TEST) | PF_HOT;
+			num_hot++;
+			cold_target_inc();
+			hot_balance();
+			idx = NUM_FRAMES;
+		} else {
+			pf_state[cur] |= PF_TEST;
+		}
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(idx < NUM_FRAMES, "no page to evict");
+
+	if ((pf_state[idx] & PF_TEST) != 0U) {
+		nonresident_add(k_mem_page_frame_to_virt(&k_mem_page_frames[idx]));
+	}
+
+	pf_forget(idx);
+	last_victim = idx;
+	*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0U;
+
+	return &k_mem_page_frames[idx];
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
+
+#ifdef CONFIG_EVICTION_TRACKING
+/*
+ * Empty functions defined here so that architectures unconditionally
+ * implement eviction tracking can still use this algorithm.
+ */
+
+void k_mem_paging_eviction_add(struct k_mem_page_frame *pf)
+{
+	ARG_UNUSED(pf);
+}
+
+void k_mem_paging_eviction_remove(struct k_mem_page_frame *pf)
+{
+	ARG_UNUSED(pf);
+}
+
+void k_mem_paging_eviction_accessed(uintptr_t phys)
+{
+	ARG_UNUSED(phys);
+}
+
+#endif /* CONFIG_EVICTION_TRACKING */
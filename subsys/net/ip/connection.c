@@ -56,10 +56,32 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+#if defined(CONFIG_NET_CONN_HASH_BUCKETS)
+#define CONN_HASH_BUCKETS CONFIG_NET_CONN_HASH_BUCKETS
+#else
+#define CONN_HASH_BUCKETS 0
+#endif
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
-static sys_slist_t conn_used;
+
+/* Connection handlers in use. The ones with a local UDP/TCP port are hashed
+ * by their ports, and the last list holds all the others.
+ */
+static sys_slist_t conn_used[CONN_HASH_BUCKETS + 1];
+
+#define CONN_UNHASHED (&conn_used[CONN_HASH_BUCKETS])
+
+/* Loop over the connection handlers of an array of list pointers */
+#define CONN_LISTS_FOR_EACH(_lists, _count, _i, _conn)			\
+	for (_i = 0; _i < (_count); _i++)				\
+		SYS_SLIST_FOR_EACH_CONTAINER(_lists[_i], _conn, node)
+
+/* Loop over all the connection handlers in use */
+#define CONN_USED_FOR_EACH(_i, _conn)					\
+	for (_i = 0; _i < ARRAY_SIZE(conn_used); _i++)			\
+		SYS_SLIST_FOR_EACH_CONTAINER(&conn_used[_i], _conn, node)
 
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
@@ -113,6 +135,62 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+/* Hash bucket of the given ports, in network byte order */
+static inline sys_slist_t *conn_bucket(uint16_t proto, uint16_t local_port,
+				       uint16_t remote_port)
+{
+#if CONN_HASH_BUCKETS > 0
+	uint32_t key = (((uint32_t)local_port << 16) | remote_port) ^ proto;
+
+	return &conn_used[((key * 0x9e3779b1U) >> 16) % CONN_HASH_BUCKETS];
+#else
+	ARG_UNUSED(proto);
+	ARG_UNUSED(local_port);
+	ARG_UNUSED(remote_port);
+
+	return CONN_UNHASHED;
+#endif
+}
+
+/* List holding a connection handler, from its current flags and ports */
+static sys_slist_t *conn_list_get(struct net_conn *conn)
+{
+	if (CONN_HASH_BUCKETS == 0 ||
+	    (conn->flags & NET_CONN_LOCAL_PORT_SPEC) == 0U ||
+	    (conn->family != NET_AF_INET && conn->family != NET_AF_INET6 &&
+	     conn->family != NET_AF_UNSPEC)) {
+		return CONN_UNHASHED;
+	}
+
+	return conn_bucket(conn->proto, net_sin(&conn->local_addr)->sin_port,
+			   (conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0U ?
+			   net_sin(&conn->remote_addr)->sin_port : 0U);
+}
+
+/*
+ * Lists which may hold a connection handler for the given ports, in network
+ * byte order: the bucket of both ports, the bucket of the local port alone
+ * and the unhashed list. Returns the number of lists.
+ */
+static int conn_lists_get(uint16_t proto, uint16_t local_port,
+			  uint16_t remote_port, sys_slist_t *lists[3])
+{
+	int count = 0;
+
+	if (CONN_HASH_BUCKETS > 0 && local_port != 0U) {
+		lists[count++] = conn_bucket(proto, local_port, remote_port);
+
+		if (remote_port != 0U &&
+		    conn_bucket(proto, local_port, 0U) != lists[0]) {
+			lists[count++] = conn_bucket(proto, local_port, 0U);
+		}
+	}
+
+	lists[count++] = CONN_UNHASHED;
+
+	return count;
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -137,7 +215,7 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
-	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_list_get(conn), &conn->node);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -159,12 +237,16 @@ static struct net_conn *conn_find_handler(struct net_if *iface,
 					  uint16_t local_port,
 					  bool reuseport_set)
 {
+	sys_slist_t *lists[3];
 	struct net_conn *conn;
-	struct net_conn *tmp;
+	int count;
+	int i;
+
+	count = conn_lists_get(proto, net_htons(local_port), net_htons(remote_port), lists);
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
+	CONN_LISTS_FOR_EACH(lists, count, i, conn) {
 		if (conn->proto != proto) {
 			continue;
 		}
@@ -462,7 +544,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
-	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_list_get(conn), &conn->node);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -491,12 +573,17 @@ int net_conn_update(struct net_conn_handle *handle,
 
 	net_conn_change_callback(conn, cb, user_data);
 
+	/* The ports decide which list holds the connection handler */
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	sys_slist_find_and_remove(conn_list_get(conn), &conn->node);
+
 	ret = net_conn_change_local(conn, local_addr, local_port);
-	if (ret < 0) {
-		return ret;
+	if (ret == 0) {
+		ret = net_conn_change_remote(conn, remote_addr, remote_port);
 	}
 
-	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	sys_slist_prepend(conn_list_get(conn), &conn->node);
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -641,6 +728,7 @@ void net_conn_packet_input(struct net_pkt *pkt, uint16_t proto, enum net_sock_ty
 {
 	struct net_sockaddr_ll *local;
 	struct net_conn *conn;
+	size_t i;
 
 	/* Only accept input with NET_AF_PACKET family. */
 	if (net_pkt_family(pkt) != NET_AF_PACKET) {
@@ -652,7 +740,7 @@ void net_conn_packet_input(struct net_pkt *pkt, uint16_t proto, enum net_sock_ty
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	CONN_USED_FOR_EACH(i, conn) {
 		if (!is_iface_matching(conn, pkt)) {
 			continue; /* wrong interface */
 		}
@@ -716,6 +804,7 @@ enum net_verdict net_conn_raw_ip_input(struct net_pkt *pkt,
 {
 	uint8_t pkt_family = net_pkt_family(pkt);
 	struct net_conn *conn;
+	size_t i;
 
 	if (pkt_family != NET_AF_INET && pkt_family != NET_AF_INET6) {
 		return NET_CONTINUE;
@@ -727,7 +816,7 @@ enum net_verdict net_conn_raw_ip_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	CONN_USED_FOR_EACH(i, conn) {
 		if (!is_iface_matching(conn, pkt)) {
 			continue; /* wrong interface */
 		}
@@ -779,6 +868,7 @@ enum net_verdict net_conn_can_input(struct net_pkt *pkt, uint8_t proto)
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
+	size_t i;
 
 	/* Only accept input with NET_AF_CAN family and NET_CAN_RAW protocol. */
 	if (net_pkt_family(pkt) != NET_AF_CAN || proto != NET_CAN_RAW) {
@@ -791,7 +881,7 @@ enum net_verdict net_conn_can_input(struct net_pkt *pkt, uint8_t proto)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	CONN_USED_FOR_EACH(i, conn) {
 		if (!is_iface_matching(conn, pkt)) {
 			continue; /* wrong interface */
 		}
@@ -892,6 +982,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
+	sys_slist_t *lists[3];
+	int count;
+	int i;
 
 	/* If we receive a packet with multicast destination address, we might
 	 * need to deliver the packet to multiple recipients.
@@ -907,9 +1000,12 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		is_mcast_pkt = net_ipv6_is_addr_mcast_raw(ip_hdr->ipv6->dst);
 	}
 
+	/* Only the handlers which may match the ports of the packet */
+	count = conn_lists_get(proto, dst_port, src_port, lists);
+
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	CONN_LISTS_FOR_EACH(lists, count, i, conn) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (!is_iface_matching(conn, pkt)) {
 			continue; /* wrong interface */
@@ -1075,10 +1171,11 @@ drop:
 void net_conn_foreach(net_conn_foreach_cb_t cb, void *user_data)
 {
 	struct net_conn *conn;
+	size_t i;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	CONN_USED_FOR_EACH(i, conn) {
 		cb(conn, user_data);
 	}
 
@@ -1090,7 +1187,10 @@ void net_conn_init(void)
 	int i;
 
 	sys_slist_init(&conn_unused);
-	sys_slist_init(&conn_used);
+
+	for (i = 0; i < ARRAY_SIZE(conn_used); i++) {
+		sys_slist_init(&conn_used[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
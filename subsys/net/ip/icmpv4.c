@@ -676,7 +676,6 @@ static int icmpv4_handle_dst_unreach(struct net_icmp_ctx *ctx,
 	struct net_icmpv4_dest_unreach *dest_unreach_hdr;
 	struct net_ipv4_hdr *ip_hdr = hdr->ipv4;
 	uint16_t length = net_pkt_get_len(pkt);
-	struct net_pmtu_entry *entry;
 	struct net_sockaddr_in sockaddr_src = {
 		.sin_family = NET_AF_INET,
 	};
@@ -720,8 +719,8 @@ static int icmpv4_handle_dst_unreach(struct net_icmp_ctx *ctx,
 
 	net_ipaddr_copy(&sockaddr_src.sin_addr, (struct net_in_addr *)&ip_hdr->src);
 
-	entry = net_pmtu_get_entry((struct net_sockaddr *)&sockaddr_src);
-	if (entry == NULL) {
+	ret = net_pmtu_get_mtu((struct net_sockaddr *)&sockaddr_src);
+	if (ret < 0) {
 		NET_DBG("DROP: Cannot find PMTU entry for %s",
 			net_sprint_ipv4_addr(&ip_hdr->src));
 		goto silent_drop;
@@ -730,15 +729,14 @@ static int icmpv4_handle_dst_unreach(struct net_icmp_ctx *ctx,
 	/* We must not accept larger PMTU value than what we already know.
 	 * RFC 1191 chapter 3 page 5.
 	 */
-	if (entry->mtu > 0 && entry->mtu < mtu) {
-		NET_DBG("DROP: PMTU for %s %u larger than %u",
-			net_sprint_ipv4_addr(&ip_hdr->src), mtu,
-			entry->mtu);
+	if (ret > 0 && ret < mtu) {
+		NET_DBG("DROP: PMTU for %s %u larger than %d",
+			net_sprint_ipv4_addr(&ip_hdr->src), mtu, ret);
 		goto silent_drop;
 	}
 
-	ret = net_pmtu_update_entry(entry, mtu);
-	if (ret > 0) {
+	ret = net_pmtu_update_mtu((struct net_sockaddr *)&sockaddr_src, mtu);
+	if (ret > 0 && ret != mtu) {
 		NET_DBG("PMTU for %s changed from %u to %u",
 			net_sprint_ipv4_addr(&ip_hdr->src), ret, mtu);
 	}
@@ -462,7 +462,6 @@ drop:
 enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4_PMTU)) {
-		struct net_pmtu_entry *entry;
 		struct net_sockaddr_in dst = {
 			.sin_family = NET_AF_INET,
 		};
@@ -470,8 +469,7 @@ enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
 
 		net_ipv4_addr_copy_raw((uint8_t *)&dst.sin_addr,
 				       NET_IPV4_HDR(pkt)->dst);
-		entry = net_pmtu_get_entry((struct net_sockaddr *)&dst);
-		if (entry == NULL) {
+		if (net_pmtu_get_mtu((struct net_sockaddr *)&dst) < 0) {
 			ret = net_pmtu_update_mtu((struct net_sockaddr *)&dst,
 						  net_if_get_mtu(net_pkt_iface(pkt)));
 			if (ret < 0) {
@@ -483,6 +481,11 @@ enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
 	}
 
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
+	/* TCP cuts the packet into segments which fit the MTU */
+	if (net_pkt_gso_size(pkt) > 0U) {
+		return NET_OK;
+	}
+
 	return net_ipv4_prepare_for_send_fragment(pkt);
 #else
 	return NET_OK;
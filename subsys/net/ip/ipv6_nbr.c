@@ -855,9 +855,11 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	/* If we have already fragmented the packet, the fragment id will
-	 * contain a proper value and we can skip other checks.
+	 * contain a proper value and we can skip other checks. Packets
+	 * holding several TCP segments are cut into segments which fit the
+	 * MTU instead.
 	 */
-	if (net_pkt_ipv6_fragment_id(pkt) == 0U) {
+	if (net_pkt_ipv6_fragment_id(pkt) == 0U && net_pkt_gso_size(pkt) == 0U) {
 		size_t pkt_len = net_pkt_get_len(pkt);
 		uint16_t mtu;
 
@@ -970,15 +972,13 @@ use_interface_mtu:
 
 try_send:
 	if (IS_ENABLED(CONFIG_NET_IPV6_PMTU)) {
-		struct net_pmtu_entry *entry;
 		struct net_sockaddr_in6 dst = {
 			.sin6_family = NET_AF_INET6,
 		};
 
 		net_ipaddr_copy(&dst.sin6_addr, (struct net_in6_addr *)ip_hdr->dst);
 
-		entry = net_pmtu_get_entry((struct net_sockaddr *)&dst);
-		if (entry == NULL) {
+		if (net_pmtu_get_mtu((struct net_sockaddr *)&dst) < 0) {
 			ret = net_pmtu_update_mtu((struct net_sockaddr *)&dst,
 						  net_if_get_mtu(iface));
 			if (ret < 0) {
@@ -2871,7 +2871,6 @@ static int handle_ptb_input(struct net_icmp_ctx *ctx,
 	struct net_sockaddr_in6 sockaddr_src = {
 		.sin6_family = NET_AF_INET6,
 	};
-	struct net_pmtu_entry *entry;
 	uint32_t mtu;
 	int ret;
 
@@ -2909,8 +2908,8 @@ static int handle_ptb_input(struct net_icmp_ctx *ctx,
 
 	net_ipaddr_copy(&sockaddr_src.sin6_addr, (struct net_in6_addr *)&ip_hdr->src);
 
-	entry = net_pmtu_get_entry((struct net_sockaddr *)&sockaddr_src);
-	if (entry == NULL) {
+	ret = net_pmtu_get_mtu((struct net_sockaddr *)&sockaddr_src);
+	if (ret < 0) {
 		NET_DBG("DROP: Cannot find PMTU entry for %s",
 			net_sprint_ipv6_addr(&ip_hdr->src));
 		goto silent_drop;
@@ -2919,15 +2918,14 @@ static int handle_ptb_input(struct net_icmp_ctx *ctx,
 	/* We must not accept larger PMTU value than what we already know.
 	 * RFC 8201 chapter 4 page 8.
 	 */
-	if (entry->mtu > 0 && entry->mtu < mtu) {
-		NET_DBG("DROP: PMTU for %s %u larger than %u",
-			net_sprint_ipv6_addr(&ip_hdr->src), mtu,
-			entry->mtu);
+	if (ret > 0 && ret < mtu) {
+		NET_DBG("DROP: PMTU for %s %u larger than %d",
+			net_sprint_ipv6_addr(&ip_hdr->src), mtu, ret);
 		goto silent_drop;
 	}
 
-	ret = net_pmtu_update_entry(entry, mtu);
-	if (ret > 0) {
+	ret = net_pmtu_update_mtu((struct net_sockaddr *)&sockaddr_src, mtu);
+	if (ret > 0 && ret != mtu) {
 		NET_DBG("PMTU for %s changed from %u to %u",
 			net_sprint_ipv6_addr(&ip_hdr->src), ret, mtu);
 	}
@@ -1300,14 +1300,12 @@ int net_context_create_ipv4_new(struct net_context *context,
 #endif
 
 	if (IS_ENABLED(CONFIG_NET_IPV4_PMTU)) {
-		struct net_pmtu_entry *entry;
 		struct net_sockaddr_in dst_addr = {
 			.sin_family = NET_AF_INET,
 			.sin_addr = *dst,
 		};
 
-		entry = net_pmtu_get_entry((struct net_sockaddr *)&dst_addr);
-		if (entry == NULL) {
+		if (net_pmtu_get_mtu((struct net_sockaddr *)&dst_addr) < 0) {
 			/* Try to figure out the MTU of the path */
 			net_pkt_set_ipv4_pmtu(pkt, true);
 		} else {
@@ -2202,6 +2200,13 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
+	/* Sum the payload while it is copied, for the UDP checksum */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt),
+					 family == NET_AF_INET6 ? NET_IF_CHECKSUM_IPV6_UDP
+								: NET_IF_CHECKSUM_IPV4_UDP)) {
+		net_pkt_chksum_acc_start(pkt);
+	}
+
 	ret = context_write_data(pkt, buf, len, msg);
 	if (ret) {
 		return ret;
@@ -106,6 +106,11 @@ static inline enum net_verdict process_data(struct net_pkt *pkt)
 		net_packet_socket_input(pkt, net_pkt_ll_proto_type(pkt), NET_SOCK_DGRAM);
 	}
 
+	/* In-order TCP segments are merged before the IP input */
+	if (net_tcp_gro_receive(pkt) == NET_OK) {
+		return NET_OK;
+	}
+
 	uint8_t family = net_pkt_family(pkt);
 
 	if (IS_ENABLED(CONFIG_NET_IP) && (family == NET_AF_INET || family == NET_AF_INET6 ||
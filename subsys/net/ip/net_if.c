@@ -212,6 +212,27 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+/* TCP packets holding several segments are cut into the segments here,
+ * unless the device does it.
+ */
+static bool need_tx_segmentation(struct net_if *iface, struct net_pkt *pkt)
+{
+	if (!IS_ENABLED(CONFIG_NET_TCP_GSO) || net_pkt_gso_size(pkt) == 0U) {
+		return false;
+	}
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	    (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO)) {
+		return false;
+	}
+#else
+	ARG_UNUSED(iface);
+#endif
+
+	return true;
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = { 0 };
@@ -258,7 +279,11 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 
 		net_if_tx_lock(iface);
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (need_tx_segmentation(iface, pkt)) {
+			status = net_tcp_gso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 		net_if_tx_unlock(iface);
 		if (status < 0) {
 			NET_WARN_RATELIMIT("iface %d pkt %p send failure status %d",
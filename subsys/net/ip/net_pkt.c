@@ -754,6 +754,10 @@ void net_pkt_frag_add(struct net_pkt *pkt, struct net_buf *frag)
 	/* We do not use net_buf_frag_add() as this one will refcount
 	 * the frag once more if !pkt->frags
 	 */
+	if (net_pkt_chksum_acc_is_on(pkt) && net_buf_frags_len(frag) > 0U) {
+		net_pkt_chksum_acc_stop(pkt);
+	}
+
 	if (!pkt->frags) {
 		pkt->frags = frag;
 		return;
@@ -1230,6 +1234,8 @@ int net_pkt_remove_tail(struct net_pkt *pkt, size_t length)
 		return -EINVAL;
 	}
 
+	net_pkt_chksum_acc_stop(pkt);
+
 	remaining_len -= length;
 
 	while (buf) {
@@ -1755,6 +1761,10 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer(struct net_if *iface,
 
 void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer)
 {
+	if (net_pkt_chksum_acc_is_on(pkt) && net_buf_frags_len(buffer) > 0U) {
+		net_pkt_chksum_acc_stop(pkt);
+	}
+
 	if (!pkt->buffer) {
 		pkt->buffer = buffer;
 		net_pkt_cursor_init(pkt);
@@ -1831,6 +1841,48 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_PKT_CHKSUM_ACCUMULATE)
+/* Sum the length bytes at the cursor, which are being appended to the packet */
+static void pkt_chksum_acc_update(struct net_pkt *pkt, size_t length)
+{
+	struct net_pkt_cursor *cursor = &pkt->cursor;
+	struct net_buf *buf;
+	uint16_t part;
+
+	if (!pkt->chksum_acc_on) {
+		return;
+	}
+
+	if (cursor->pos != cursor->buf->data + cursor->buf->len ||
+	    (size_t)pkt->chksum_acc_len + length > UINT16_MAX) {
+		pkt->chksum_acc_on = 0U;
+		return;
+	}
+
+	/* Only the trailing data is accumulated */
+	for (buf = cursor->buf->frags; buf; buf = buf->frags) {
+		if (buf->len) {
+			pkt->chksum_acc_on = 0U;
+			return;
+		}
+	}
+
+	part = calc_chksum(0, cursor->pos, length);
+	if (pkt->chksum_acc_len & 1U) {
+		part = BSWAP_16(part);
+	}
+
+	pkt->chksum_acc = net_chksum_add(pkt->chksum_acc, part);
+	pkt->chksum_acc_len += length;
+}
+#else
+static inline void pkt_chksum_acc_update(struct net_pkt *pkt, size_t length)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(length);
+}
+#endif
+
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
@@ -1874,6 +1926,7 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 		}
 
 		if (write && !net_pkt_is_being_overwritten(pkt)) {
+			pkt_chksum_acc_update(pkt, len);
 			net_buf_add(c_op->buf, len);
 		}
 
@@ -1999,6 +2052,7 @@ int net_pkt_copy(struct net_pkt *pkt_dst,
 		memcpy(c_dst->pos, c_src->pos, len);
 
 		if (!net_pkt_is_being_overwritten(pkt_dst)) {
+			pkt_chksum_acc_update(pkt_dst, len);
 			net_buf_add(c_dst->buf, len);
 		}
 
@@ -2057,6 +2111,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 #if defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_L2_IPIP)
 	net_pkt_set_remote_address(clone_pkt, net_pkt_remote_address(pkt),
@@ -2202,6 +2257,8 @@ int net_pkt_update_length(struct net_pkt *pkt, size_t length)
 {
 	struct net_buf *buf;
 
+	net_pkt_chksum_acc_stop(pkt);
+
 	for (buf = pkt->buffer; buf; buf = buf->frags) {
 		if (buf->len < length) {
 			length -= buf->len;
@@ -2218,6 +2275,8 @@ int net_pkt_pull(struct net_pkt *pkt, size_t length)
 {
 	struct net_pkt_cursor *c_op = &pkt->cursor;
 
+	net_pkt_chksum_acc_stop(pkt);
+
 	while (length) {
 		size_t left, rem;
 
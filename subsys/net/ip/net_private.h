@@ -211,6 +211,8 @@ enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
 extern enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
 extern int net_tc_tx_thread_priority(int tc);
 extern int net_tc_rx_thread_priority(int tc);
+/* Traffic class of the calling RX thread, -1 if not called from one */
+extern int net_tc_rx_current(void);
 static inline bool net_tc_tx_is_immediate(int tc, int prio)
 {
 	ARG_UNUSED(prio);
@@ -302,6 +304,26 @@ extern char *net_byte_to_hex(char *ptr, uint8_t byte, char base, bool pad);
 extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
+
+/* Options of the threads computing checksums, calc_chksum() may use the
+ * SIMD registers.
+ */
+#if defined(CONFIG_NET_CHKSUM_SIMD) && defined(CONFIG_X86_SSE)
+#define NET_CHKSUM_THREAD_OPTIONS (K_FP_REGS | K_SSE_REGS)
+#elif defined(CONFIG_NET_CHKSUM_SIMD)
+#define NET_CHKSUM_THREAD_OPTIONS K_FP_REGS
+#else
+#define NET_CHKSUM_THREAD_OPTIONS 0
+#endif
+
+/* One's complement addition of two partial Internet checksums */
+static inline uint16_t net_chksum_add(uint16_t sum, uint16_t part)
+{
+	sum += part;
+
+	return (sum < part) ? sum + 1U : sum;
+}
+
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
 /**
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 #define NET_TC_RX_SLOTS (CONFIG_NET_PKT_RX_COUNT / NET_TC_RX_EFFECTIVE_COUNT)
@@ -202,6 +203,21 @@ int net_tc_rx_thread_priority(int tc)
 	return priority;
 }
 
+int net_tc_rx_current(void)
+{
+#if NET_TC_RX_COUNT > 0
+	k_tid_t current = k_current_get();
+
+	for (int i = 0; i < NET_TC_RX_COUNT; i++) {
+		if (current == &rx_classes[i].handler) {
+			return i;
+		}
+	}
+#endif
+
+	return -1;
+}
+
 
 #if defined(CONFIG_NET_STATISTICS)
 /* Fixup the traffic class statistics so that "net stats" shell command will
@@ -255,13 +271,17 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(void *p1, void *p2, void *p3)
 {
-	ARG_UNUSED(p3);
-
 	struct k_fifo *fifo = p1;
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 	struct k_sem *fifo_slot = p2;
 #else
 	ARG_UNUSED(p2);
+#endif
+#if defined(CONFIG_NET_TCP_GRO)
+	int tc = POINTER_TO_INT(p3);
+	int budget = CONFIG_NET_TCP_GRO_BUDGET;
+#else
+	ARG_UNUSED(p3);
 #endif
 	struct net_pkt *pkt;
 
@@ -276,6 +296,17 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 #endif
 
 		net_process_rx_packet(pkt);
+
+#if defined(CONFIG_NET_TCP_GRO)
+		/* Segments are merged only with the ones already queued, and
+		 * held for a bounded number of packets while the queue stays
+		 * busy.
+		 */
+		if (k_fifo_is_empty(fifo) || --budget == 0) {
+			net_tcp_gro_flush(tc);
+			budget = CONFIG_NET_TCP_GRO_BUDGET;
+		}
+#endif
 	}
 }
 #endif
@@ -349,8 +380,8 @@ void net_tc_tx_init(void)
 #else
 				      NULL,
 #endif
-				      NULL,
-				      priority, 0, K_FOREVER);
+				      INT_TO_POINTER(i),
+				      priority, NET_CHKSUM_THREAD_OPTIONS, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
 			continue;
@@ -407,8 +438,8 @@ void net_tc_rx_init(void)
 #else
 				      NULL,
 #endif
-				      NULL,
-				      priority, 0, K_FOREVER);
+				      INT_TO_POINTER(i),
+				      priority, NET_CHKSUM_THREAD_OPTIONS, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
 			continue;
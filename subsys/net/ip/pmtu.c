@@ -12,6 +12,7 @@
 LOG_MODULE_REGISTER(net_pmtu, CONFIG_NET_PMTU_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
+#include <zephyr/kernel/rcu.h>
 #include <zephyr/net/net_mgmt.h>
 #include <zephyr/net/net_if.h>
 #include "pmtu.h"
@@ -30,77 +31,173 @@ LOG_MODULE_REGISTER(net_pmtu, CONFIG_NET_PMTU_LOG_LEVEL);
 
 #define NET_PMTU_MAX_ENTRIES (NET_IPV4_PMTU_ENTRIES + NET_IPV6_PMTU_ENTRIES)
 
-static struct net_pmtu_entry pmtu_entries[NET_PMTU_MAX_ENTRIES];
+/* With RCU, one spare entry lets the oldest entry be replaced while
+ * readers may still be looking at it.
+ */
+#if defined(CONFIG_NET_PMTU_RCU)
+#define NET_PMTU_SPARE_ENTRIES 1
+#else
+#define NET_PMTU_SPARE_ENTRIES 0
+#endif
+
+static struct net_pmtu_entry pmtu_entries[NET_PMTU_MAX_ENTRIES + NET_PMTU_SPARE_ENTRIES];
 
+/* Entries in use, published to the readers */
+static struct net_pmtu_entry *pmtu_table[NET_PMTU_MAX_ENTRIES];
+
+/* Serializes updates of the table and of the entries, and the readers
+ * without RCU.
+ */
 static K_MUTEX_DEFINE(lock);
 
-static struct net_pmtu_entry *get_pmtu_entry(const struct net_sockaddr *dst)
+void net_pmtu_read_lock(void)
 {
-	struct net_pmtu_entry *entry = NULL;
-	int i;
+#if defined(CONFIG_NET_PMTU_RCU)
+	k_rcu_read_lock();
+#else
+	(void)k_mutex_lock(&lock, K_FOREVER);
+#endif
+}
 
-	k_mutex_lock(&lock, K_FOREVER);
+void net_pmtu_read_unlock(void)
+{
+#if defined(CONFIG_NET_PMTU_RCU)
+	k_rcu_read_unlock();
+#else
+	(void)k_mutex_unlock(&lock);
+#endif
+}
 
-	for (i = 0; i < ARRAY_SIZE(pmtu_entries); i++) {
-		switch (dst->sa_family) {
-		case NET_AF_INET:
-			if (IS_ENABLED(CONFIG_NET_IPV4_PMTU) &&
-			    pmtu_entries[i].dst.family == NET_AF_INET &&
-			    net_ipv4_addr_cmp(&pmtu_entries[i].dst.in_addr,
-					      &net_sin(dst)->sin_addr)) {
-				entry = &pmtu_entries[i];
-				goto out;
-			}
-			break;
+static bool pmtu_entry_match(const struct net_pmtu_entry *entry,
+			     const struct net_sockaddr *dst)
+{
+	switch (dst->sa_family) {
+	case NET_AF_INET:
+		return IS_ENABLED(CONFIG_NET_IPV4_PMTU) &&
+		       entry->dst.family == NET_AF_INET &&
+		       net_ipv4_addr_cmp(&entry->dst.in_addr, &net_sin(dst)->sin_addr);
 
-		case NET_AF_INET6:
-			if (IS_ENABLED(CONFIG_NET_IPV6_PMTU) &&
-			    pmtu_entries[i].dst.family == NET_AF_INET6 &&
-			    net_ipv6_addr_cmp(&pmtu_entries[i].dst.in6_addr,
-					      &net_sin6(dst)->sin6_addr)) {
-				entry = &pmtu_entries[i];
-				goto out;
-			}
-			break;
+	case NET_AF_INET6:
+		return IS_ENABLED(CONFIG_NET_IPV6_PMTU) &&
+		       entry->dst.family == NET_AF_INET6 &&
+		       net_ipv6_addr_cmp(&entry->dst.in6_addr, &net_sin6(dst)->sin6_addr);
 
-		default:
-			break;
+	default:
+		return false;
+	}
+}
+
+/* Must be called with the read lock or the lock held */
+static struct net_pmtu_entry *get_pmtu_entry(const struct net_sockaddr *dst)
+{
+	struct net_pmtu_entry *entry;
+
+	ARRAY_FOR_EACH(pmtu_table, i) {
+		entry = k_rcu_dereference(pmtu_table[i]);
+		if (entry != NULL && pmtu_entry_match(entry, dst)) {
+			return entry;
 		}
 	}
 
-out:
+	return NULL;
+}
+
+#if defined(CONFIG_NET_PMTU_RCU)
+/* Runs once no reader can be looking at a retired entry anymore */
+static void pmtu_entry_free(struct k_rcu_head *head)
+{
+	struct net_pmtu_entry *entry = CONTAINER_OF(head, struct net_pmtu_entry, rcu);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	entry->in_use = false;
 	k_mutex_unlock(&lock);
+}
+#endif /* CONFIG_NET_PMTU_RCU */
 
-	return entry;
+/* Must be called with the lock held, once the entry is unpublished */
+static void retire_pmtu_entry(struct net_pmtu_entry *entry)
+{
+#if defined(CONFIG_NET_PMTU_RCU)
+	/* Readers may still be looking at the entry */
+	k_rcu_call(&entry->rcu, pmtu_entry_free);
+#else
+	entry->in_use = false;
+#endif
 }
 
-static struct net_pmtu_entry *get_free_pmtu_entry(void)
+/* Must be called with the lock held. Waits until no reader can be looking
+ * at an entry unpublished before.
+ */
+static void wait_pmtu_readers(void)
+{
+#if defined(CONFIG_NET_PMTU_RCU)
+	k_rcu_synchronize();
+#endif
+}
+
+/* Must be called with the lock held. Returns the table slot to publish the
+ * new entry in, which holds the oldest entry if the table is full.
+ */
+static int get_free_pmtu_entry(struct net_pmtu_entry **new_entry)
 {
 	struct net_pmtu_entry *entry = NULL;
 	uint32_t oldest = 0U;
-	int i;
+	int slot = -ENOMEM;
 
-	k_mutex_lock(&lock, K_FOREVER);
+	ARRAY_FOR_EACH(pmtu_table, i) {
+		if (pmtu_table[i] == NULL) {
+			slot = i;
+			break;
+		}
 
-	for (i = 0; i < ARRAY_SIZE(pmtu_entries); i++) {
-		if (!pmtu_entries[i].in_use) {
-			pmtu_entries[i].in_use = true;
-			pmtu_entries[i].last_update = k_uptime_get_32();
+		if (oldest == 0U || pmtu_table[i]->last_update < oldest) {
+			oldest = pmtu_table[i]->last_update;
+			slot = i;
+		}
+	}
 
+	if (slot < 0) {
+		return -ENOMEM;
+	}
+
+	ARRAY_FOR_EACH(pmtu_entries, i) {
+		if (!pmtu_entries[i].in_use) {
 			entry = &pmtu_entries[i];
-			goto out;
+			break;
 		}
+	}
 
-		if (oldest == 0U || pmtu_entries[i].last_update < oldest) {
-			oldest = pmtu_entries[i].last_update;
-			entry = &pmtu_entries[i];
+	if (entry == NULL) {
+		/* The replaced entries still wait for their readers. Recycle
+		 * the oldest entry in place once no reader can see it, as
+		 * the PMTU information would be lost otherwise.
+		 */
+		entry = pmtu_table[slot];
+		if (entry == NULL) {
+			return -ENOMEM;
 		}
+
+		k_rcu_assign_pointer(pmtu_table[slot], NULL);
+		wait_pmtu_readers();
 	}
 
-out:
-	k_mutex_unlock(&lock);
+	entry->in_use = true;
+	entry->last_update = k_uptime_get_32();
+	*new_entry = entry;
 
-	return entry;
+	return slot;
+}
+
+/* Must be called with the lock held */
+static void publish_pmtu_entry(int slot, struct net_pmtu_entry *entry)
+{
+	struct net_pmtu_entry *old = pmtu_table[slot];
+
+	k_rcu_assign_pointer(pmtu_table[slot], entry);
+
+	if (old != NULL) {
+		retire_pmtu_entry(old);
+	}
 }
 
 static void update_pmtu_entry(struct net_pmtu_entry *entry, uint16_t mtu)
@@ -148,28 +245,31 @@ static void update_pmtu_entry(struct net_pmtu_entry *entry, uint16_t mtu)
 
 struct net_pmtu_entry *net_pmtu_get_entry(const struct net_sockaddr *dst)
 {
-	struct net_pmtu_entry *entry;
-
-	entry = get_pmtu_entry(dst);
-
-	return entry;
+	return get_pmtu_entry(dst);
 }
 
 int net_pmtu_get_mtu(const struct net_sockaddr *dst)
 {
 	struct net_pmtu_entry *entry;
+	int ret = -ENOENT;
+
+	net_pmtu_read_lock();
 
 	entry = get_pmtu_entry(dst);
-	if (entry == NULL) {
-		return -ENOENT;
+	if (entry != NULL) {
+		ret = entry->mtu;
 	}
 
-	return entry->mtu;
+	net_pmtu_read_unlock();
+
+	return ret;
 }
 
+/* Must be called with the lock held */
 static struct net_pmtu_entry *add_entry(const struct net_sockaddr *dst, bool *old_entry)
 {
 	struct net_pmtu_entry *entry;
+	int slot;
 
 	entry = get_pmtu_entry(dst);
 	if (entry != NULL) {
@@ -177,21 +277,18 @@ static struct net_pmtu_entry *add_entry(const struct net_sockaddr *dst, bool *ol
 		return entry;
 	}
 
-	entry = get_free_pmtu_entry();
-	if (entry == NULL) {
+	slot = get_free_pmtu_entry(&entry);
+	if (slot < 0) {
 		return NULL;
 	}
 
-	k_mutex_lock(&lock, K_FOREVER);
-
 	switch (dst->sa_family) {
 	case NET_AF_INET:
 		if (IS_ENABLED(CONFIG_NET_IPV4_PMTU)) {
 			entry->dst.family = NET_AF_INET;
 			net_ipaddr_copy(&entry->dst.in_addr, &net_sin(dst)->sin_addr);
 		} else {
-			entry->in_use = false;
-			goto unlock_fail;
+			goto fail;
 		}
 		break;
 
@@ -200,23 +297,23 @@ static struct net_pmtu_entry *add_entry(const struct net_sockaddr *dst, bool *ol
 			entry->dst.family = NET_AF_INET6;
 			net_ipaddr_copy(&entry->dst.in6_addr, &net_sin6(dst)->sin6_addr);
 		} else {
-			entry->in_use = false;
-			goto unlock_fail;
+			goto fail;
 		}
 		break;
 
 	default:
-		entry->in_use = false;
-		goto unlock_fail;
+		goto fail;
 	}
 
-	k_mutex_unlock(&lock);
+	entry->mtu = 0U;
+	publish_pmtu_entry(slot, entry);
+
 	return entry;
 
-unlock_fail:
+fail:
+	entry->in_use = false;
 	*old_entry = false;
 
-	k_mutex_unlock(&lock);
 	return NULL;
 }
 
@@ -225,10 +322,14 @@ int net_pmtu_update_mtu(const struct net_sockaddr *dst, uint16_t mtu)
 	struct net_pmtu_entry *entry;
 	uint16_t old_mtu = 0U;
 	bool updated = false;
+	int ret;
+
+	k_mutex_lock(&lock, K_FOREVER);
 
 	entry = add_entry(dst, &updated);
 	if (entry == NULL) {
-		return -ENOMEM;
+		ret = -ENOMEM;
+		goto out;
 	}
 
 	if (updated) {
@@ -236,27 +337,12 @@ int net_pmtu_update_mtu(const struct net_sockaddr *dst, uint16_t mtu)
 	}
 
 	update_pmtu_entry(entry, mtu);
+	ret = (int)old_mtu;
 
-	return (int)old_mtu;
-}
-
-int net_pmtu_update_entry(struct net_pmtu_entry *entry, uint16_t mtu)
-{
-	uint16_t old_mtu;
-
-	if (entry == NULL) {
-		return -EINVAL;
-	}
-
-	if (entry->mtu == mtu) {
-		return -EALREADY;
-	}
-
-	old_mtu = entry->mtu;
-
-	update_pmtu_entry(entry, mtu);
+out:
+	k_mutex_unlock(&lock);
 
-	return (int)old_mtu;
+	return ret;
 }
 
 int net_pmtu_foreach(net_pmtu_cb_t cb, void *user_data)
@@ -265,9 +351,12 @@ int net_pmtu_foreach(net_pmtu_cb_t cb, void *user_data)
 
 	k_mutex_lock(&lock, K_FOREVER);
 
-	ARRAY_FOR_EACH(pmtu_entries, i) {
-		ret++;
-		cb(&pmtu_entries[i], user_data);
+	/* Retired entries may still be in use, but are no longer cached */
+	ARRAY_FOR_EACH(pmtu_table, i) {
+		if (pmtu_table[i] != NULL) {
+			ret++;
+			cb(pmtu_table[i], user_data);
+		}
 	}
 
 	k_mutex_unlock(&lock);
@@ -279,8 +368,13 @@ void net_pmtu_init(void)
 {
 	k_mutex_lock(&lock, K_FOREVER);
 
-	ARRAY_FOR_EACH(pmtu_entries, i) {
-		pmtu_entries[i].in_use = false;
+	ARRAY_FOR_EACH(pmtu_table, i) {
+		struct net_pmtu_entry *entry = pmtu_table[i];
+
+		if (entry != NULL) {
+			pmtu_table[i] = NULL;
+			retire_pmtu_entry(entry);
+		}
 	}
 
 	k_mutex_unlock(&lock);
@@ -10,6 +10,7 @@
 #ifndef __NET_PMTU_H
 #define __NET_PMTU_H
 
+#include <zephyr/kernel/rcu.h>
 #include <zephyr/net/net_ip.h>
 
 #ifdef __cplusplus
@@ -26,9 +27,40 @@ struct net_pmtu_entry {
 	uint16_t mtu;
 	/** In use flag */
 	bool in_use : 1;
+#if defined(CONFIG_NET_PMTU_RCU)
+	/** Frees the entry once it has been replaced and no reader is left */
+	struct k_rcu_head rcu;
+#endif
 };
 
+/** Enter a section within which PMTU entries are not reclaimed
+ *
+ * This is an RCU read-side critical section with CONFIG_NET_PMTU_RCU, and
+ * takes the PMTU cache mutex otherwise.
+ */
+#if defined(CONFIG_NET_PMTU)
+void net_pmtu_read_lock(void);
+#else
+static inline void net_pmtu_read_lock(void)
+{
+}
+#endif /* CONFIG_NET_PMTU */
+
+/** Leave a section entered with net_pmtu_read_lock() */
+#if defined(CONFIG_NET_PMTU)
+void net_pmtu_read_unlock(void);
+#else
+static inline void net_pmtu_read_unlock(void)
+{
+}
+#endif /* CONFIG_NET_PMTU */
+
 /** Get PMTU entry for the given destination address
+ *
+ * Must be called between net_pmtu_read_lock() and net_pmtu_read_unlock().
+ * The entry may be replaced at any time, and must not be used after
+ * net_pmtu_read_unlock(). Use net_pmtu_get_mtu() to read the MTU without
+ * holding the read lock.
  *
  * @param dst Destination address
  *
@@ -81,26 +113,6 @@ static inline int net_pmtu_update_mtu(const struct net_sockaddr *dst, uint16_t m
 }
 #endif /* CONFIG_NET_PMTU */
 
-/** Update PMTU entry for the given destination address
- *
- * @param entry PMTU entry
- * @param mtu New MTU value
- *
- * @return >0 previous MTU, <0 if error
- */
-#if defined(CONFIG_NET_PMTU)
-int net_pmtu_update_entry(struct net_pmtu_entry *entry, uint16_t mtu);
-#else
-static inline int net_pmtu_update_entry(struct net_pmtu_entry *entry,
-					uint16_t mtu)
-{
-	ARG_UNUSED(entry);
-	ARG_UNUSED(mtu);
-
-	return -ENOTSUP;
-}
-#endif /* CONFIG_NET_PMTU */
-
 /**
  * @typedef net_pmtu_cb_t
  * @brief Callback used when traversing PMTU destination cache.
@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L /* For strnlen() */
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 
@@ -66,8 +69,19 @@ static int tcp_tx_window =
 #endif
 
 /* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+#define TCP_CONGESTION_INITIAL_WIN CONFIG_NET_TCP_CONGESTION_INITIAL_WINDOW
+/* Upper bound of the initial window in bytes, RFC 6928 ch 2 */
+#define TCP_CONGESTION_INITIAL_WIN_BYTES 14600U
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CONGESTION_DEFAULT "cubic"
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+#define TCP_CONGESTION_DEFAULT "bbr"
+#else
+#define TCP_CONGESTION_DEFAULT "newreno"
+#endif
+#endif
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
@@ -499,96 +513,167 @@ static void tcp_derive_rto(struct tcp *conn)
 
 static void tcp_new_reno_log(struct tcp *conn, char *step)
 {
-	NET_DBG("[%p] ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
+	NET_DBG("[%p] ca %s, cwnd=%u, ssthres=%u, fast_pend=%u",
 		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
 		conn->ca.pending_fast_retransmit_bytes);
 }
 
 static void tcp_new_reno_init(struct tcp *conn)
 {
-	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
-	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
-	conn->ca.pending_fast_retransmit_bytes = 0;
 	tcp_new_reno_log(conn, "init");
 }
 
-static void tcp_new_reno_fast_retransmit(struct tcp *conn)
+static void tcp_new_reno_on_loss(struct tcp *conn)
 {
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
-		/* Account for the lost segments */
-		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
-		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
-	}
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
+	tcp_new_reno_log(conn, "fast_retransmit");
 }
 
-static void tcp_new_reno_timeout(struct tcp *conn)
+static void tcp_new_reno_on_rto(struct tcp *conn)
 {
 	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
 	conn->ca.cwnd = conn_mss(conn);
 	tcp_new_reno_log(conn, "timeout");
 }
 
-/* For every duplicate ack increment the cwnd by mss */
-static void tcp_new_reno_dup_ack(struct tcp *conn)
+static void tcp_new_reno_on_ack(struct tcp *conn, uint32_t acked_len)
 {
-	int32_t new_win = conn->ca.cwnd;
+	uint32_t new_win = conn->ca.cwnd;
+	uint32_t win_inc = MIN(acked_len, conn_mss(conn));
 
-	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		new_win += win_inc;
+	} else {
+		/* Implement a div_ceil	to avoid rounding to 0 */
+		new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
+	}
+	conn->ca.cwnd = MIN(new_win, TCP_WINDOW_MAX);
+	tcp_new_reno_log(conn, "pkts_acked");
 }
 
-static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
-{
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+TCP_CONGESTION_DEFINE(new_reno, "newreno", tcp_new_reno_init, tcp_new_reno_on_ack,
+		      tcp_new_reno_on_loss, tcp_new_reno_on_rto);
 
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		if (conn->ca.cwnd < conn->ca.ssthresh) {
-			new_win += win_inc;
-		} else {
-			/* Implement a div_ceil	to avoid rounding to 0 */
-			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
-		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	} else {
-		/* Check if it is still in fast recovery mode */
-		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
-			conn->ca.pending_fast_retransmit_bytes = 0;
-			conn->ca.cwnd = conn->ca.ssthresh;
-		} else {
-			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
+static const struct tcp_congestion_ops *tcp_ca_find(const char *name, size_t len)
+{
+	STRUCT_SECTION_FOREACH(tcp_congestion_ops, ops) {
+		if (strlen(ops->name) == len && strncmp(ops->name, name, len) == 0) {
+			return ops;
 		}
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
+
+	return NULL;
 }
 
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	uint32_t mss = conn_mss(conn);
+
+	conn->ca.cwnd = MIN(mss * TCP_CONGESTION_INITIAL_WIN,
+			    MAX(2 * mss, TCP_CONGESTION_INITIAL_WIN_BYTES));
+	conn->ca.ssthresh = TCP_WINDOW_MAX;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		conn->ca.ops->on_loss(conn);
+
+		/* Account for the segments which left the network, unless the
+		 * algorithm keeps its window on losses.
+		 */
+		if (conn->ca.ssthresh < cwnd) {
+			conn->ca.cwnd = MIN(conn_mss(conn) * 3 + conn->ca.ssthresh,
+					    TCP_WINDOW_MAX);
+		}
+
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+	}
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	conn->ca.ops->on_rto(conn);
 }
 
+/* For every duplicate ack during the fast recovery increment the cwnd by mss,
+ * RFC 5681 ch 3.2
+ */
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	uint32_t new_win = conn->ca.cwnd;
+
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		return;
+	}
+
+	new_win += conn_mss(conn);
+	conn->ca.cwnd = MIN(new_win, TCP_WINDOW_MAX);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		conn->ca.ops->on_ack(conn, acked_len);
+	} else if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+		/* End of the fast recovery */
+		conn->ca.pending_fast_retransmit_bytes = 0;
+		conn->ca.cwnd = conn->ca.ssthresh;
+	} else {
+		conn->ca.pending_fast_retransmit_bytes -= acked_len;
+		conn->ca.cwnd -= MIN(acked_len, conn->ca.cwnd);
+	}
+}
+
+static void tcp_ca_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca.ops = from->ca.ops;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, uint32_t len)
+{
+	const struct tcp_congestion_ops *ops;
+
+	/* The name is not necessarily NUL terminated */
+	len = strnlen(value, MIN(len, TCP_CONGESTION_NAME_MAX));
+
+	ops = tcp_ca_find(value, len);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops != conn->ca.ops) {
+		conn->ca.ops = ops;
+
+		/* Keep the current window of an established connection */
+		if (conn->state != TCP_LISTEN && conn->state != TCP_SYN_SENT &&
+		    conn->state != TCP_SYN_RECEIVED) {
+			conn->ca.ops->init(conn);
+		}
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, uint32_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name) + 1;
+
+	if (len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(name_len, *len);
+	memcpy(value, conn->ca.ops->name, name_len);
+	((char *)value)[name_len - 1] = '\0';
+	*len = name_len;
+
+	return 0;
 }
 #else
 
@@ -602,6 +687,18 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_copy(struct tcp *to, struct tcp *from) { }
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, uint32_t len)
+{
+	return -ENOPROTOOPT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, uint32_t *len)
+{
+	return -ENOPROTOOPT;
+}
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -1096,10 +1193,13 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* MSS, window scale and SACK permitted are only valid in a SYN segment,
+ * RFC 7323 ch 2.2 and RFC 2018 ch 2.
+ */
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
-	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	uint8_t options_buf[NET_TCP_OPTIONS_MAX_LEN];
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
@@ -1107,8 +1207,11 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1143,6 +1246,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				net_ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -1154,9 +1261,43 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = MIN(options[2], NET_TCP_WINDOW_SCALE_MAX);
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_cnt < NET_TCP_SACK_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_cnt];
+
+				block->start = net_ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				block->end = net_ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+				recv_options->sack_cnt++;
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1346,8 +1487,22 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* The window field of a SYN segment is never scaled, RFC 7323 ch 2.2 */
+static uint16_t tcp_window_field(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if ((flags & SYN) == 0) {
+		win >>= conn->rcv_wscale;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1361,14 +1516,11 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_sport));
 	UNALIGNED_PUT(conn->dst.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_dport));
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(net_htons(conn->recv_win), UNALIGNED_MEMBER_ADDR(th, th_win));
+	UNALIGNED_PUT(net_htons(tcp_window_field(conn, flags)),
+		      UNALIGNED_MEMBER_ADDR(th, th_win));
 	UNALIGNED_PUT(net_htonl(seq), UNALIGNED_MEMBER_ADDR(th, th_seq));
 
 	if (ACK & flags) {
@@ -1426,23 +1578,111 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, uint32_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+/* Smallest scale factor letting the whole receive window be advertised */
+static uint8_t tcp_window_scale(struct tcp *conn)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	uint8_t shift = 0U;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	while ((shift < NET_TCP_WINDOW_SCALE_MAX) &&
+	       ((conn->recv_win_max >> shift) > UINT16_MAX)) {
+		shift++;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	return shift;
+}
+#endif
 
-	UNALIGNED_PUT(net_htonl(recv_mss), (uint32_t *)mss);
+/* Offer window scaling and SACK in the SYN of an active open */
+static void tcp_options_offer(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->send_options.wnd_found = true;
+	conn->rcv_wscale = tcp_window_scale(conn);
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->send_options.sack_perm_found = true;
+#endif
+}
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+/* Window scaling and SACK are only used if both peers sent the option in
+ * their SYN. Called when a SYN is received, before replying to it.
+ */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->send_options.wnd_found = conn->recv_options.wnd_found;
+	if (conn->recv_options.wnd_found) {
+		conn->snd_wscale = conn->recv_options.window;
+		if (conn->state == TCP_LISTEN) {
+			conn->rcv_wscale = tcp_window_scale(conn);
+		}
+	} else {
+		conn->snd_wscale = 0U;
+		conn->rcv_wscale = 0U;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->send_options.sack_perm_found = conn->recv_options.sack_perm_found;
+	conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
+	ARG_UNUSED(conn);
+}
+
+/* Write the options of a segment, padded with NOPs to a multiple of
+ * 4 bytes, and return their length.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *options)
+{
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		uint32_t recv_mss = net_tcp_get_supported_mss(conn);
+
+		recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+		UNALIGNED_PUT(net_htonl(recv_mss), (uint32_t *)options);
+		len += NET_TCP_MSS_SIZE;
+	}
+
+	if ((flags & SYN) != 0) {
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+		if (conn->send_options.wnd_found) {
+			options[len++] = NET_TCP_NOP_OPT;
+			options[len++] = NET_TCP_WINDOW_SCALE_OPT;
+			options[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+			options[len++] = conn->rcv_wscale;
+		}
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+		if (conn->send_options.sack_perm_found) {
+			options[len++] = NET_TCP_NOP_OPT;
+			options[len++] = NET_TCP_NOP_OPT;
+			options[len++] = NET_TCP_SACK_PERM_OPT;
+			options[len++] = NET_TCP_SACK_PERM_SIZE;
+		}
+#endif
+		return len;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* The out of order queue holds a single range of data, report it */
+	if (conn->sack_ok && (flags & ACK) != 0 && conn->queue_recv_data != NULL) {
+		uint32_t start = tcp_get_seq(conn->queue_recv_data);
+		uint32_t end = start + net_buf_frags_len(conn->queue_recv_data);
+
+		if (net_tcp_seq_greater(start, conn->ack)) {
+			options[len++] = NET_TCP_NOP_OPT;
+			options[len++] = NET_TCP_NOP_OPT;
+			options[len++] = NET_TCP_SACK_OPT;
+			options[len++] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+			UNALIGNED_PUT(net_htonl(start), (uint32_t *)&options[len]);
+			UNALIGNED_PUT(net_htonl(end), (uint32_t *)&options[len + 4]);
+			len += NET_TCP_SACK_BLOCK_SIZE;
+		}
+	}
+#endif
+
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1557,13 +1797,14 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[NET_TCP_OPTIONS_MAX_LEN];
+	size_t options_len = tcp_options_build(conn, flags, options);
+	size_t alloc_len = sizeof(struct tcphdr) + options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
-
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
+	uint16_t data_sum = 0U;
+	size_t data_sum_len = 0U;
+	bool data_summed = false;
 
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
@@ -1572,6 +1813,9 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		data_summed = net_pkt_chksum_acc_get(data, &data_sum, &data_sum_len);
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1583,20 +1827,24 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
 		}
 	}
 
+	if (data_summed) {
+		net_pkt_chksum_acc_set(pkt, data_sum, data_sum_len);
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1705,11 +1953,18 @@ out:
 }
 
 static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
-			size_t len)
+			size_t len, bool chksum)
 {
 	net_pkt_cursor_init(to);
 	net_pkt_cursor_init(from);
 
+	/* Sum the data while it is copied, for the checksum of the segment */
+	if (chksum && net_if_need_calc_tx_checksum(net_pkt_iface(to),
+					 net_pkt_family(to) == NET_AF_INET6 ?
+					 NET_IF_CHECKSUM_IPV6_TCP : NET_IF_CHECKSUM_IPV4_TCP)) {
+		net_pkt_chksum_acc_start(to);
+	}
+
 	if (pos) {
 		net_pkt_set_overwrite(from, true);
 		net_pkt_skip(from, pos);
@@ -1814,33 +2069,127 @@ static void tcp_setup_retransmission(struct tcp *conn)
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
 }
 
-static int tcp_send_data(struct tcp *conn)
+#if defined(CONFIG_NET_TCP_GSO)
+/* Leave room for the IP and TCP headers, with options, in the IP length */
+#define TCP_GSO_MAX_LEN (UINT16_MAX - 128U)
+
+/* Number of full-sized segments sent in one packet. Packets to our own
+ * addresses are given to the receiver as they are, so they hold a single
+ * segment.
+ */
+static size_t tcp_gso_segs(struct tcp *conn)
+{
+	if (tcp_send_cb) {
+		return 1U;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_context_get_family(conn->context) == NET_AF_INET) {
+		if (net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) ||
+		    net_ipv4_is_my_addr(&conn->dst.sin.sin_addr)) {
+			return 1U;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    net_context_get_family(conn->context) == NET_AF_INET6) {
+		if (net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) ||
+		    net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr)) {
+			return 1U;
+		}
+	}
+
+	return MIN(CONFIG_NET_TCP_GSO_MAX_SEGS, TCP_GSO_MAX_LEN / conn_mss(conn));
+}
+#else
+static size_t tcp_gso_segs(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+
+	return 1U;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Copy len bytes of the unsent data to a packet. The data of each segment
+ * is copied to buffers of its own, so that the packet can be cut into
+ * segments without copying the data again.
+ */
+static struct net_pkt *tcp_send_data_pkt(struct tcp *conn, size_t len,
+					 size_t mss)
+{
+	struct net_pkt *pkt = NULL;
+	struct net_pkt *seg;
+	size_t seg_len;
+	size_t pos;
+
+	for (pos = 0; pos < len; pos += seg_len) {
+		seg_len = MIN(len - pos, mss);
+
+		seg = tcp_pkt_alloc(conn, seg_len);
+		if (!seg) {
+			NET_ERR("[%p] packet allocation failed, len=%zu", conn, seg_len);
+			goto fail;
+		}
+
+		/* GSO segments are summed when the packet is cut */
+		if (tcp_pkt_peek(seg, &conn->send_data, conn->unacked_len + pos,
+				 seg_len, len <= mss) < 0) {
+			tcp_pkt_unref(seg);
+			goto fail;
+		}
+
+		if (!pkt) {
+			pkt = seg;
+			continue;
+		}
+
+		net_pkt_append_buffer(pkt, seg->buffer);
+		seg->buffer = NULL;
+		tcp_pkt_unref(seg);
+	}
+
+	if (len > mss) {
+		net_pkt_set_gso_size(pkt, mss);
+	}
+
+	return pkt;
+
+fail:
+	if (pkt) {
+		tcp_pkt_unref(pkt);
+	}
+
+	return NULL;
+}
+
+/* Send up to segs full-sized segments of unsent data */
+static int tcp_send_segments(struct tcp *conn, size_t segs)
 {
+	size_t mss = conn_mss(conn);
 	int ret = 0;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = tcp_unsent_len(conn);
 	if (len < 0) {
 		ret = len;
 		goto out;
 	}
+
+	len = MIN((size_t)len, segs * mss);
 	if (len == 0) {
 		NET_DBG("[%p] no data to send", conn);
 		ret = -ENODATA;
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("[%p] packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+	/* Nagle's algorithm holds back the last partial segment */
+	if (len > mss && !conn->tcp_nodelay) {
+		len -= len % mss;
 	}
 
-	ret = tcp_pkt_peek(pkt, &conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
+	pkt = tcp_send_data_pkt(conn, len, mss);
+	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
 	}
@@ -1848,13 +2197,18 @@ static int tcp_send_data(struct tcp *conn)
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
 		conn->unacked_len += len;
+		segs = DIV_ROUND_UP(len, mss);
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
-			net_stats_update_tcp_seg_rexmit(conn->iface);
+			while (segs-- > 0) {
+				net_stats_update_tcp_seg_rexmit(conn->iface);
+			}
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+			while (segs-- > 0) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
@@ -1870,6 +2224,11 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+static int tcp_send_data(struct tcp *conn)
+{
+	return tcp_send_segments(conn, 1U);
+}
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1895,7 +2254,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
-		ret = tcp_send_data(conn);
+		ret = tcp_send_segments(conn, tcp_gso_segs(conn));
 		if (ret < 0) {
 			break;
 		}
@@ -1916,6 +2275,237 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_reset(struct tcp *conn)
+{
+	memset(&conn->sack, 0, sizeof(conn->sack));
+}
+
+static void tcp_sack_remove(struct tcp_sack_scoreboard *sb, int idx, int cnt)
+{
+	memmove(&sb->blocks[idx], &sb->blocks[idx + cnt],
+		(sb->cnt - idx - cnt) * sizeof(sb->blocks[0]));
+	sb->cnt -= cnt;
+}
+
+/* Add a block to the scoreboard, merging it with the blocks it overlaps.
+ * When the scoreboard is full, the highest block is forgotten.
+ */
+static void tcp_sack_insert(struct tcp_sack_scoreboard *sb, struct tcp_sack_block block)
+{
+	int i = 0;
+
+	while (i < sb->cnt) {
+		struct tcp_sack_block *cur = &sb->blocks[i];
+
+		if (net_tcp_seq_cmp(block.end, cur->start) < 0 ||
+		    net_tcp_seq_cmp(block.start, cur->end) > 0) {
+			i++;
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(cur->start, block.start) < 0) {
+			block.start = cur->start;
+		}
+
+		if (net_tcp_seq_cmp(cur->end, block.end) > 0) {
+			block.end = cur->end;
+		}
+
+		tcp_sack_remove(sb, i, 1);
+	}
+
+	for (i = 0; i < sb->cnt; i++) {
+		if (net_tcp_seq_cmp(block.start, sb->blocks[i].start) < 0) {
+			break;
+		}
+	}
+
+	if (i == NET_TCP_SACK_BLOCKS) {
+		return;
+	}
+
+	if (sb->cnt == NET_TCP_SACK_BLOCKS) {
+		sb->cnt--;
+	}
+
+	memmove(&sb->blocks[i + 1], &sb->blocks[i], (sb->cnt - i) * sizeof(block));
+	sb->blocks[i] = block;
+	sb->cnt++;
+}
+
+/* Record the SACK blocks of a received segment, only keeping the ones
+ * within the sent and not yet acknowledged data.
+ */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (int i = 0; i < conn->recv_options.sack_cnt; i++) {
+		struct tcp_sack_block block = conn->recv_options.sack[i];
+
+		if (!net_tcp_seq_greater(block.end, block.start) ||
+		    !net_tcp_seq_greater(block.end, conn->seq) ||
+		    net_tcp_seq_greater(block.end, snd_nxt)) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block.start, conn->seq) < 0) {
+			block.start = conn->seq;
+		}
+
+		tcp_sack_insert(&conn->sack, block);
+	}
+}
+
+/* Find the first hole from the last retransmission on, below the highest
+ * data acknowledged by the peer. Returns the hole length, up to a MSS.
+ */
+static uint32_t tcp_sack_next_hole(struct tcp *conn, uint32_t *start)
+{
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+	uint32_t from = sb->high_rxt;
+
+	if (net_tcp_seq_cmp(from, conn->seq) < 0) {
+		from = conn->seq;
+	}
+
+	for (int i = 0; i < sb->cnt; i++) {
+		if (net_tcp_seq_cmp(from, sb->blocks[i].start) < 0) {
+			*start = from;
+			return MIN(sb->blocks[i].start - from, conn_mss(conn));
+		}
+
+		if (net_tcp_seq_cmp(from, sb->blocks[i].end) < 0) {
+			from = sb->blocks[i].end;
+		}
+	}
+
+	return 0;
+}
+
+/* Retransmit already sent data, leaving the data in flight unchanged */
+static int tcp_sack_retransmit(struct tcp *conn, uint32_t seq, uint32_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tcp_pkt_alloc(conn, len);
+	if (!pkt) {
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, &conn->send_data, seq - conn->seq, len, true);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, seq);
+	if (ret == 0) {
+		conn->sack.high_rxt = seq + len;
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+static bool tcp_sack_retransmit_next(struct tcp *conn)
+{
+	uint32_t start;
+	uint32_t len;
+
+	len = tcp_sack_next_hole(conn, &start);
+	if (len == 0) {
+		return false;
+	}
+
+	NET_DBG("[%p] SACK retransmit seq %u len %u", conn, start, len);
+
+	return tcp_sack_retransmit(conn, start, len) == 0;
+}
+
+/* Start a loss recovery on the third duplicate ACK, RFC 6675 ch 5. Returns
+ * false if no hole is known, so the first unacknowledged segment is to be
+ * retransmitted.
+ */
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	if (!conn->sack_ok || conn->sack.cnt == 0) {
+		return false;
+	}
+
+	conn->sack.in_recovery = true;
+	conn->sack.recovery_point = conn->seq + conn->unacked_len;
+	conn->sack.high_rxt = conn->seq;
+
+	return tcp_sack_retransmit_next(conn);
+}
+
+static bool tcp_sack_in_recovery(struct tcp *conn)
+{
+	return conn->sack.in_recovery;
+}
+
+/* Forget the blocks covered by a new cumulative ACK, and carry on with
+ * the recovery on a partial ACK.
+ */
+static void tcp_sack_acked(struct tcp *conn)
+{
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+	int i;
+
+	for (i = 0; i < sb->cnt; i++) {
+		if (net_tcp_seq_cmp(sb->blocks[i].end, conn->seq) > 0) {
+			break;
+		}
+	}
+
+	tcp_sack_remove(sb, 0, i);
+
+	if (sb->cnt > 0 && net_tcp_seq_cmp(sb->blocks[0].start, conn->seq) < 0) {
+		sb->blocks[0].start = conn->seq;
+	}
+
+	if (!sb->in_recovery) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, sb->recovery_point) >= 0) {
+		sb->in_recovery = false;
+		return;
+	}
+
+	if (!tcp_sack_retransmit_next(conn) &&
+	    net_tcp_seq_cmp(sb->high_rxt, conn->seq) <= 0) {
+		/* The next hole is above the highest SACKed data */
+		(void)tcp_sack_retransmit(conn, conn->seq,
+					  MIN(conn->unacked_len, conn_mss(conn)));
+	}
+}
+#else
+
+static inline void tcp_sack_reset(struct tcp *conn) { }
+
+static inline void tcp_sack_update(struct tcp *conn) { }
+
+static inline bool tcp_sack_recovery_start(struct tcp *conn) { return false; }
+
+static inline bool tcp_sack_in_recovery(struct tcp *conn) { return false; }
+
+static inline bool tcp_sack_retransmit_next(struct tcp *conn) { return false; }
+
+static inline void tcp_sack_acked(struct tcp *conn) { }
+
+#endif
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1971,6 +2561,7 @@ static void tcp_resend_data(struct k_work *work)
 
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
+		tcp_sack_reset(conn);
 
 		ret = tcp_send_data(conn);
 		if (ret == -ENODATA) {
@@ -2189,7 +2780,7 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN(tcp_rx_window, TCP_WINDOW_MAX);
 	conn->recv_win = conn->recv_win_max;
 	conn->recv_win_sent = conn->recv_win_max;
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
@@ -2203,7 +2794,9 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = TCP_WINDOW_MAX;
+	conn->ca.ops = tcp_ca_find(TCP_CONGESTION_DEFAULT, strlen(TCP_CONGESTION_DEFAULT));
+	NET_ASSERT(conn->ca.ops != NULL, "No %s congestion control", TCP_CONGESTION_DEFAULT);
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2999,8 +3592,13 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->recv_options.sack_cnt = 0U;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  (th_flags(th) & SYN) != 0)) {
 		NET_DBG("[%p] DROP: Invalid TCP option list", conn);
 		net_tcp_reply_rst(pkt);
 		do_close = true;
@@ -3059,6 +3657,11 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	/* Both the seqnum and the acknum are valid, then do processing. */
 	conn->send_win = net_ntohs(th_win(th));
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if ((th_flags(th) & SYN) == 0) {
+		conn->send_win <<= conn->snd_wscale;
+	}
+#endif
 	if (conn->send_win > conn->send_win_max) {
 		NET_DBG("[%p] Lowering send window from %u to %u",
 			conn, conn->send_win, conn->send_win_max);
@@ -3094,6 +3697,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_options_negotiate(conn);
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
@@ -3123,6 +3727,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3207,6 +3812,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			k_work_cancel_delayable(&conn->send_data_timer);
+			tcp_options_negotiate(conn);
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
@@ -3253,6 +3859,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		keep_alive_timer_restart(conn);
 
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+		tcp_sack_update(conn);
+
 		if (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0) {
 			/* Only if there is pending data, increment the duplicate ack count */
 			if (conn->send_data_total > 0) {
@@ -3272,20 +3880,27 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				/* With SACK, retransmit the first hole reported by the peer */
+				if (!tcp_sack_recovery_start(conn)) {
+					/* Apply a fast retransmit */
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+				   tcp_sack_in_recovery(conn) && (len == 0)) {
+				/* Every further duplicate ACK lets a hole be filled */
+				(void)tcp_sack_retransmit_next(conn);
 			}
 		}
 #endif
@@ -3332,6 +3947,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			tcp_sack_acked(conn);
+
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
 			 * makes a "forward progress".
@@ -3913,6 +4530,7 @@ static int tcp_start_handshake(struct tcp *conn)
 	k_mutex_lock(&conn->lock, K_FOREVER);
 	tcp_check_sock_options(conn);
 	conn->send_options.mss_found = true;
+	tcp_options_offer(conn);
 	ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 	if (ret < 0) {
 		k_mutex_unlock(&conn->lock);
@@ -4217,7 +4835,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* The checksum of each segment is computed when the packet is cut */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) &&
+	     net_pkt_gso_size(pkt) == 0U) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4232,7 +4852,8 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 	enum net_if_checksum_type type = net_pkt_family(pkt) == NET_AF_INET6 ?
 		NET_IF_CHECKSUM_IPV6_TCP : NET_IF_CHECKSUM_IPV4_TCP;
 
-	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	/* The segments merged by GRO were verified already */
+	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) && net_pkt_gso_size(pkt) == 0U &&
 	    (net_if_need_calc_rx_checksum(net_pkt_iface(pkt), type) ||
 	     net_pkt_is_ip_reassembled(pkt)) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
@@ -4683,6 +5304,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4720,6 +5344,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4809,6 +5436,14 @@ void net_tcp_init(void)
 			   K_KERNEL_STACK_SIZEOF(work_q_stack), THREAD_PRIORITY,
 			   NULL);
 
+#if defined(CONFIG_FPU_SHARING)
+	/* Segments are built and their checksum computed from the work queue */
+	if (NET_CHKSUM_THREAD_OPTIONS != 0) {
+		(void)k_float_enable(k_work_queue_thread_get(&tcp_work_q),
+				     NET_CHKSUM_THREAD_OPTIONS);
+	}
+#endif
+
 	/* Compute the largest possible retransmission timeout */
 	tcp_max_timeout_ms = 0;
 	rto = tcp_rto;
@@ -0,0 +1,277 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Lightweight BBR style congestion control.
+ *
+ * The window is derived from a model of the path instead of from losses:
+ * the bottleneck bandwidth is the highest delivery rate measured over the
+ * last round trips, and the propagation delay the shortest round trip
+ * measured over the last 10 seconds. Their product, the bandwidth delay
+ * product (BDP), is the amount of data which fills the path.
+ *
+ * The stack has no pacing timer, so the pacing gains of BBR are applied
+ * to the congestion window instead:
+ *
+ * - STARTUP grows the window exponentially until the delivery rate stops
+ *   growing by 25% for three round trips.
+ * - DRAIN shrinks the window until the data in flight fits the BDP.
+ * - PROBE_BW cycles the window around the BDP, one round trip above it to
+ *   probe for more bandwidth, one below to drain the queue it built.
+ * - PROBE_RTT shrinks the window to 4 segments for 200 ms when the shortest
+ *   round trip was not refreshed for 10 seconds.
+ *
+ * A round trip lasts until the data sent after its start is acknowledged,
+ * and its duration is the round trip time sample.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_context.h>
+#include "tcp_internal.h"
+
+enum bbr_mode {
+	BBR_STARTUP,
+	BBR_DRAIN,
+	BBR_PROBE_BW,
+	BBR_PROBE_RTT,
+};
+
+/* Gains are in 1/256 */
+#define BBR_UNIT        256U
+#define BBR_HIGH_GAIN   739U  /* 2 / ln(2) */
+#define BBR_DRAIN_GAIN  88U   /* ln(2) / 2 */
+
+#define BBR_CYCLE_LEN        8U
+#define BBR_BW_WINDOW_ROUNDS 10U
+#define BBR_MIN_RTT_WIN_MS   10000U
+#define BBR_PROBE_RTT_MS     200U
+#define BBR_FULL_BW_CNT      3U
+#define BBR_MIN_SEGMENTS     4U
+
+static const uint16_t bbr_cycle_gain[BBR_CYCLE_LEN] = {
+	BBR_UNIT * 5U / 4U, BBR_UNIT * 3U / 4U,
+	BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT,
+};
+
+static inline uint32_t bbr_max_bw(struct tcp_bbr *bbr)
+{
+	return MAX(bbr->bw_max[0], bbr->bw_max[1]);
+}
+
+static inline bool bbr_full_bw_reached(struct tcp_bbr *bbr)
+{
+	return bbr->full_bw_cnt >= BBR_FULL_BW_CNT;
+}
+
+/* Bandwidth delay product in bytes, 0 without a model yet */
+static uint32_t bbr_bdp(struct tcp_bbr *bbr)
+{
+	if (bbr->min_rtt == UINT32_MAX) {
+		return 0U;
+	}
+
+	return (uint32_t)MIN(((uint64_t)bbr_max_bw(bbr) * bbr->min_rtt) / MSEC_PER_SEC,
+			     TCP_WINDOW_MAX);
+}
+
+static uint32_t bbr_gain(struct tcp_bbr *bbr)
+{
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		return BBR_HIGH_GAIN;
+	case BBR_DRAIN:
+		return BBR_DRAIN_GAIN;
+	case BBR_PROBE_BW:
+		return bbr_cycle_gain[bbr->cycle];
+	default:
+		return BBR_UNIT;
+	}
+}
+
+static void bbr_round_reset(struct tcp *conn, uint32_t now)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+
+	bbr->round_start = now;
+	bbr->round_end = conn->seq + conn->unacked_len;
+	bbr->delivered = 0U;
+}
+
+static void bbr_check_full_bw(struct tcp_bbr *bbr, uint32_t bw)
+{
+	if (bbr_full_bw_reached(bbr)) {
+		return;
+	}
+
+	if ((uint64_t)bw * 4U >= (uint64_t)bbr->full_bw * 5U) {
+		bbr->full_bw = bw;
+		bbr->full_bw_cnt = 0U;
+		return;
+	}
+
+	bbr->full_bw_cnt++;
+}
+
+static void bbr_enter_probe_bw(struct tcp_bbr *bbr)
+{
+	bbr->mode = BBR_PROBE_BW;
+	bbr->cycle = 0U;
+}
+
+/* Returns true at the end of a round trip */
+static bool bbr_update_model(struct tcp *conn, uint32_t acked_len, uint32_t now)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+	uint32_t interval;
+	uint32_t bw;
+
+	bbr->delivered += acked_len;
+
+	if (net_tcp_seq_cmp(conn->seq + acked_len, bbr->round_end) < 0) {
+		return false;
+	}
+
+	interval = MAX(now - bbr->round_start, 1U);
+	bw = (uint32_t)MIN(((uint64_t)bbr->delivered * MSEC_PER_SEC) / interval, UINT32_MAX);
+
+	bbr->rounds++;
+	if ((bbr->rounds % BBR_BW_WINDOW_ROUNDS) == 0U) {
+		bbr->bw_max[1] = bbr->bw_max[0];
+		bbr->bw_max[0] = 0U;
+	}
+
+	bbr->bw_max[0] = MAX(bbr->bw_max[0], bw);
+
+	if (interval <= bbr->min_rtt ||
+	    (now - bbr->min_rtt_stamp) > BBR_MIN_RTT_WIN_MS) {
+		if (bbr->mode != BBR_PROBE_RTT && bbr->min_rtt != UINT32_MAX &&
+		    interval > bbr->min_rtt) {
+			/* The shortest round trip expired, drain the queue to
+			 * measure it again.
+			 */
+			bbr->mode = BBR_PROBE_RTT;
+			bbr->probe_rtt_end = now + BBR_PROBE_RTT_MS;
+		}
+
+		bbr->min_rtt = interval;
+		bbr->min_rtt_stamp = now;
+	}
+
+	bbr_round_reset(conn, now);
+
+	return true;
+}
+
+static void bbr_update_mode(struct tcp *conn, bool round_end, uint32_t now)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		if (round_end) {
+			bbr_check_full_bw(bbr, bbr_max_bw(bbr));
+		}
+
+		if (bbr_full_bw_reached(bbr)) {
+			bbr->mode = BBR_DRAIN;
+			NET_DBG("[%p] bbr drain, bw=%u", conn, bbr_max_bw(bbr));
+		}
+		break;
+	case BBR_DRAIN:
+		if (conn->unacked_len <= bbr_bdp(bbr)) {
+			bbr_enter_probe_bw(bbr);
+		}
+		break;
+	case BBR_PROBE_BW:
+		if (round_end) {
+			bbr->cycle = (bbr->cycle + 1U) % BBR_CYCLE_LEN;
+		}
+		break;
+	case BBR_PROBE_RTT:
+		if ((int32_t)(now - bbr->probe_rtt_end) >= 0 && round_end) {
+			if (bbr_full_bw_reached(bbr)) {
+				bbr_enter_probe_bw(bbr);
+			} else {
+				bbr->mode = BBR_STARTUP;
+			}
+		}
+		break;
+	}
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+	uint32_t now = k_uptime_get_32();
+
+	memset(bbr, 0, sizeof(*bbr));
+	bbr->mode = BBR_STARTUP;
+	bbr->min_rtt = UINT32_MAX;
+	bbr->min_rtt_stamp = now;
+	bbr_round_reset(conn, now);
+}
+
+static void tcp_bbr_on_ack(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_bbr *bbr = &conn->ca.bbr;
+	uint32_t mss = conn_mss(conn);
+	uint32_t min_cwnd = BBR_MIN_SEGMENTS * mss;
+	uint32_t now = k_uptime_get_32();
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+	bool round_end;
+
+	round_end = bbr_update_model(conn, acked_len, now);
+	bbr_update_mode(conn, round_end, now);
+
+	if (bbr->mode == BBR_PROBE_RTT) {
+		conn->ca.cwnd = MIN(cwnd, min_cwnd);
+		return;
+	}
+
+	target = bbr_bdp(bbr);
+	if (target == 0U) {
+		/* No model yet, grow as in slow start */
+		conn->ca.cwnd = MIN(cwnd + acked_len, TCP_WINDOW_MAX);
+		return;
+	}
+
+	/* Leave room for delayed and stretched ACKs */
+	target = (uint32_t)MIN(((uint64_t)target * bbr_gain(bbr)) / BBR_UNIT + 3U * mss,
+			       TCP_WINDOW_MAX);
+
+	if (bbr_full_bw_reached(bbr)) {
+		cwnd = MIN(cwnd + acked_len, target);
+	} else if (cwnd < target) {
+		cwnd += acked_len;
+	}
+
+	conn->ca.cwnd = CLAMP(cwnd, min_cwnd, TCP_WINDOW_MAX);
+}
+
+static void tcp_bbr_on_loss(struct tcp *conn)
+{
+	/* Losses are not a congestion signal, keep the window after recovery */
+	conn->ca.ssthresh = MAX(conn->ca.cwnd, BBR_MIN_SEGMENTS * conn_mss(conn));
+}
+
+static void tcp_bbr_on_rto(struct tcp *conn)
+{
+	conn->ca.ssthresh = MAX(conn->ca.cwnd, BBR_MIN_SEGMENTS * conn_mss(conn));
+	conn->ca.cwnd = conn_mss(conn);
+
+	/* The data in flight is sent again, start a new round trip */
+	bbr_round_reset(conn, k_uptime_get_32());
+
+	NET_DBG("[%p] bbr timeout, ssthresh=%u", conn, conn->ca.ssthresh);
+}
+
+TCP_CONGESTION_DEFINE(bbr, "bbr", tcp_bbr_init, tcp_bbr_on_ack,
+		      tcp_bbr_on_loss, tcp_bbr_on_rto);
@@ -0,0 +1,167 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CUBIC congestion control, after RFC 9438.
+ *
+ * After a congestion event, the congestion window W follows
+ *
+ *   W(t) = C * (t - K)^3 + W_max
+ *
+ * where t is the time since the start of the congestion avoidance, W_max
+ * the window before the reduction and K the time at which W_max is
+ * reached again. The window thus grows fast away from W_max, slowly close
+ * to it, and fast again when probing for more bandwidth. Windows are in
+ * bytes and times in milliseconds. The round trip time is not measured,
+ * so the window is not targeted one round trip ahead.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_context.h>
+#include "tcp_internal.h"
+
+/* C = 0.4 segments/s^3 and beta = 0.7 */
+#define CUBIC_BETA_NUM 7U
+#define CUBIC_BETA_DEN 10U
+
+/* W_max after a reduction below the previous W_max: (1 + beta) / 2 */
+#define CUBIC_FAST_CONV_NUM 17U
+#define CUBIC_FAST_CONV_DEN 20U
+
+/* Reno friendly increase: 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_ALPHA_NUM 9U
+#define CUBIC_ALPHA_DEN 17U
+
+/* Bound of |t - K|, so that its cube fits in 64 bits */
+#define CUBIC_T_MAX_MS 1000000
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint32_t lo = 0U;
+	uint32_t hi = 1U << 22;
+
+	/* Largest x with x^3 <= a, for a < 2^64 */
+	while (lo < hi) {
+		uint32_t mid = (lo + hi + 1U) / 2U;
+
+		if ((uint64_t)mid * mid * mid <= a) {
+			lo = mid;
+		} else {
+			hi = mid - 1U;
+		}
+	}
+
+	return lo;
+}
+
+/* W(t) in bytes, t in ms since the start of the epoch */
+static uint64_t cubic_window(struct tcp_cubic *cubic, uint32_t mss, uint32_t t)
+{
+	int64_t delta = CLAMP((int64_t)t - cubic->k, -CUBIC_T_MAX_MS, CUBIC_T_MAX_MS);
+	int64_t offset;
+
+	/* C * delta^3 segments, with delta in ms */
+	offset = ((delta * delta * delta) / 1000000) * 4 * mss / 10000;
+	if (offset < 0 && (uint64_t)-offset >= cubic->origin) {
+		return 0;
+	}
+
+	return cubic->origin + offset;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+}
+
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	/* The window actually used, cwnd is inflated by duplicate ACKs */
+	uint32_t win = MIN(conn->ca.cwnd, MAX(conn->unacked_len, 2 * mss));
+
+	if (win < cubic->w_max) {
+		/* Release bandwidth for new flows, RFC 9438 ch 4.7 */
+		cubic->w_max = (uint32_t)(((uint64_t)win * CUBIC_FAST_CONV_NUM) /
+					  CUBIC_FAST_CONV_DEN);
+	} else {
+		cubic->w_max = win;
+	}
+
+	cubic->in_epoch = false;
+	conn->ca.ssthresh = MAX((uint32_t)(((uint64_t)win * CUBIC_BETA_NUM) / CUBIC_BETA_DEN),
+				2 * mss);
+}
+
+static void tcp_cubic_on_loss(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+
+	NET_DBG("[%p] cubic loss, w_max=%u, ssthresh=%u", conn,
+		conn->ca.cubic.w_max, conn->ca.ssthresh);
+}
+
+static void tcp_cubic_on_rto(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+
+	NET_DBG("[%p] cubic timeout, w_max=%u, ssthresh=%u", conn,
+		conn->ca.cubic.w_max, conn->ca.ssthresh);
+}
+
+static void tcp_cubic_on_ack(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_cubic *cubic = &conn->ca.cubic;
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	uint64_t target;
+	uint64_t inc;
+
+	if (cwnd < conn->ca.ssthresh) {
+		/* Slow start */
+		conn->ca.cwnd = MIN(cwnd + MIN(acked_len, mss), TCP_WINDOW_MAX);
+		return;
+	}
+
+	if (!cubic->in_epoch) {
+		cubic->in_epoch = true;
+		cubic->epoch_start = now;
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((W_max - cwnd) / C), in ms */
+			cubic->k = cubic_root(((uint64_t)(cubic->w_max - cwnd) *
+					       2500000000ULL) / mss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0U;
+			cubic->origin = cwnd;
+		}
+	}
+
+	target = cubic_window(cubic, mss, now - cubic->epoch_start);
+	target = CLAMP(target, cwnd, (uint64_t)cwnd + cwnd / 2U);
+
+	/* Grow at least as fast as Reno would, RFC 9438 ch 4.3 */
+	cubic->w_est += (uint32_t)(((uint64_t)acked_len * mss * CUBIC_ALPHA_NUM) /
+				   ((uint64_t)cwnd * CUBIC_ALPHA_DEN));
+	target = MAX(target, cubic->w_est);
+
+	/* (target - cwnd) / cwnd per acknowledged segment */
+	inc = DIV_ROUND_UP((target - cwnd) * acked_len, cwnd);
+
+	conn->ca.cwnd = (uint32_t)MIN(cwnd + inc, TCP_WINDOW_MAX);
+}
+
+TCP_CONGESTION_DEFINE(cubic, "cubic", tcp_cubic_init, tcp_cubic_on_ack,
+		      tcp_cubic_on_loss, tcp_cubic_on_rto);
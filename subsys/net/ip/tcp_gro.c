@@ -0,0 +1,392 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * TCP generic receive offload.
+ *
+ * Received packets wait in the RX queue of their traffic class before they
+ * go through the IP and TCP input one by one. Instead, the in-order data
+ * segments of a connection which were queued together are merged into one
+ * packet: the data of the following segments is appended to the first one
+ * and their headers are dropped. The merged packet is processed when the
+ * queue is empty, after CONFIG_NET_TCP_GRO_BUDGET packets otherwise, when
+ * a segment of the connection cannot be merged, or when the packet is
+ * full.
+ *
+ * Segments are merged if their headers only differ by the lengths,
+ * checksums, sequence numbers, windows and PSH flag. Their checksums are
+ * verified before merging, and the size of the segments is recorded in the
+ * merged packet so that TCP does not verify it again.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Leave room for the IP and TCP headers, with options, in the IP length */
+#define GRO_MAX_LEN (UINT16_MAX - 128U)
+
+struct gro_seg {
+	uint8_t *ip;
+	struct tcphdr *th;
+	uint8_t ip_len;
+	uint8_t hdr_len;
+	uint16_t data_len;
+};
+
+struct gro_flow {
+	/* First segment, with the data of the following ones appended */
+	struct net_pkt *pkt;
+	/* Headers of the first segment */
+	struct gro_seg hdr;
+	uint32_t next_seq;
+	uint16_t data_len;
+	uint8_t segs;
+};
+
+static struct gro_flow gro_flows[NET_TC_RX_COUNT][CONFIG_NET_TCP_GRO_MAX_FLOWS];
+static uint8_t gro_evict[NET_TC_RX_COUNT];
+
+/* Set while a merged packet is processed. Packets looped back by TCP to
+ * us meanwhile are processed right away.
+ */
+static bool gro_busy[NET_TC_RX_COUNT];
+
+/* Only the families which are enabled get past gro_parse() */
+static inline bool gro_is_ipv4(struct net_pkt *pkt)
+{
+	return !IS_ENABLED(CONFIG_NET_IPV6) ||
+	       (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == NET_AF_INET);
+}
+
+/* The IP and TCP headers of a merged segment must be in its first buffer */
+static bool gro_parse(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t len;
+
+	if (!buf) {
+		return false;
+	}
+
+	seg->ip = buf->data;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == NET_AF_INET) {
+		struct net_ipv4_hdr *hdr = (struct net_ipv4_hdr *)seg->ip;
+
+		/* No options, and fragments are left to the IP input */
+		if (buf->len < sizeof(*hdr) || hdr->vhl != 0x45 ||
+		    hdr->proto != NET_IPPROTO_TCP ||
+		    (sys_get_be16(hdr->offset) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+			return false;
+		}
+
+		seg->ip_len = sizeof(*hdr);
+		len = net_ntohs(hdr->len);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == NET_AF_INET6) {
+		struct net_ipv6_hdr *hdr = (struct net_ipv6_hdr *)seg->ip;
+
+		/* No extension headers */
+		if (buf->len < sizeof(*hdr) || (hdr->vtc & 0xf0) != 0x60 ||
+		    hdr->nexthdr != NET_IPPROTO_TCP) {
+			return false;
+		}
+
+		seg->ip_len = sizeof(*hdr);
+		len = sizeof(*hdr) + net_ntohs(hdr->len);
+	} else {
+		return false;
+	}
+
+	if (buf->len < seg->ip_len + sizeof(struct tcphdr)) {
+		return false;
+	}
+
+	seg->th = (struct tcphdr *)(seg->ip + seg->ip_len);
+	seg->hdr_len = seg->ip_len + th_off(seg->th) * 4U;
+
+	if (th_off(seg->th) < 5U || buf->len < seg->hdr_len || len < seg->hdr_len ||
+	    len > net_pkt_get_len(pkt)) {
+		return false;
+	}
+
+	seg->data_len = len - seg->hdr_len;
+
+	/* Drop the link layer padding */
+	if (len < net_pkt_get_len(pkt)) {
+		net_pkt_update_length(pkt, len);
+	}
+
+	return true;
+}
+
+static bool gro_same_flow(struct gro_flow *flow, struct net_pkt *pkt,
+			  struct gro_seg *seg)
+{
+	struct gro_seg *hdr = &flow->hdr;
+
+	if (net_pkt_family(flow->pkt) != net_pkt_family(pkt) ||
+	    net_pkt_iface(flow->pkt) != net_pkt_iface(pkt) ||
+	    hdr->th->th_sport != seg->th->th_sport ||
+	    hdr->th->th_dport != seg->th->th_dport) {
+		return false;
+	}
+
+	if (gro_is_ipv4(pkt)) {
+		return memcmp(((struct net_ipv4_hdr *)hdr->ip)->src,
+			      ((struct net_ipv4_hdr *)seg->ip)->src,
+			      2 * NET_IPV4_ADDR_SIZE) == 0;
+	}
+
+	return memcmp(((struct net_ipv6_hdr *)hdr->ip)->src,
+		      ((struct net_ipv6_hdr *)seg->ip)->src,
+		      2 * NET_IPV6_ADDR_SIZE) == 0;
+}
+
+/* Data segments which could be followed by more data */
+static bool gro_is_data(struct gro_seg *seg)
+{
+	return seg->data_len > 0U && (th_flags(seg->th) & ~PSH) == ACK;
+}
+
+static bool gro_can_merge(struct gro_flow *flow, struct gro_seg *seg)
+{
+	struct gro_seg *hdr = &flow->hdr;
+	size_t opts_len = hdr->hdr_len - hdr->ip_len - sizeof(struct tcphdr);
+
+	if (!gro_is_data(seg) || th_seq(seg->th) != flow->next_seq ||
+	    hdr->th->th_ack != seg->th->th_ack || hdr->hdr_len != seg->hdr_len ||
+	    memcmp(hdr->th + 1, seg->th + 1, opts_len) != 0) {
+		return false;
+	}
+
+	/* A segment shorter than the first one ends the merged data */
+	if (seg->data_len > net_pkt_gso_size(flow->pkt) ||
+	    flow->data_len % net_pkt_gso_size(flow->pkt) != 0U) {
+		return false;
+	}
+
+	if (flow->segs >= CONFIG_NET_TCP_GRO_MAX_SEGS ||
+	    flow->data_len + seg->data_len > GRO_MAX_LEN) {
+		return false;
+	}
+
+	if (gro_is_ipv4(flow->pkt)) {
+		struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)hdr->ip;
+		struct net_ipv4_hdr *seg_hdr = (struct net_ipv4_hdr *)seg->ip;
+
+		return ipv4_hdr->tos == seg_hdr->tos && ipv4_hdr->ttl == seg_hdr->ttl;
+	}
+
+	/* Version, traffic class, flow label and hop limit */
+	return memcmp(hdr->ip, seg->ip, 4) == 0 &&
+	       ((struct net_ipv6_hdr *)hdr->ip)->hop_limit ==
+	       ((struct net_ipv6_hdr *)seg->ip)->hop_limit;
+}
+
+static bool gro_chksum_is_valid(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	enum net_if_checksum_type type;
+
+	net_pkt_set_ip_hdr_len(pkt, seg->ip_len);
+
+	if (gro_is_ipv4(pkt)) {
+		net_pkt_set_ipv4_opts_len(pkt, 0U);
+
+		if (net_if_need_calc_rx_checksum(iface, NET_IF_CHECKSUM_IPV4_HEADER) &&
+		    net_calc_chksum_ipv4(pkt) != 0U) {
+			return false;
+		}
+
+		type = NET_IF_CHECKSUM_IPV4_TCP;
+	} else {
+		net_pkt_set_ipv6_ext_len(pkt, 0U);
+		type = NET_IF_CHECKSUM_IPV6_TCP;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	    net_if_need_calc_rx_checksum(iface, type) &&
+	    net_calc_chksum_tcp(pkt) != 0U) {
+		return false;
+	}
+
+	return true;
+}
+
+/* Only the segments for us are merged, forwarded ones are sent as is */
+static bool gro_is_for_us(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	if (gro_is_ipv4(pkt)) {
+		return net_ipv4_is_my_addr_raw(((struct net_ipv4_hdr *)seg->ip)->dst);
+	}
+
+	return net_ipv6_is_my_addr_raw(((struct net_ipv6_hdr *)seg->ip)->dst);
+}
+
+static void gro_flush_flow(int tc, struct gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+	struct gro_seg *hdr = &flow->hdr;
+	enum net_verdict verdict;
+
+	flow->pkt = NULL;
+
+	if (flow->segs > 1U) {
+		if (gro_is_ipv4(pkt)) {
+			struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)hdr->ip;
+
+			ipv4_hdr->len = net_htons(hdr->hdr_len + flow->data_len);
+			ipv4_hdr->chksum = 0U;
+			ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
+		} else {
+			struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)hdr->ip;
+
+			ipv6_hdr->len = net_htons(hdr->hdr_len - hdr->ip_len + flow->data_len);
+		}
+	}
+
+	NET_DBG("pkt %p, %u segments, len %u", pkt, flow->segs, flow->data_len);
+
+	net_pkt_cursor_init(pkt);
+
+	gro_busy[tc] = true;
+
+	if (gro_is_ipv4(pkt)) {
+		verdict = net_ipv4_input(pkt);
+	} else {
+		verdict = net_ipv6_input(pkt);
+	}
+
+	gro_busy[tc] = false;
+
+	if (verdict != NET_OK) {
+		net_pkt_unref(pkt);
+	}
+}
+
+static void gro_hold(struct gro_flow *flow, struct net_pkt *pkt, struct gro_seg *seg)
+{
+	flow->pkt = pkt;
+	flow->hdr = *seg;
+	flow->next_seq = th_seq(seg->th) + seg->data_len;
+	flow->data_len = seg->data_len;
+	flow->segs = 1U;
+
+	/* The checksum was verified */
+	net_pkt_set_gso_size(pkt, seg->data_len);
+}
+
+static void gro_merge(struct gro_flow *flow, struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct tcphdr *th = flow->hdr.th;
+
+	/* The latest window and PSH flag apply to the merged data */
+	UNALIGNED_PUT(th_win(seg->th), UNALIGNED_MEMBER_ADDR(th, th_win));
+	UNALIGNED_PUT(th_flags(th) | (th_flags(seg->th) & PSH),
+		      UNALIGNED_MEMBER_ADDR(th, th_flags));
+
+	net_buf_pull(pkt->buffer, seg->hdr_len);
+	net_pkt_trim_buffer(pkt);
+
+	net_pkt_append_buffer(flow->pkt, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	flow->next_seq += seg->data_len;
+	flow->data_len += seg->data_len;
+	flow->segs++;
+}
+
+enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt)
+{
+	int tc = net_tc_rx_current();
+	struct gro_flow *flows;
+	struct gro_flow *flow = NULL;
+	struct gro_seg seg;
+	int i;
+
+	if (tc < 0 || gro_busy[tc] || !gro_parse(pkt, &seg)) {
+		return NET_CONTINUE;
+	}
+
+	flows = gro_flows[tc];
+
+	for (i = 0; i < CONFIG_NET_TCP_GRO_MAX_FLOWS; i++) {
+		if (flows[i].pkt && gro_same_flow(&flows[i], pkt, &seg)) {
+			flow = &flows[i];
+			break;
+		}
+	}
+
+	if (flow) {
+		if (gro_can_merge(flow, &seg) && gro_chksum_is_valid(pkt, &seg)) {
+			bool push = (th_flags(seg.th) & PSH) != 0U;
+
+			gro_merge(flow, pkt, &seg);
+
+			if (push || flow->segs == CONFIG_NET_TCP_GRO_MAX_SEGS) {
+				gro_flush_flow(tc, flow);
+			}
+
+			return NET_OK;
+		}
+
+		/* Keep the order of the segments of the connection */
+		gro_flush_flow(tc, flow);
+	}
+
+	/* A segment with PSH set is processed right away */
+	if (!gro_is_data(&seg) || (th_flags(seg.th) & PSH) ||
+	    !gro_is_for_us(pkt, &seg)) {
+		goto out;
+	}
+
+	if (!flow) {
+		for (i = 0; i < CONFIG_NET_TCP_GRO_MAX_FLOWS; i++) {
+			if (!flows[i].pkt) {
+				flow = &flows[i];
+				break;
+			}
+		}
+	}
+
+	if (!flow) {
+		flow = &flows[gro_evict[tc]];
+		gro_evict[tc] = (gro_evict[tc] + 1U) % CONFIG_NET_TCP_GRO_MAX_FLOWS;
+		gro_flush_flow(tc, flow);
+	}
+
+	if (!gro_chksum_is_valid(pkt, &seg)) {
+		goto out;
+	}
+
+	gro_hold(flow, pkt, &seg);
+
+	return NET_OK;
+
+out:
+	net_pkt_cursor_init(pkt);
+
+	return NET_CONTINUE;
+}
+
+void net_tcp_gro_flush(int tc)
+{
+	struct gro_flow *flows = gro_flows[tc];
+
+	for (int i = 0; i < CONFIG_NET_TCP_GRO_MAX_FLOWS; i++) {
+		if (flows[i].pkt) {
+			gro_flush_flow(tc, &flows[i]);
+		}
+	}
+}
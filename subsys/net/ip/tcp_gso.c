@@ -0,0 +1,297 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * TCP generic segmentation offload.
+ *
+ * TCP hands a packet holding several full-sized segments to the IP layer,
+ * which builds and queues it once. The packet is cut into segments just
+ * before it is given to the L2, by copying the IP and TCP headers in front
+ * of the data of each segment. TCP copies the data of each segment to
+ * buffers of its own, so these buffers are moved to the segments instead
+ * of being copied.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include "net_private.h"
+#include "tcp_internal.h"
+
+#define GSO_ALLOC_TIMEOUT K_MSEC(CONFIG_NET_TCP_PKT_ALLOC_TIMEOUT)
+
+/* Check that the data of each segment starts on a buffer boundary */
+static bool gso_is_aligned(struct net_pkt *pkt, size_t hdr_len, size_t mss)
+{
+	size_t boundary = hdr_len;
+	size_t pos = 0;
+	struct net_buf *buf;
+
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		if (pos > boundary) {
+			return false;
+		}
+
+		if (pos == boundary) {
+			boundary += mss;
+		}
+
+		pos += buf->len;
+	}
+
+	return pos <= boundary;
+}
+
+/* Detach the first buffers of a chain, which hold len bytes */
+static struct net_buf *gso_buf_take(struct net_buf **head, size_t len)
+{
+	struct net_buf *first = *head;
+	struct net_buf *last = NULL;
+	struct net_buf *buf = first;
+
+	while (buf && len > 0) {
+		len -= MIN(len, buf->len);
+		last = buf;
+		buf = buf->frags;
+	}
+
+	if (last) {
+		last->frags = NULL;
+	}
+
+	*head = buf;
+
+	return first;
+}
+
+static void gso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == NET_AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == NET_AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+/* Update the headers copied to a segment for its place in the packet */
+static int gso_finalize(struct net_if *iface, struct net_pkt *seg, size_t ip_len,
+			uint32_t seq, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t len = net_pkt_get_len(seg);
+	enum net_if_checksum_type type;
+	struct tcphdr *th;
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == NET_AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(seg, &ipv4_access);
+		if (!ipv4_hdr) {
+			return -ENOBUFS;
+		}
+
+		ipv4_hdr->len = net_htons(len);
+		ipv4_hdr->chksum = 0U;
+
+		if (net_if_need_calc_tx_checksum(iface, NET_IF_CHECKSUM_IPV4_HEADER)) {
+			ipv4_hdr->chksum = net_calc_chksum_ipv4(seg);
+		}
+
+		type = NET_IF_CHECKSUM_IPV4_TCP;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == NET_AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
+		struct net_ipv6_hdr *ipv6_hdr;
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(seg, &ipv6_access);
+		if (!ipv6_hdr) {
+			return -ENOBUFS;
+		}
+
+		ipv6_hdr->len = net_htons(len - sizeof(struct net_ipv6_hdr));
+
+		type = NET_IF_CHECKSUM_IPV6_TCP;
+	} else {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (net_pkt_skip(seg, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!th) {
+		return -ENOBUFS;
+	}
+
+	UNALIGNED_PUT(net_htonl(seq), UNALIGNED_MEMBER_ADDR(th, th_seq));
+
+	/* Only the last segment ends the data */
+	if (!last) {
+		UNALIGNED_PUT(th_flags(th) & ~(FIN | PSH), UNALIGNED_MEMBER_ADDR(th, th_flags));
+	}
+
+	UNALIGNED_PUT(0U, UNALIGNED_MEMBER_ADDR(th, th_sum));
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		return -ENOBUFS;
+	}
+
+	if (net_if_need_calc_tx_checksum(iface, type)) {
+		uint16_t chksum = net_calc_chksum_tcp(seg);
+
+		net_pkt_cursor_init(seg);
+		net_pkt_skip(seg, ip_len);
+
+		th = (struct tcphdr *)net_pkt_get_data(seg, &tcp_access);
+		if (!th) {
+			return -ENOBUFS;
+		}
+
+		UNALIGNED_PUT(chksum, UNALIGNED_MEMBER_ADDR(th, th_sum));
+
+		if (net_pkt_set_data(seg, &tcp_access)) {
+			return -ENOBUFS;
+		}
+
+		net_pkt_set_chksum_done(seg, true);
+	}
+
+	net_pkt_set_overwrite(seg, false);
+	net_pkt_cursor_init(seg);
+
+	return 0;
+}
+
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	size_t mss = net_pkt_gso_size(pkt);
+	struct net_buf *data = NULL;
+	struct net_pkt_cursor data_cur = { 0 };
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	size_t hdr_len;
+	size_t data_len;
+	size_t seg_len;
+	size_t offset;
+	bool aligned;
+	uint32_t seq;
+	int sent = 0;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -EINVAL;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		return -EINVAL;
+	}
+
+	seq = th_seq(th);
+	hdr_len = ip_len + th_off(th) * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	aligned = gso_is_aligned(pkt, hdr_len, mss);
+	if (aligned) {
+		/* Keep only the headers in the packet */
+		data = pkt->buffer;
+		pkt->buffer = gso_buf_take(&data, hdr_len);
+	} else {
+		net_pkt_cursor_init(pkt);
+		net_pkt_skip(pkt, hdr_len);
+		net_pkt_cursor_backup(pkt, &data_cur);
+	}
+
+	for (offset = 0; offset < data_len; offset += seg_len) {
+		seg_len = MIN(data_len - offset, mss);
+
+		seg = net_pkt_alloc_with_buffer(iface, aligned ? hdr_len : hdr_len + seg_len,
+						NET_AF_UNSPEC, 0, GSO_ALLOC_TIMEOUT);
+		if (!seg) {
+			ret = -ENOMEM;
+			goto fail;
+		}
+
+		gso_copy_attributes(seg, pkt);
+
+		net_pkt_cursor_init(pkt);
+		ret = net_pkt_copy(seg, pkt, hdr_len);
+		if (ret < 0) {
+			goto fail_seg;
+		}
+
+		if (aligned) {
+			net_pkt_append_buffer(seg, gso_buf_take(&data, seg_len));
+		} else {
+			net_pkt_cursor_restore(pkt, &data_cur);
+			ret = net_pkt_copy(seg, pkt, seg_len);
+			if (ret < 0) {
+				goto fail_seg;
+			}
+
+			net_pkt_cursor_backup(pkt, &data_cur);
+		}
+
+		ret = gso_finalize(iface, seg, ip_len, seq + offset,
+				   offset + seg_len == data_len);
+		if (ret < 0) {
+			goto fail_seg;
+		}
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			goto fail_seg;
+		}
+
+		sent += ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+
+fail_seg:
+	net_pkt_unref(seg);
+fail:
+	NET_DBG("Cannot send segment at offset %zu (%d)", offset, ret);
+
+	if (data) {
+		net_buf_unref(data);
+	}
+
+	return ret;
+}
@@ -50,6 +50,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -512,6 +513,68 @@ static inline void net_tcp_close_all_for_iface(struct net_if *iface)
 }
 #endif
 
+/**
+ * @brief Cut a packet holding several TCP segments into these segments and
+ *        send them with the L2 of the network interface.
+ *
+ * @details The segments are net_pkt_gso_size() bytes long. The packet is
+ * released if all the segments were sent.
+ *
+ * @param iface Network interface to send the segments to.
+ * @param pkt Network packet built by TCP.
+ *
+ * @return Number of bytes sent by the L2 if ok, <0 if error.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Merge a received TCP segment with the previous in-order segments
+ *        of its connection.
+ *
+ * @details Only called from the RX traffic class threads, for packets
+ * which went through the L2. The merged segments are processed when
+ * net_tcp_gro_flush() is called.
+ *
+ * @param pkt Network packet received.
+ *
+ * @return NET_OK if the packet is held, NET_CONTINUE if it must be
+ *         processed now.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_CONTINUE;
+}
+#endif
+
+/**
+ * @brief Process the segments held by an RX traffic class thread.
+ *
+ * @param tc Traffic class of the calling RX thread.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(int tc);
+#else
+static inline void net_tcp_gro_flush(int tc)
+{
+	ARG_UNUSED(tc);
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -148,7 +148,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("[%p] total=%zd, unacked_len=%d, "		       \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                               \
 			(_conn), net_pkt_get_len(&(_conn)->send_data),         \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -229,26 +229,140 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* TCP header max options size */
+#define NET_TCP_OPTIONS_MAX_LEN 40
+
+/* Largest window scale factor, RFC 7323 ch 2.3 */
+#define NET_TCP_WINDOW_SCALE_MAX 14
+
+/* SACK blocks fitting in the options, without timestamps */
+#define NET_TCP_SACK_BLOCKS 4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t sack_cnt;
+	struct tcp_sack_block sack[NET_TCP_SACK_BLOCKS];
+#endif
 };
 
+/* Largest window that can be advertised */
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define TCP_WINDOW_MAX ((uint32_t)UINT16_MAX << NET_TCP_WINDOW_SCALE_MAX)
+#else
+#define TCP_WINDOW_MAX UINT16_MAX
+#endif
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+struct tcp;
+
+/* Longest name of a congestion control algorithm, with the terminating NUL */
+#define TCP_CONGESTION_NAME_MAX 16
+
+/* A congestion control algorithm. The loss recovery after a fast
+ * retransmit (RFC 6582) is common to all of them: on_ack is only called
+ * for the ACKs received out of it, and the window used during the recovery
+ * is the slow start threshold set by on_loss. An on_loss which does not
+ * reduce the window below cwnd keeps it through the recovery.
+ */
+struct tcp_congestion_ops {
+	const char *name;
+	/* Reset the algorithm state, cwnd and ssthresh are already set */
+	void (*init)(struct tcp *conn);
+	/* New data acknowledged, conn->seq is not updated yet */
+	void (*on_ack)(struct tcp *conn, uint32_t acked_len);
+	/* Fast retransmit, set ssthresh */
+	void (*on_loss)(struct tcp *conn);
+	/* Retransmission timeout, set ssthresh and cwnd */
+	void (*on_rto)(struct tcp *conn);
+};
+
+#define TCP_CONGESTION_DEFINE(_id, _name, _init, _on_ack, _on_loss, _on_rto)	\
+	static const STRUCT_SECTION_ITERABLE(tcp_congestion_ops,		\
+					     tcp_congestion_##_id) = {		\
+		.name = _name,							\
+		.init = _init,							\
+		.on_ack = _on_ack,						\
+		.on_loss = _on_loss,						\
+		.on_rto = _on_rto,						\
+	}
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+struct tcp_cubic {
+	uint32_t w_max;         /* Window before the last reduction, in bytes */
+	uint32_t w_est;         /* Reno friendly window, in bytes */
+	uint32_t origin;        /* Window at the plateau of the curve, in bytes */
+	uint32_t k;             /* Time to reach the plateau, in ms */
+	uint32_t epoch_start;   /* Start of the congestion avoidance, in ms */
+	bool in_epoch;
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+struct tcp_bbr {
+	uint32_t bw_max[2];     /* Delivery rate of the last two periods, bytes/s */
+	uint32_t full_bw;       /* Delivery rate when the pipe was last seen growing */
+	uint32_t min_rtt;       /* Shortest round trip, in ms */
+	uint32_t min_rtt_stamp; /* When min_rtt was measured, in ms */
+	uint32_t round_start;   /* Start of the round trip, in ms */
+	uint32_t round_end;     /* Sequence number ending the round trip */
+	uint32_t delivered;     /* Data acknowledged during the round trip */
+	uint32_t probe_rtt_end; /* End of the round trip time probe, in ms */
+	uint16_t rounds;
+	uint8_t full_bw_cnt;
+	uint8_t mode;
+	uint8_t cycle;
+};
+#endif
+
+struct tcp_congestion {
+	const struct tcp_congestion_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+	union {
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		struct tcp_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+		struct tcp_bbr bbr;
+#endif
+		uint8_t unused;
+	};
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Sender side SACK state: the data acknowledged by the peer above
+ * SND.UNA, sorted and merged, and the loss recovery in progress.
+ */
+struct tcp_sack_scoreboard {
+	struct tcp_sack_block blocks[NET_TCP_SACK_BLOCKS];
+	uint32_t recovery_point;
+	uint32_t high_rxt;
+	uint8_t cnt;
+	bool in_recovery;
 };
 #endif
 
@@ -326,20 +440,27 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_congestion ca;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_scoreboard sack;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t snd_wscale; /* Scale factor of the windows sent by the peer */
+	uint8_t rcv_wscale; /* Scale factor of the windows we send */
 #endif
 	uint8_t zwp_retries;
 	bool in_connect : 1;
@@ -350,6 +471,9 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
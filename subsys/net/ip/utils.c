@@ -27,6 +27,16 @@ LOG_MODULE_REGISTER(net_utils, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/socketcan.h>
 
+#include "net_private.h"
+
+#if defined(CONFIG_NET_CHKSUM_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define CHKSUM_SSE2 1
+#elif defined(CONFIG_NET_CHKSUM_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CHKSUM_NEON 1
+#endif
+
 char *net_sprint_addr(net_sa_family_t af, const void *addr)
 {
 #define NBUFS 3
@@ -569,6 +579,113 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+/* Sum the bulk of 4 byte aligned data into the accumulator, leaving less
+ * than 16 bytes in *pending for the 32-bit word loop of calc_chksum().
+ */
+#if defined(CHKSUM_SSE2)
+static inline uint64_t chksum_words(uint64_t sum, const uint8_t **data, size_t *pending)
+{
+	const uint8_t *p = *data;
+	size_t len = *pending;
+	__m128i zero = _mm_setzero_si128();
+	__m128i acc_lo = zero;
+	__m128i acc_hi = zero;
+	uint64_t lanes[2];
+
+	/* Widen the 32-bit words to 64-bit lanes, so no carry is lost */
+	while (len >= 16U) {
+		__m128i v = _mm_loadu_si128((const __m128i *)p);
+
+		acc_lo = _mm_add_epi64(acc_lo, _mm_unpacklo_epi32(v, zero));
+		acc_hi = _mm_add_epi64(acc_hi, _mm_unpackhi_epi32(v, zero));
+		p += 16;
+		len -= 16U;
+	}
+
+	_mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(acc_lo, acc_hi));
+
+	*data = p;
+	*pending = len;
+
+	return sum + lanes[0] + lanes[1];
+}
+#elif defined(CHKSUM_NEON)
+static inline uint64_t chksum_words(uint64_t sum, const uint8_t **data, size_t *pending)
+{
+	const uint8_t *p = *data;
+	size_t len = *pending;
+	uint64x2_t acc = vdupq_n_u64(0);
+
+	/* Pairwise add the 32-bit words into 64-bit lanes */
+	while (len >= 16U) {
+		acc = vpadalq_u32(acc, vld1q_u32((const uint32_t *)p));
+		p += 16;
+		len -= 16U;
+	}
+
+	*data = p;
+	*pending = len;
+
+	return sum + vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1);
+}
+#elif defined(CONFIG_64BIT)
+/* 64-bit one's complement addition, the carry is added back in */
+#define CHKSUM_ADD64(acc, word) \
+	do { (acc) += (word); (acc) += ((acc) < (word)); } while (false)
+
+static inline uint64_t chksum_words(uint64_t sum, const uint8_t **data, size_t *pending)
+{
+	const uint8_t *p = *data;
+	size_t len = *pending;
+	const uint64_t *w;
+	uint64_t sum_a = sum;
+	uint64_t sum_b = 0U;
+
+	if (len < 16U) {
+		return sum;
+	}
+
+	if (((uintptr_t)p & 0x04) != 0) {
+		sum_a += *((const uint32_t *)p);
+		p += sizeof(uint32_t);
+		len -= sizeof(uint32_t);
+	}
+
+	w = (const uint64_t *)p;
+
+	while (len >= sizeof(uint64_t) * 4) {
+		CHKSUM_ADD64(sum_a, w[0]);
+		CHKSUM_ADD64(sum_b, w[1]);
+		CHKSUM_ADD64(sum_a, w[2]);
+		CHKSUM_ADD64(sum_b, w[3]);
+		w += 4;
+		len -= sizeof(uint64_t) * 4;
+	}
+
+	while (len >= sizeof(uint64_t)) {
+		CHKSUM_ADD64(sum_a, *w);
+		w++;
+		len -= sizeof(uint64_t);
+	}
+
+	CHKSUM_ADD64(sum_a, sum_b);
+
+	*data = (const uint8_t *)w;
+	*pending = len;
+
+	/* Leave room for the 32-bit words still to be added */
+	return (sum_a & 0xffffffffU) + (sum_a >> 32);
+}
+#else
+static inline uint64_t chksum_words(uint64_t sum, const uint8_t **data, size_t *pending)
+{
+	ARG_UNUSED(data);
+	ARG_UNUSED(pending);
+
+	return sum;
+}
+#endif
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -604,6 +721,8 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+	sum = chksum_words(sum, &data, &pending);
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -647,37 +766,28 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 }
 
 #if defined(CONFIG_NET_NATIVE_IP)
-static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
+/* Sum len bytes from the cursor, the cursor is left in an unspecified state */
+static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum, size_t len)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
-	size_t len;
+	bool odd = false;
 
 	if (!cur->buf || !cur->pos) {
 		return sum;
 	}
 
-	len = cur->buf->len - (cur->pos - cur->buf->data);
+	while (cur->buf && len > 0) {
+		size_t chunk = MIN(len, cur->buf->len - (cur->pos - cur->buf->data));
+		uint16_t part = calc_chksum(0, cur->pos, chunk);
 
-	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+		/* A fragment starting at an odd offset sums byte swapped words */
+		sum = net_chksum_add(sum, odd ? BSWAP_16(part) : part);
+		odd ^= (chunk & 1) != 0;
+		len -= chunk;
 
 		cur->buf = cur->buf->frags;
-		if (!cur->buf || !cur->buf->len) {
-			break;
-		}
-
-		cur->pos = cur->buf->data;
-
-		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
-
-			cur->pos++;
-			len = cur->buf->len - 1;
-		} else {
-			len = cur->buf->len;
+		if (cur->buf) {
+			cur->pos = cur->buf->data;
 		}
 	}
 
@@ -687,29 +797,39 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 {
 	size_t len = 0U;
+	size_t data_len;
+	size_t acc_len = 0U;
+	uint16_t acc = 0U;
 	uint16_t sum = 0U;
 	struct net_pkt_cursor backup;
 	bool ow;
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == NET_AF_INET) {
+		data_len = net_pkt_get_len(pkt) -
+			net_pkt_ip_hdr_len(pkt) -
+			net_pkt_ipv4_opts_len(pkt);
 		if (proto != NET_IPPROTO_ICMP && proto != NET_IPPROTO_IGMP) {
 			len = 2 * sizeof(struct net_in_addr);
-			sum = net_pkt_get_len(pkt) -
-				net_pkt_ip_hdr_len(pkt) -
-				net_pkt_ipv4_opts_len(pkt) + proto;
+			sum = data_len + proto;
 		}
 	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
 		   net_pkt_family(pkt) == NET_AF_INET6) {
 		len = 2 * sizeof(struct net_in6_addr);
-		sum =  net_pkt_get_len(pkt) -
+		data_len = net_pkt_get_len(pkt) -
 			net_pkt_ip_hdr_len(pkt) -
-			net_pkt_ipv6_ext_len(pkt) + proto;
+			net_pkt_ipv6_ext_len(pkt);
+		sum = data_len + proto;
 	} else {
 		NET_DBG("Unknown protocol family %d", net_pkt_family(pkt));
 		return 0;
 	}
 
+	/* The payload summed while it was written needs not be read again */
+	if (net_pkt_chksum_acc_get(pkt, &acc, &acc_len) && acc_len > data_len) {
+		acc_len = 0U;
+	}
+
 	net_pkt_cursor_backup(pkt, &backup);
 	net_pkt_cursor_init(pkt);
 
@@ -721,7 +841,11 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	sum = pkt_calc_chksum(pkt, sum, data_len - acc_len);
+
+	if (acc_len > 0U) {
+		sum = net_chksum_add(sum, ((data_len - acc_len) & 1) ? BSWAP_16(acc) : acc);
+	}
 
 	sum = (sum == 0U) ? 0xffff : net_htons(sum);
 
@@ -164,11 +164,18 @@ int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 		LOG_DBG("histogram->count: %lu", histogram->count);
 
 		for (int i = 0; i < histogram->num_buckets; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-				histogram->buckets[i].upper_bound,
-				histogram->buckets[i].count);
+			if (histogram->buckets[i].upper_bound == PROMETHEUS_HISTOGRAM_INF) {
+				ret = write_metric_to_buffer(
+					buffer + *written, buffer_size - *written,
+					"%s_bucket{le=\"+Inf\"} %lu\n", metric->name,
+					histogram->buckets[i].count);
+			} else {
+				ret = write_metric_to_buffer(
+					buffer + *written, buffer_size - *written,
+					"%s_bucket{le=\"%f\"} %lu\n", metric->name,
+					histogram->buckets[i].upper_bound,
+					histogram->buckets[i].count);
+			}
 			if (ret < 0) {
 				LOG_ERR("Error writing histogram");
 				goto out;
@@ -0,0 +1,87 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net/prometheus/sched.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(pm_sched, CONFIG_PROMETHEUS_LOG_LEVEL);
+
+#define NUM_BUCKETS CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS
+
+static double cycles_per_sec(void)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
+	return (double)timing_freq_get();
+#else
+	return (double)sys_clock_hw_cycles_per_sec();
+#endif /* CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS */
+}
+
+int prometheus_sched_histogram_set(struct prometheus_histogram *histogram,
+				   const struct k_cycle_histogram *hist)
+{
+	unsigned long count = 0;
+	double freq;
+
+	if ((histogram == NULL) || (hist == NULL)) {
+		return -EINVAL;
+	}
+
+	if ((histogram->buckets == NULL) || (histogram->num_buckets != NUM_BUCKETS)) {
+		LOG_ERR("Histogram %s cannot hold %d buckets", histogram->base.name,
+			NUM_BUCKETS);
+		return -EINVAL;
+	}
+
+	freq = cycles_per_sec();
+
+	/*
+	 * Kernel buckets count the durations of 2^N to 2^(N+1)-1 cycles,
+	 * Prometheus ones are cumulative.
+	 */
+	for (int i = 0; i < NUM_BUCKETS; i++) {
+		count += hist->buckets[i];
+		histogram->buckets[i].upper_bound = (double)(BIT64(i + 1) - 1) / freq;
+		histogram->buckets[i].count = count;
+	}
+
+	/* The last bucket holds every longer duration */
+	histogram->buckets[NUM_BUCKETS - 1].upper_bound = PROMETHEUS_HISTOGRAM_INF;
+
+	histogram->count = count;
+	histogram->sum = (double)hist->sum / freq;
+
+	return 0;
+}
+
+int prometheus_sched_thread_update(k_tid_t thread,
+				   struct prometheus_histogram *wakeup_latency,
+				   struct prometheus_histogram *run_length)
+{
+	k_thread_runtime_stats_t stats;
+	int ret;
+
+	ret = k_thread_runtime_stats_get(thread, &stats);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (wakeup_latency != NULL) {
+		ret = prometheus_sched_histogram_set(wakeup_latency, &stats.wakeup_latency);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (run_length != NULL) {
+		ret = prometheus_sched_histogram_set(run_length, &stats.run_length);
+	}
+
+	return ret;
+}
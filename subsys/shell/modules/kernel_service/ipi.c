@@ -0,0 +1,79 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/obj_core.h>
+
+struct ipi_walk_data {
+	const struct shell *sh;
+	unsigned int cpu;
+	bool reset;
+};
+
+static int ipi_stats_print(struct k_obj_core *obj_core, void *data)
+{
+	struct ipi_walk_data *walk = data;
+	struct k_ipi_stats stats;
+	int err;
+
+	if (walk->reset) {
+		err = k_obj_core_stats_reset(obj_core);
+	} else {
+		err = k_obj_core_stats_raw(obj_core, &stats, sizeof(stats));
+	}
+
+	if (err != 0) {
+		shell_error(walk->sh, "Failed to access CPU %u IPI statistics (err %d)",
+			    walk->cpu, err);
+	} else if (!walk->reset) {
+		shell_print(walk->sh, "%3u %12llu %12llu %12llu %12llu %12llu", walk->cpu,
+			    stats.sent, stats.coalesced, stats.received, stats.useful,
+			    stats.wasted);
+	}
+
+	walk->cpu++;
+
+	return 0;
+}
+
+static int cmd_kernel_ipi(const struct shell *sh, size_t argc, char **argv)
+{
+	struct ipi_walk_data walk = {
+		.sh = sh,
+	};
+	struct k_obj_type *type;
+
+	if (argc > 1) {
+		if (strcmp("-r", argv[1]) && strcmp("--reset", argv[1]) != 0) {
+			shell_error(sh, "Unsupported option: %s", argv[1]);
+			return -EIO;
+		}
+		walk.reset = true;
+	}
+
+	type = k_obj_type_find(K_OBJ_TYPE_IPI_ID);
+	if (type == NULL) {
+		shell_error(sh, "IPI statistics not available");
+		return -ENOEXEC;
+	}
+
+	if (!walk.reset) {
+		shell_print(sh, "CPU         sent    coalesced     received       useful       wasted");
+	}
+
+	/* IPI objects are linked in CPU order */
+	k_obj_type_walk_unlocked(type, ipi_stats_print, &walk);
+
+	return 0;
+}
+
+KERNEL_CMD_ARG_ADD(ipi, NULL,
+		   "Scheduler IPI statistics per CPU. Can be called with the -r or --reset "
+		   "option to clear them",
+		   cmd_kernel_ipi, 1, 1);
@@ -325,6 +325,18 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_mutex_unlock_exit(mutex, ret)                                             \
 	SEGGER_SYSVIEW_RecordEndCallU32(TID_MUTEX_UNLOCK, (uint32_t)ret)
 
+#define sys_port_trace_k_rwlock_init(rwlock)
+#define sys_port_trace_k_rwlock_read_lock_enter(rwlock, timeout)
+#define sys_port_trace_k_rwlock_read_lock_blocking(rwlock, timeout)
+#define sys_port_trace_k_rwlock_read_lock_exit(rwlock, timeout, ret)
+#define sys_port_trace_k_rwlock_write_lock_enter(rwlock, timeout)
+#define sys_port_trace_k_rwlock_write_lock_blocking(rwlock, timeout)
+#define sys_port_trace_k_rwlock_write_lock_exit(rwlock, timeout, ret)
+#define sys_port_trace_k_rwlock_read_unlock_enter(rwlock)
+#define sys_port_trace_k_rwlock_read_unlock_exit(rwlock, ret)
+#define sys_port_trace_k_rwlock_write_unlock_enter(rwlock)
+#define sys_port_trace_k_rwlock_write_unlock_exit(rwlock, ret)
+
 #define sys_port_trace_k_condvar_init(condvar, ret)                                                \
 	SEGGER_SYSVIEW_RecordU32(TID_CONDVAR_INIT, (uint32_t)(uintptr_t)condvar)
 
@@ -526,6 +538,18 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_stack_pop_exit(stack, timeout, ret)                                       \
 	SEGGER_SYSVIEW_RecordEndCall(TID_STACK_POP)
 
+#define sys_port_trace_k_mpmcq_init(mpmcq)
+#define sys_port_trace_k_mpmcq_alloc_init_enter(mpmcq)
+#define sys_port_trace_k_mpmcq_alloc_init_exit(mpmcq, ret)
+#define sys_port_trace_k_mpmcq_cleanup_enter(mpmcq)
+#define sys_port_trace_k_mpmcq_cleanup_exit(mpmcq, ret)
+#define sys_port_trace_k_mpmcq_put_enter(mpmcq, timeout)
+#define sys_port_trace_k_mpmcq_put_blocking(mpmcq, timeout)
+#define sys_port_trace_k_mpmcq_put_exit(mpmcq, timeout, ret)
+#define sys_port_trace_k_mpmcq_get_enter(mpmcq, timeout)
+#define sys_port_trace_k_mpmcq_get_blocking(mpmcq, timeout)
+#define sys_port_trace_k_mpmcq_get_exit(mpmcq, timeout, ret)
+
 #define sys_port_trace_k_msgq_init(msgq)                                                           \
 	SEGGER_SYSVIEW_RecordU32(TID_MSGQ_INIT, (uint32_t)(uintptr_t)msgq)
 
@@ -556,6 +580,10 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_msgq_put_front_exit(msgq, timeout, ret)                                   \
 	SEGGER_SYSVIEW_RecordEndCall(TID_MSGQ_PUT_FRONT)
 
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)                                             \
 	SEGGER_SYSVIEW_RecordU32x2(TID_MSGQ_GET, (uint32_t)(uintptr_t)msgq, (uint32_t)timeout.ticks)
 
@@ -564,6 +592,10 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)                                         \
 	SEGGER_SYSVIEW_RecordEndCall(TID_MSGQ_GET)
 
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
+
 #define sys_port_trace_k_msgq_peek(msgq, ret)                                                      \
 	SEGGER_SYSVIEW_RecordU32(TID_MSGQ_PEEK, (uint32_t)(uintptr_t)msgq)
 
@@ -249,6 +249,18 @@ void sys_trace_rtio_chain_next_exit(const struct rtio *r, const struct rtio_iode
 #define sys_port_trace_k_mutex_unlock_enter(mutex)
 #define sys_port_trace_k_mutex_unlock_exit(mutex, ret)
 
+#define sys_port_trace_k_rwlock_init(rwlock)
+#define sys_port_trace_k_rwlock_read_lock_enter(rwlock, timeout)
+#define sys_port_trace_k_rwlock_read_lock_blocking(rwlock, timeout)
+#define sys_port_trace_k_rwlock_read_lock_exit(rwlock, timeout, ret)
+#define sys_port_trace_k_rwlock_write_lock_enter(rwlock, timeout)
+#define sys_port_trace_k_rwlock_write_lock_blocking(rwlock, timeout)
+#define sys_port_trace_k_rwlock_write_lock_exit(rwlock, timeout, ret)
+#define sys_port_trace_k_rwlock_read_unlock_enter(rwlock)
+#define sys_port_trace_k_rwlock_read_unlock_exit(rwlock, ret)
+#define sys_port_trace_k_rwlock_write_unlock_enter(rwlock)
+#define sys_port_trace_k_rwlock_write_unlock_exit(rwlock, ret)
+
 #define sys_port_trace_k_condvar_init(condvar, ret)
 #define sys_port_trace_k_condvar_signal_enter(condvar)
 #define sys_port_trace_k_condvar_signal_blocking(condvar, timeout)
@@ -327,6 +339,18 @@ void sys_trace_rtio_chain_next_exit(const struct rtio *r, const struct rtio_iode
 #define sys_port_trace_k_stack_pop_blocking(stack, timeout)
 #define sys_port_trace_k_stack_pop_exit(stack, timeout, ret)
 
+#define sys_port_trace_k_mpmcq_init(mpmcq)
+#define sys_port_trace_k_mpmcq_alloc_init_enter(mpmcq)
+#define sys_port_trace_k_mpmcq_alloc_init_exit(mpmcq, ret)
+#define sys_port_trace_k_mpmcq_cleanup_enter(mpmcq)
+#define sys_port_trace_k_mpmcq_cleanup_exit(mpmcq, ret)
+#define sys_port_trace_k_mpmcq_put_enter(mpmcq, timeout)
+#define sys_port_trace_k_mpmcq_put_blocking(mpmcq, timeout)
+#define sys_port_trace_k_mpmcq_put_exit(mpmcq, timeout, ret)
+#define sys_port_trace_k_mpmcq_get_enter(mpmcq, timeout)
+#define sys_port_trace_k_mpmcq_get_blocking(mpmcq, timeout)
+#define sys_port_trace_k_mpmcq_get_exit(mpmcq, timeout, ret)
+
 #define sys_port_trace_k_msgq_init(msgq)
 #define sys_port_trace_k_msgq_alloc_init_enter(msgq)
 #define sys_port_trace_k_msgq_alloc_init_exit(msgq, ret)
@@ -338,9 +362,15 @@ void sys_trace_rtio_chain_next_exit(const struct rtio *r, const struct rtio_iode
 #define sys_port_trace_k_msgq_put_front_enter(msgq, timeout)
 #define sys_port_trace_k_msgq_put_front_blocking(msgq, timeout)
 #define sys_port_trace_k_msgq_put_front_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)
 #define sys_port_trace_k_msgq_get_blocking(msgq, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)
 
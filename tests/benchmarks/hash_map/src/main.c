@@ -0,0 +1,163 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of inserting, looking up
+ * and removing entries of the sys_hashmap implementations, as well as the
+ * memory they use per entry.
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_ENTRIES CONFIG_BENCHMARK_NUM_ENTRIES
+
+/* Room in front of allocations for their size, keeping them aligned */
+#define ALLOC_HDR_SIZE 16
+
+/* Memory currently allocated by the maps */
+static size_t allocated;
+
+static void *counting_alloc(void *ptr, size_t size)
+{
+	size_t old_size = 0;
+
+	if (ptr != NULL) {
+		ptr = (uint8_t *)ptr - ALLOC_HDR_SIZE;
+		old_size = *(size_t *)ptr;
+	}
+
+	if (size == 0) {
+		free(ptr);
+		allocated -= old_size;
+		return NULL;
+	}
+
+	ptr = realloc(ptr, size + ALLOC_HDR_SIZE);
+	if (ptr == NULL) {
+		return NULL;
+	}
+
+	allocated += size - old_size;
+	*(size_t *)ptr = size;
+
+	return (uint8_t *)ptr + ALLOC_HDR_SIZE;
+}
+
+SYS_HASHMAP_SC_DEFINE_STATIC_ADVANCED(sc_map, sys_hash32, counting_alloc,
+				      SYS_HASHMAP_CONFIG(SIZE_MAX,
+							 SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+SYS_HASHMAP_OA_LP_DEFINE_STATIC_ADVANCED(oa_lp_map, sys_hash32, counting_alloc,
+					 SYS_HASHMAP_CONFIG(SIZE_MAX,
+							    SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+SYS_HASHMAP_SWISS_DEFINE_STATIC_ADVANCED(swiss_map, sys_hash32, counting_alloc,
+					 SYS_HASHMAP_CONFIG(SIZE_MAX,
+							    SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+static const struct {
+	const char *name;
+	struct sys_hashmap *map;
+} maps[] = {
+	{ "sc", &sc_map },
+	{ "oa_lp", &oa_lp_map },
+	{ "swiss", &swiss_map },
+};
+
+/* Spread keys over the whole key space */
+static inline uint64_t key_of(uint32_t i)
+{
+	return i * 0x9e3779b97f4a7c15ULL;
+}
+
+static void report(const char *map_name, const char *op, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%s - %s, per operation"
+	       " : %7llu cycles , %7u ns :\n",
+	       map_name, op, op, cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("    %-12s: %7llu cycles (%7u nsec)\n", op, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static int test_map(const char *name, struct sys_hashmap *map)
+{
+	timing_t start;
+	timing_t finish;
+	uint64_t value;
+	int errors = 0;
+
+#ifndef CONFIG_BENCHMARK_RECORDING
+	printk("------------------------------------\n");
+	printk("%s, %u entries\n", name, NUM_ENTRIES);
+#endif
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ENTRIES; i++) {
+		errors += sys_hashmap_insert(map, key_of(i), i, NULL) != 1;
+	}
+	finish = timing_counter_get();
+	report(name, "insert", timing_cycles_get(&start, &finish) / NUM_ENTRIES);
+
+	printk("%s: %zu bytes per entry\n", name, allocated / NUM_ENTRIES);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ENTRIES; i++) {
+		errors += !sys_hashmap_get(map, key_of(i), &value);
+	}
+	finish = timing_counter_get();
+	report(name, "lookup_hit", timing_cycles_get(&start, &finish) / NUM_ENTRIES);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ENTRIES; i++) {
+		errors += sys_hashmap_get(map, key_of(NUM_ENTRIES + i), &value);
+	}
+	finish = timing_counter_get();
+	report(name, "lookup_miss", timing_cycles_get(&start, &finish) / NUM_ENTRIES);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ENTRIES; i++) {
+		errors += !sys_hashmap_remove(map, key_of(i), NULL);
+	}
+	finish = timing_counter_get();
+	report(name, "remove", timing_cycles_get(&start, &finish) / NUM_ENTRIES);
+
+	sys_hashmap_clear(map, NULL, NULL);
+
+	if (errors != 0) {
+		printk("%s: %d operations failed\n", name, errors);
+	}
+
+	return errors;
+}
+
+int main(void)
+{
+	int errors = 0;
+
+	timing_init();
+
+	printk("Time Measurements for hashmap operations with %u entries\n", NUM_ENTRIES);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (size_t i = 0; i < ARRAY_SIZE(maps); i++) {
+		errors += test_map(maps[i].name, maps[i].map);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(errors == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
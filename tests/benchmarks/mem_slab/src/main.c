@@ -0,0 +1,150 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure memory slab allocation and free
+ * throughput while an increasing number of threads allocates from the
+ * same slab. Allocations never wait, so the measurements cover the path
+ * taken when no thread has to pend on the slab.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS CONFIG_BENCHMARK_NUM_THREADS
+#define BATCH_SIZE  CONFIG_BENCHMARK_BATCH_SIZE
+#define BLOCK_SIZE  64
+
+/* Lower than main(), so that main() can set up every thread first */
+#define WORKER_PRIO (K_LOWEST_APPLICATION_THREAD_PRIO - 1)
+
+K_MEM_SLAB_DEFINE_STATIC(slab, BLOCK_SIZE, NUM_THREADS * BATCH_SIZE, sizeof(void *));
+
+struct worker {
+	uint64_t cycles;
+	unsigned int failures;
+};
+
+static struct worker workers[NUM_THREADS];
+static struct k_thread threads[NUM_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+
+static void worker_thread(void *p1, void *p2, void *p3)
+{
+	struct worker *worker = p1;
+	void *blocks[BATCH_SIZE];
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		for (unsigned int j = 0; j < BATCH_SIZE; j++) {
+			if (k_mem_slab_alloc(&slab, &blocks[j], K_NO_WAIT) != 0) {
+				worker->failures++;
+				blocks[j] = NULL;
+			}
+		}
+
+		for (unsigned int j = 0; j < BATCH_SIZE; j++) {
+			if (blocks[j] != NULL) {
+				k_mem_slab_free(&slab, blocks[j]);
+			}
+		}
+	}
+
+	finish = timing_counter_get();
+
+	worker->cycles = timing_cycles_get(&start, &finish);
+}
+
+static void report(unsigned int num_threads, uint64_t per_block, uint64_t total)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: mem_slab.alloc_free.%u - Alloc and free with %u threads, avg. :"
+	       " %7llu cycles , %7u ns :\n",
+	       num_threads, num_threads, per_block, (uint32_t)timing_cycles_to_ns(per_block));
+	printk("REC: mem_slab.total.%u - All threads done with %u threads :"
+	       " %7llu cycles , %7u ns :\n",
+	       num_threads, num_threads, total, (uint32_t)timing_cycles_to_ns(total));
+#else
+	printk("------------------------------------\n");
+	printk("%u threads allocating from one slab\n", num_threads);
+
+	printk("    Alloc and free : %7llu cycles (%7u nsec)\n", per_block,
+	       (uint32_t)timing_cycles_to_ns(per_block));
+	printk("    All threads    : %7llu cycles (%7u nsec)\n", total,
+	       (uint32_t)timing_cycles_to_ns(total));
+#endif
+}
+
+static int test_threads(unsigned int num_threads)
+{
+	uint64_t cycles = 0;
+	unsigned int failures = 0;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		workers[i] = (struct worker) {};
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker_thread,
+				&workers[i], NULL, NULL, WORKER_PRIO, 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		cycles += workers[i].cycles;
+		failures += workers[i].failures;
+	}
+
+	finish = timing_counter_get();
+
+	if (failures != 0) {
+		printk("%u allocations failed with %u threads\n", failures, num_threads);
+		return TC_FAIL;
+	}
+
+	report(num_threads,
+	       cycles / ((uint64_t)num_threads * CONFIG_BENCHMARK_NUM_ITERATIONS * BATCH_SIZE),
+	       timing_cycles_get(&start, &finish));
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int rc = TC_PASS;
+
+	timing_init();
+
+	printk("Time Measurements for %s memory slabs\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_LOCKLESS) ? "lockless" : "locked");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int n = 1; (n <= NUM_THREADS) && (rc == TC_PASS); n++) {
+		rc = test_threads(n);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(rc);
+
+	return 0;
+}
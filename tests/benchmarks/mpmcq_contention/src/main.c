@@ -0,0 +1,167 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of passing items through a
+ * k_mpmcq and through a k_fifo, shared by a growing number of producer and
+ * consumer threads. The time from the start of the threads until all items
+ * have been got is measured.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MAX_THREADS CONFIG_BENCHMARK_MAX_THREADS
+#define NUM_ITEMS CONFIG_BENCHMARK_NUM_ITEMS
+
+/* Lower priority than main, so that all threads are started before any runs */
+#define THREADS_PRIORITY K_PRIO_PREEMPT(1)
+
+struct item {
+	void *fifo_reserved;
+	uint32_t value;
+};
+
+enum queue_type {
+	QUEUE_MPMCQ,
+	QUEUE_FIFO,
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[2 * MAX_THREADS];
+
+static struct item items[MAX_THREADS][NUM_ITEMS];
+
+K_MPMCQ_DEFINE(mpmcq, CONFIG_BENCHMARK_QUEUE_LEN);
+K_FIFO_DEFINE(fifo);
+
+static volatile uint32_t checksum;
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	enum queue_type type = (enum queue_type)(uintptr_t)p1;
+	struct item *own = p2;
+
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < NUM_ITEMS; i++) {
+		if (type == QUEUE_MPMCQ) {
+			(void)k_mpmcq_put(&mpmcq, (uintptr_t)&own[i], K_FOREVER);
+		} else {
+			k_fifo_put(&fifo, &own[i]);
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	enum queue_type type = (enum queue_type)(uintptr_t)p1;
+	unsigned int count = (unsigned int)(uintptr_t)p2;
+	struct item *item;
+	uintptr_t data;
+	uint32_t sum = 0;
+
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < count; i++) {
+		if (type == QUEUE_MPMCQ) {
+			(void)k_mpmcq_get(&mpmcq, &data, K_FOREVER);
+			item = (struct item *)data;
+		} else {
+			item = k_fifo_get(&fifo, K_FOREVER);
+		}
+		sum += item->value;
+	}
+
+	checksum += sum;
+}
+
+static void report(enum queue_type type, unsigned int num_threads, uint64_t cycles)
+{
+	const char *name = (type == QUEUE_MPMCQ) ? "mpmcq" : "fifo";
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%02u - %u producer(s) and consumer(s), per item"
+	       " : %7llu cycles , %7u ns :\n",
+	       name, num_threads, num_threads, cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("------------------------------------\n");
+	printk("%s, %u producer(s) and consumer(s)\n", name, num_threads);
+
+	printk("    Per item : %7llu cycles (%7u nsec)\n", cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static void test_contention(enum queue_type type, unsigned int num_threads)
+{
+	unsigned int count = num_threads * NUM_ITEMS;
+	timing_t start;
+	timing_t finish;
+	int n = 0;
+
+	checksum = 0;
+
+	for (unsigned int i = 0; i < num_threads; i++, n++) {
+		k_thread_create(&threads[n], stacks[n], STACK_SIZE, consumer,
+				(void *)(uintptr_t)type, (void *)(uintptr_t)(count / num_threads),
+				NULL, THREADS_PRIORITY, 0, K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < num_threads; i++, n++) {
+		k_thread_create(&threads[n], stacks[n], STACK_SIZE, producer,
+				(void *)(uintptr_t)type, items[i], NULL,
+				THREADS_PRIORITY, 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < n; i++) {
+		k_thread_start(&threads[i]);
+	}
+	for (int i = 0; i < n; i++) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+	}
+	finish = timing_counter_get();
+
+	if (checksum != num_threads * (NUM_ITEMS * (NUM_ITEMS - 1) / 2)) {
+		printk("Items lost or duplicated, checksum %u\n", checksum);
+	}
+
+	report(type, num_threads, timing_cycles_get(&start, &finish) / count);
+}
+
+int main(void)
+{
+	BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_BENCHMARK_QUEUE_LEN));
+
+	timing_init();
+
+	printk("Time Measurements for MPMC queues and FIFOs with up to %u producers"
+	       " and consumers on %u CPU(s)\n", MAX_THREADS, arch_num_cpus());
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	for (unsigned int t = 0; t < MAX_THREADS; t++) {
+		for (unsigned int i = 0; i < NUM_ITEMS; i++) {
+			items[t][i].value = i;
+		}
+	}
+
+	timing_start();
+
+	for (unsigned int n = 1; n <= MAX_THREADS; n *= 2) {
+		test_contention(QUEUE_MPMCQ, n);
+		test_contention(QUEUE_FIFO, n);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
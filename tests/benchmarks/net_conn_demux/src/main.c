@@ -0,0 +1,197 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of finding the connection
+ * handler of a received UDP packet, for a growing number of handlers.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include "connection.h"
+
+#define ITERATIONS CONFIG_BENCHMARK_ITERATIONS
+#define MAX_CONN   CONFIG_NET_MAX_CONN
+
+/* Bound handlers use ports from BOUND_PORT, connected ones share SERVER_PORT */
+#define BOUND_PORT  10000U
+#define SERVER_PORT 80U
+#define CLIENT_PORT 20000U
+#define FREE_PORT   9999U
+
+#if defined(CONFIG_NET_CONN_HASH_BUCKETS) && (CONFIG_NET_CONN_HASH_BUCKETS > 0)
+#define LOOKUP_NAME "hash"
+#else
+#define LOOKUP_NAME "list"
+#endif
+
+static struct net_conn_handle *handles[MAX_CONN];
+static unsigned int hits;
+
+static struct net_ipv4_hdr ipv4_hdr = {
+	.src = { 192, 0, 2, 2 },
+	.dst = { 192, 0, 2, 1 },
+};
+
+static struct net_udp_hdr udp_hdr;
+
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	hits++;
+
+	/* Keep the packet, it is used again for the next lookup */
+	return NET_OK;
+}
+
+static void report(const char *op, uint32_t num_conns, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%s.%u - %s, %u handlers, per packet"
+	       " : %7llu cycles , %7u ns :\n",
+	       LOOKUP_NAME, op, num_conns, op, num_conns, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	ARG_UNUSED(num_conns);
+
+	printk("    %-10s: %7llu cycles (%7u nsec)\n", op, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static int register_conns(uint32_t num_conns)
+{
+	struct net_sockaddr_in remote = {
+		.sin_family = NET_AF_INET,
+		.sin_addr = { { { 192, 0, 2, 2 } } },
+	};
+	int ret;
+
+	for (uint32_t i = 0; i < num_conns; i++) {
+		if ((i % 2U) == 0U) {
+			ret = net_conn_register(NET_IPPROTO_UDP, NET_SOCK_DGRAM, NET_AF_INET,
+						NULL, NULL, 0, BOUND_PORT + (i / 2U), NULL,
+						conn_cb, NULL, &handles[i]);
+		} else {
+			ret = net_conn_register(NET_IPPROTO_UDP, NET_SOCK_DGRAM, NET_AF_INET,
+						(struct net_sockaddr *)&remote, NULL,
+						CLIENT_PORT + (i / 2U), SERVER_PORT, NULL,
+						conn_cb, NULL, &handles[i]);
+		}
+
+		if (ret < 0) {
+			printk("Cannot register handler %u (%d)\n", i, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void unregister_conns(uint32_t num_conns)
+{
+	for (uint32_t i = 0; i < num_conns; i++) {
+		(void)net_conn_unregister(handles[i]);
+	}
+}
+
+/* Time the lookup of packets from and to the given ports */
+static uint64_t time_input(struct net_pkt *pkt, uint16_t src_port, uint16_t dst_port,
+			   enum net_verdict expected, int *errors)
+{
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4_hdr };
+	union net_proto_header proto_hdr = { .udp = &udp_hdr };
+	timing_t start;
+	timing_t finish;
+
+	udp_hdr.src_port = net_htons(src_port);
+	udp_hdr.dst_port = net_htons(dst_port);
+	hits = 0U;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < ITERATIONS; i++) {
+		*errors += net_conn_input(pkt, &ip_hdr, NET_IPPROTO_UDP, &proto_hdr) != expected;
+	}
+	finish = timing_counter_get();
+
+	*errors += hits != ((expected == NET_OK) ? ITERATIONS : 0U);
+
+	return timing_cycles_get(&start, &finish) / ITERATIONS;
+}
+
+static int test_demux(struct net_pkt *pkt, uint32_t num_conns)
+{
+	uint32_t last_pair = (num_conns / 2U) - 1U;
+	int errors = 0;
+
+#ifndef CONFIG_BENCHMARK_RECORDING
+	printk("------------------------------------\n");
+	printk("%s lookup, %u handlers\n", LOOKUP_NAME, num_conns);
+#endif
+
+	if (register_conns(num_conns) < 0) {
+		return 1;
+	}
+
+	/* Without hashing, all the handlers are searched for the best match */
+	report("bound", num_conns,
+	       time_input(pkt, CLIENT_PORT, BOUND_PORT + last_pair, NET_OK, &errors));
+	report("connected", num_conns,
+	       time_input(pkt, CLIENT_PORT + last_pair, SERVER_PORT, NET_OK, &errors));
+	report("miss", num_conns,
+	       time_input(pkt, CLIENT_PORT, FREE_PORT, NET_DROP, &errors));
+
+	unregister_conns(num_conns);
+
+	return errors;
+}
+
+int main(void)
+{
+	struct net_pkt *pkt;
+	int errors = 0;
+
+	timing_init();
+
+	pkt = net_pkt_rx_alloc(K_FOREVER);
+	net_pkt_set_family(pkt, NET_AF_INET);
+	net_pkt_set_iface(pkt, net_if_get_default());
+
+	printk("Time Measurements for UDP connection handler lookup with up to %u handlers\n",
+	       MAX_CONN);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (uint32_t n = 8; n <= MAX_CONN; n *= 2) {
+		errors += test_demux(pkt, n);
+	}
+
+	timing_stop();
+
+	net_pkt_unref(pkt);
+
+	if (errors != 0) {
+		printk("%d lookups failed\n", errors);
+	}
+
+	TC_END_REPORT(errors == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
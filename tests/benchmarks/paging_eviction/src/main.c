@@ -0,0 +1,132 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure how well the demand paging eviction
+ * algorithm keeps a working set in memory, while large buffers are scanned.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define ROUNDS     CONFIG_BENCHMARK_ROUNDS
+#define HOT_PASSES CONFIG_BENCHMARK_HOT_PASSES
+#define PAGE_SIZE  CONFIG_MMU_PAGE_SIZE
+
+/* Data pages beyond free memory, kept in the backing store */
+#define EXTRA_PAGES (CONFIG_BACKING_STORE_RAM_PAGES - 1)
+
+#if defined(CONFIG_EVICTION_CLOCK_PRO)
+#define EVICTION_NAME "clock_pro"
+#elif defined(CONFIG_EVICTION_LRU)
+#define EVICTION_NAME "lru"
+#elif defined(CONFIG_EVICTION_NRU)
+#define EVICTION_NAME "nru"
+#else
+#define EVICTION_NAME "custom"
+#endif
+
+static volatile uint8_t *arena;
+static size_t hot_pages;
+static size_t cold_pages;
+
+static inline void touch(size_t page)
+{
+	arena[page * PAGE_SIZE]++;
+}
+
+static unsigned long replay(void)
+{
+	unsigned long accesses = 0;
+
+	for (unsigned int round = 0; round < ROUNDS; round++) {
+		for (unsigned int pass = 0; pass < HOT_PASSES; pass++) {
+			for (size_t i = 0; i < hot_pages; i++) {
+				touch(i);
+			}
+		}
+
+		for (size_t i = 0; i < cold_pages; i++) {
+			touch(hot_pages + i);
+		}
+
+		accesses += (HOT_PASSES * hot_pages) + cold_pages;
+	}
+
+	return accesses;
+}
+
+static void report(unsigned long accesses, uint64_t cycles,
+		   const struct k_mem_paging_stats_t *stats)
+{
+	unsigned int hit_ratio = k_mem_paging_stats_hit_ratio(stats, accesses);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.replay - mixed working set, per access"
+	       " : %7llu cycles , %7u ns :\n",
+	       EVICTION_NAME, cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("    Per access  : %7llu cycles (%7u nsec)\n", cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+
+	printk("%s: %lu accesses, %lu page faults, %lu refaults, hit ratio %u.%u%%\n",
+	       EVICTION_NAME, accesses, stats->pagefaults.cnt, stats->pagefaults.refaults,
+	       hit_ratio / 10U, hit_ratio % 10U);
+}
+
+int main(void)
+{
+	struct k_mem_paging_stats_t before;
+	struct k_mem_paging_stats_t after;
+	unsigned long accesses;
+	timing_t start;
+	timing_t finish;
+	size_t free_pages = k_mem_free_get() / PAGE_SIZE;
+	size_t size = (free_pages + EXTRA_PAGES) * PAGE_SIZE;
+
+	timing_init();
+
+	arena = k_mem_map(size, K_MEM_PERM_RW);
+	if (arena == NULL) {
+		printk("Failed to map %zu bytes of anonymous memory\n", size);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	hot_pages = free_pages / 2U;
+	cold_pages = free_pages + EXTRA_PAGES - hot_pages;
+
+	printk("Time Measurements for the %s eviction algorithm\n", EVICTION_NAME);
+	printk("%zu hot pages accessed %u times, then %zu cold pages accessed once,"
+	       " %u rounds\n", hot_pages, HOT_PASSES, cold_pages, ROUNDS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	k_mem_paging_stats_get(&before);
+	start = timing_counter_get();
+	accesses = replay();
+	finish = timing_counter_get();
+	k_mem_paging_stats_get(&after);
+
+	timing_stop();
+
+	after.pagefaults.cnt -= before.pagefaults.cnt;
+	after.pagefaults.refaults -= before.pagefaults.refaults;
+
+	report(accesses, timing_cycles_get(&start, &finish) / accesses, &after);
+
+	k_mem_unmap((void *)arena, size);
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of inserting, looking up
+ * and removing nodes of red/black trees and of radix trees, for a growing
+ * number of nodes.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/rb.h>
+#include <zephyr/sys/radix_tree.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define MAX_NODES CONFIG_BENCHMARK_MAX_NODES
+
+struct elem {
+	struct rbnode rb_node;
+	struct radix_node radix_node;
+	uint64_t key;
+};
+
+static struct elem elems[MAX_NODES];
+
+static bool elem_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct elem, rb_node)->key <
+	       CONTAINER_OF(b, struct elem, rb_node)->key;
+}
+
+static struct rbtree rb_tree = {
+	.lessthan_fn = elem_lessthan,
+};
+
+static struct radix_tree radix_tree;
+
+/* Spread keys over the whole key space */
+static inline uint64_t key_of(uint32_t i)
+{
+	return (i + 1U) * 0x9e3779b97f4a7c15ULL;
+}
+
+static void report(const char *tree_name, const char *op, uint32_t num_nodes, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%s.%u - %s, %u nodes, per operation"
+	       " : %7llu cycles , %7u ns :\n",
+	       tree_name, op, num_nodes, op, num_nodes, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	ARG_UNUSED(tree_name);
+	ARG_UNUSED(num_nodes);
+
+	printk("    %-12s: %7llu cycles (%7u nsec)\n", op, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static int test_rbtree(uint32_t num_nodes)
+{
+	struct rbnode *node;
+	timing_t start;
+	timing_t finish;
+	int errors = 0;
+
+#ifndef CONFIG_BENCHMARK_RECORDING
+	printk("------------------------------------\n");
+	printk("rbtree, %u nodes\n", num_nodes);
+#endif
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		rb_insert(&rb_tree, &elems[i].rb_node);
+	}
+	finish = timing_counter_get();
+	report("rbtree", "insert", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		errors += !rb_contains(&rb_tree, &elems[i].rb_node);
+	}
+	finish = timing_counter_get();
+	report("rbtree", "lookup", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		errors += rb_get_min(&rb_tree) == NULL;
+	}
+	finish = timing_counter_get();
+	report("rbtree", "get_min", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		node = rb_get_min(&rb_tree);
+		rb_remove(&rb_tree, node);
+	}
+	finish = timing_counter_get();
+	report("rbtree", "remove_min", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		rb_insert(&rb_tree, &elems[i].rb_node);
+	}
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		rb_remove(&rb_tree, &elems[i].rb_node);
+	}
+	finish = timing_counter_get();
+	report("rbtree", "remove", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	errors += rb_get_min(&rb_tree) != NULL;
+
+	return errors;
+}
+
+static int test_radix_tree(uint32_t num_nodes)
+{
+	struct radix_node *node;
+	timing_t start;
+	timing_t finish;
+	int errors = 0;
+
+#ifndef CONFIG_BENCHMARK_RECORDING
+	printk("------------------------------------\n");
+	printk("radix_tree, %u nodes\n", num_nodes);
+#endif
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		errors += radix_tree_insert(&radix_tree, &elems[i].radix_node, elems[i].key);
+	}
+	finish = timing_counter_get();
+	report("radix_tree", "insert", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		errors += radix_tree_find(&radix_tree, elems[i].key) == NULL;
+	}
+	finish = timing_counter_get();
+	report("radix_tree", "lookup", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		errors += radix_tree_get_min(&radix_tree) == NULL;
+	}
+	finish = timing_counter_get();
+	report("radix_tree", "get_min", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		node = radix_tree_get_min(&radix_tree);
+		radix_tree_remove(&radix_tree, node);
+	}
+	finish = timing_counter_get();
+	report("radix_tree", "remove_min", num_nodes,
+	       timing_cycles_get(&start, &finish) / num_nodes);
+
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		errors += radix_tree_insert(&radix_tree, &elems[i].radix_node, elems[i].key);
+	}
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < num_nodes; i++) {
+		radix_tree_remove(&radix_tree, &elems[i].radix_node);
+	}
+	finish = timing_counter_get();
+	report("radix_tree", "remove", num_nodes, timing_cycles_get(&start, &finish) / num_nodes);
+
+	errors += !radix_tree_is_empty(&radix_tree);
+
+	return errors;
+}
+
+int main(void)
+{
+	int errors = 0;
+
+	timing_init();
+
+	printk("Time Measurements for ordered containers with up to %u nodes\n", MAX_NODES);
+	printk("Node sizes: rbtree %zu bytes, radix_tree %zu bytes\n",
+	       sizeof(struct rbnode), sizeof(struct radix_node));
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	for (uint32_t i = 0; i < MAX_NODES; i++) {
+		elems[i].key = key_of(i);
+	}
+
+	timing_start();
+
+	for (uint32_t n = 100; n <= MAX_NODES; n *= 10) {
+		errors += test_rbtree(n);
+		errors += test_radix_tree(n);
+	}
+
+	timing_stop();
+
+	if (errors != 0) {
+		printk("%d operations failed\n", errors);
+	}
+
+	TC_END_REPORT(errors == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of looking up entries of a
+ * table protected by RCU, by a k_rwlock and by a k_mutex, by a growing number
+ * of threads. The time from the start of the threads until all of them are
+ * done is measured.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/rcu.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MAX_THREADS CONFIG_BENCHMARK_MAX_THREADS
+#define NUM_LOOKUPS CONFIG_BENCHMARK_NUM_LOOKUPS
+#define TABLE_SIZE CONFIG_BENCHMARK_TABLE_SIZE
+#define UPDATE_PERIOD CONFIG_BENCHMARK_UPDATE_PERIOD
+
+/* Lower priority than main, so that all threads are started before any runs */
+#define THREADS_PRIORITY K_PRIO_PREEMPT(1)
+
+enum lock_type {
+	LOCK_RCU,
+	LOCK_RWLOCK,
+	LOCK_MUTEX,
+};
+
+struct entry {
+	uint32_t key;
+	uint32_t value;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+
+/* Entries in the table, and one spare entry to replace them with */
+static struct entry entries[TABLE_SIZE + 1];
+static struct entry *table[TABLE_SIZE];
+static struct entry *spare;
+
+K_RWLOCK_DEFINE(rwlock, 0);
+
+/* Protects the table for LOCK_MUTEX, and serializes updates otherwise */
+K_MUTEX_DEFINE(mutex);
+
+static struct entry *lookup(uint32_t key)
+{
+	struct entry *e;
+
+	for (unsigned int i = 0; i < TABLE_SIZE; i++) {
+		e = k_rcu_dereference(table[i]);
+		if (e->key == key) {
+			return e;
+		}
+	}
+
+	return NULL;
+}
+
+static void update(enum lock_type type, uint32_t key)
+{
+	unsigned int slot = key % TABLE_SIZE;
+	struct entry *old;
+
+	(void)k_mutex_lock(&mutex, K_FOREVER);
+
+	switch (type) {
+	case LOCK_RCU:
+		/* Publish a copy, and reuse the old entry after a grace period */
+		old = table[slot];
+		*spare = *old;
+		spare->value++;
+		k_rcu_assign_pointer(table[slot], spare);
+		k_rcu_synchronize();
+		spare = old;
+		break;
+	case LOCK_RWLOCK:
+		(void)k_rwlock_write_lock(&rwlock, K_FOREVER);
+		table[slot]->value++;
+		(void)k_rwlock_write_unlock(&rwlock);
+		break;
+	case LOCK_MUTEX:
+		table[slot]->value++;
+		break;
+	}
+
+	(void)k_mutex_unlock(&mutex);
+}
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	enum lock_type type = (enum lock_type)(uintptr_t)p1;
+	uint32_t key = (uint32_t)(uintptr_t)p2;
+	volatile uint32_t value;
+	struct entry *e;
+
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < NUM_LOOKUPS; i++) {
+		key = (key + 7U) % TABLE_SIZE;
+
+		if ((UPDATE_PERIOD != 0) && ((i % UPDATE_PERIOD) == 0U)) {
+			update(type, key);
+		}
+
+		switch (type) {
+		case LOCK_RCU:
+			k_rcu_read_lock();
+			e = lookup(key);
+			value = e->value;
+			k_rcu_read_unlock();
+			break;
+		case LOCK_RWLOCK:
+			(void)k_rwlock_read_lock(&rwlock, K_FOREVER);
+			e = lookup(key);
+			value = e->value;
+			(void)k_rwlock_read_unlock(&rwlock);
+			break;
+		case LOCK_MUTEX:
+			(void)k_mutex_lock(&mutex, K_FOREVER);
+			e = lookup(key);
+			value = e->value;
+			(void)k_mutex_unlock(&mutex);
+			break;
+		}
+	}
+
+	ARG_UNUSED(value);
+}
+
+static void report(enum lock_type type, unsigned int num_threads, uint64_t cycles)
+{
+	static const char *const names[] = { "rcu", "rwlock", "mutex" };
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%02u - %u thread(s), per lookup"
+	       " : %7llu cycles , %7u ns :\n",
+	       names[type], num_threads, num_threads, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("------------------------------------\n");
+	printk("%s, %u thread(s)\n", names[type], num_threads);
+
+	printk("    Per lookup : %7llu cycles (%7u nsec)\n", cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static void test_lookups(enum lock_type type, unsigned int num_threads)
+{
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, reader,
+				(void *)(uintptr_t)type, (void *)(uintptr_t)i, NULL,
+				THREADS_PRIORITY, 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+	for (unsigned int i = 0; i < num_threads; i++) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+	}
+	finish = timing_counter_get();
+
+	report(type, num_threads,
+	       timing_cycles_get(&start, &finish) / (num_threads * NUM_LOOKUPS));
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for table lookups with up to %u threads on %u CPU(s)\n",
+	       MAX_THREADS, arch_num_cpus());
+	if (UPDATE_PERIOD != 0) {
+		printk("One in %u lookups is preceded by an update\n", UPDATE_PERIOD);
+	}
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	for (unsigned int i = 0; i < TABLE_SIZE; i++) {
+		entries[i].key = i;
+		table[i] = &entries[i];
+	}
+	spare = &entries[TABLE_SIZE];
+
+	timing_start();
+
+	for (unsigned int n = 1; n <= MAX_THREADS; n *= 2) {
+		test_lookups(LOCK_RCU, n);
+		test_lookups(LOCK_RWLOCK, n);
+		test_lookups(LOCK_MUTEX, n);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of taking a k_rwlock for
+ * reading and of taking a k_mutex, shared by a growing number of threads
+ * that read shared data while holding the lock. The time from the start of
+ * the threads until all of them are done is measured.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MAX_THREADS CONFIG_BENCHMARK_MAX_THREADS
+#define NUM_ITERATIONS CONFIG_BENCHMARK_NUM_ITERATIONS
+#define WRITE_PERIOD CONFIG_BENCHMARK_WRITE_PERIOD
+
+/* Lower priority than main, so that all threads are started before any runs */
+#define THREADS_PRIORITY K_PRIO_PREEMPT(1)
+
+enum lock_type {
+	LOCK_RWLOCK,
+	LOCK_MUTEX,
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+
+K_RWLOCK_DEFINE(rwlock, 0);
+K_MUTEX_DEFINE(mutex);
+
+/* The data protected by the lock */
+static volatile uint32_t shared[CONFIG_BENCHMARK_CRITICAL_SECTION_LEN];
+
+static void critical_section(bool write)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(shared); i++) {
+		if (write) {
+			shared[i] = shared[i] + 1U;
+		} else {
+			(void)shared[i];
+		}
+	}
+}
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	enum lock_type type = (enum lock_type)(uintptr_t)p1;
+	bool write;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+		write = (WRITE_PERIOD != 0) && ((i % WRITE_PERIOD) == 0U);
+
+		if (type == LOCK_MUTEX) {
+			(void)k_mutex_lock(&mutex, K_FOREVER);
+			critical_section(write);
+			(void)k_mutex_unlock(&mutex);
+		} else if (write) {
+			(void)k_rwlock_write_lock(&rwlock, K_FOREVER);
+			critical_section(true);
+			(void)k_rwlock_write_unlock(&rwlock);
+		} else {
+			(void)k_rwlock_read_lock(&rwlock, K_FOREVER);
+			critical_section(false);
+			(void)k_rwlock_read_unlock(&rwlock);
+		}
+	}
+}
+
+static void report(enum lock_type type, unsigned int num_threads, uint64_t cycles)
+{
+	const char *name = (type == LOCK_RWLOCK) ? "rwlock" : "mutex";
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%02u - %u reader(s), per acquisition"
+	       " : %7llu cycles , %7u ns :\n",
+	       name, num_threads, num_threads, cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("------------------------------------\n");
+	printk("%s, %u reader(s)\n", name, num_threads);
+
+	printk("    Per acquisition : %7llu cycles (%7u nsec)\n", cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static void test_readers(enum lock_type type, unsigned int num_threads)
+{
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, reader,
+				(void *)(uintptr_t)type, NULL, NULL,
+				THREADS_PRIORITY, 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+	for (unsigned int i = 0; i < num_threads; i++) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+	}
+	finish = timing_counter_get();
+
+	report(type, num_threads,
+	       timing_cycles_get(&start, &finish) / (num_threads * NUM_ITERATIONS));
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for reader-writer locks and mutexes with up to %u"
+	       " readers on %u CPU(s)\n", MAX_THREADS, arch_num_cpus());
+	if (WRITE_PERIOD != 0) {
+		printk("One in %u acquisitions of the reader-writer lock is for writing\n",
+		       WRITE_PERIOD);
+	}
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int n = 1; n <= MAX_THREADS; n *= 2) {
+		test_readers(LOCK_RWLOCK, n);
+		test_readers(LOCK_MUTEX, n);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
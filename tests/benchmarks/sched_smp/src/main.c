@@ -0,0 +1,200 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure context switch and wakeup latency
+ * on SMP systems while an increasing number of CPUs takes part in
+ * scheduling. For every CPU count, one pair of threads per CPU ping-pongs
+ * through a pair of semaphores, with all threads confined to those CPUs.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MAX_PAIRS  CONFIG_MP_MAX_NUM_CPUS
+
+/* Lower than main(), so that main() can set up every thread first */
+#define PAIR_PRIO  (K_LOWEST_APPLICATION_THREAD_PRIO - 1)
+
+struct pair {
+	struct k_sem ping;
+	struct k_sem pong;
+
+	/* Set by the waking thread right before it gives a semaphore */
+	timing_t stamp;
+
+	uint64_t wake_min;
+	uint64_t wake_max;
+	uint64_t wake_total;
+};
+
+static struct pair pairs[MAX_PAIRS];
+static struct k_thread threads[2 * MAX_PAIRS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_PAIRS, STACK_SIZE);
+static K_SEM_DEFINE(done_sem, 0, 2 * MAX_PAIRS);
+
+static void record_wakeup(struct pair *pair)
+{
+	timing_t now = timing_counter_get();
+	uint64_t cycles = timing_cycles_get(&pair->stamp, &now);
+
+	pair->wake_min = MIN(pair->wake_min, cycles);
+	pair->wake_max = MAX(pair->wake_max, cycles);
+	pair->wake_total += cycles;
+}
+
+static void ping_thread(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		pair->stamp = timing_counter_get();
+		k_sem_give(&pair->ping);
+		k_sem_take(&pair->pong, K_FOREVER);
+		record_wakeup(pair);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void pong_thread(void *p1, void *p2, void *p3)
+{
+	struct pair *pair = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_sem_take(&pair->ping, K_FOREVER);
+		record_wakeup(pair);
+		pair->stamp = timing_counter_get();
+		k_sem_give(&pair->pong);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void spawn(unsigned int idx, k_thread_entry_t entry, struct pair *pair,
+		  unsigned int num_cpus)
+{
+	k_tid_t tid;
+
+	tid = k_thread_create(&threads[idx], stacks[idx], STACK_SIZE, entry,
+			      pair, NULL, NULL, PAIR_PRIO, 0, K_FOREVER);
+
+	k_thread_cpu_mask_clear(tid);
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_cpu_mask_enable(tid, cpu);
+	}
+}
+
+static void report(unsigned int num_cpus, uint64_t wake_min, uint64_t wake_max,
+		   uint64_t wake_avg, uint64_t round_trip)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: sched_smp.wakeup.%u.min - Wakeup on %u CPUs, min. : %7llu cycles , %7u ns :\n",
+	       num_cpus, num_cpus, wake_min, (uint32_t)timing_cycles_to_ns(wake_min));
+	printk("REC: sched_smp.wakeup.%u.max - Wakeup on %u CPUs, max. : %7llu cycles , %7u ns :\n",
+	       num_cpus, num_cpus, wake_max, (uint32_t)timing_cycles_to_ns(wake_max));
+	printk("REC: sched_smp.wakeup.%u.avg - Wakeup on %u CPUs, avg. : %7llu cycles , %7u ns :\n",
+	       num_cpus, num_cpus, wake_avg, (uint32_t)timing_cycles_to_ns(wake_avg));
+	printk("REC: sched_smp.round_trip.%u - Round trip on %u CPUs, avg. : %7llu cycles , %7u ns :\n",
+	       num_cpus, num_cpus, round_trip, (uint32_t)timing_cycles_to_ns(round_trip));
+#else
+	printk("------------------------------------\n");
+	printk("%u thread pairs on %u CPUs\n", num_cpus, num_cpus);
+
+	printk("    Wakeup minimum : %7llu cycles (%7u nsec)\n", wake_min,
+	       (uint32_t)timing_cycles_to_ns(wake_min));
+	printk("    Wakeup maximum : %7llu cycles (%7u nsec)\n", wake_max,
+	       (uint32_t)timing_cycles_to_ns(wake_max));
+	printk("    Wakeup average : %7llu cycles (%7u nsec)\n", wake_avg,
+	       (uint32_t)timing_cycles_to_ns(wake_avg));
+	printk("    Round trip     : %7llu cycles (%7u nsec)\n", round_trip,
+	       (uint32_t)timing_cycles_to_ns(round_trip));
+#endif
+}
+
+static void test_cpus(unsigned int num_cpus)
+{
+	uint64_t wake_min = UINT64_MAX;
+	uint64_t wake_max = 0;
+	uint64_t wake_total = 0;
+	uint64_t cycles;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct pair *pair = &pairs[i];
+
+		k_sem_init(&pair->ping, 0, 1);
+		k_sem_init(&pair->pong, 0, 1);
+		pair->wake_min = UINT64_MAX;
+		pair->wake_max = 0;
+		pair->wake_total = 0;
+
+		spawn(2 * i, ping_thread, pair, num_cpus);
+		spawn(2 * i + 1, pong_thread, pair, num_cpus);
+	}
+
+	start = timing_counter_get();
+
+	for (unsigned int i = 0; i < 2 * num_cpus; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < 2 * num_cpus; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+
+	for (unsigned int i = 0; i < 2 * num_cpus; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		wake_min = MIN(wake_min, pairs[i].wake_min);
+		wake_max = MAX(wake_max, pairs[i].wake_max);
+		wake_total += pairs[i].wake_total;
+	}
+
+	/* Each iteration of every pair wakes up both of its threads once */
+	cycles = timing_cycles_get(&start, &finish);
+
+	report(num_cpus, wake_min, wake_max,
+	       wake_total / (2ULL * num_cpus * CONFIG_BENCHMARK_NUM_ITERATIONS),
+	       cycles / CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	timing_init();
+
+	printk("Time Measurements for %s SMP scheduling\n",
+	       IS_ENABLED(CONFIG_SCHED_WORK_STEALING) ? "work stealing" : "single queue");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int n = 1; n <= num_cpus; n++) {
+		test_cpus(n);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
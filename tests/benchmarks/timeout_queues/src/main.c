@@ -0,0 +1,158 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required to add
+ * a timeout to, and abort a timeout from, a kernel timeout queue that holds
+ * a varying number of pending timeouts. The pending timeouts are given
+ * pseudo-random expiry times far enough in the future that none of them
+ * expires while the measurements are taken.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+
+/* All pending timeouts expire within [EXPIRY_BASE, EXPIRY_BASE + EXPIRY_SPAN) */
+#define EXPIRY_BASE 100000U
+#define EXPIRY_SPAN 100000U
+
+static const unsigned int queue_depths[] = {
+	10, 100, CONFIG_BENCHMARK_NUM_TIMEOUTS,
+};
+
+static struct _timeout pending[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+static struct _timeout probe;
+
+static uint32_t rand_state = 0x12345678U;
+
+/* Cheap deterministic generator, so that all backends see the same keys */
+static uint32_t next_rand(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static k_timeout_t random_timeout(void)
+{
+	return K_TICKS(EXPIRY_BASE + (next_rand() % EXPIRY_SPAN));
+}
+
+static void timeout_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void fill_queue(unsigned int depth)
+{
+	for (unsigned int i = 0; i < depth; i++) {
+		z_init_timeout(&pending[i]);
+		z_add_timeout(&pending[i], timeout_handler, random_timeout());
+	}
+}
+
+static void drain_queue(unsigned int depth)
+{
+	for (unsigned int i = 0; i < depth; i++) {
+		z_abort_timeout(&pending[i]);
+	}
+}
+
+static void report(const char *tag, const char *str, unsigned int depth,
+		   uint64_t minimum, uint64_t maximum, uint64_t total)
+{
+	uint64_t average = total / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%05u.min - %s, %u pending, min. : %7llu cycles , %7u ns :\n",
+	       tag, depth, str, depth, minimum, (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: %s.%05u.max - %s, %u pending, max. : %7llu cycles , %7u ns :\n",
+	       tag, depth, str, depth, maximum, (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: %s.%05u.avg - %s, %u pending, avg. : %7llu cycles , %7u ns :\n",
+	       tag, depth, str, depth, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s with %u pending timeouts\n", str, depth);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_add_abort(unsigned int depth)
+{
+	uint64_t add_min = UINT64_MAX;
+	uint64_t add_max = 0;
+	uint64_t add_total = 0;
+	uint64_t abort_min = UINT64_MAX;
+	uint64_t abort_max = 0;
+	uint64_t abort_total = 0;
+	uint64_t cycles;
+	timing_t start;
+	timing_t mid;
+	timing_t finish;
+
+	fill_queue(depth);
+
+	z_init_timeout(&probe);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_timeout_t timeout = random_timeout();
+
+		start = timing_counter_get();
+		z_add_timeout(&probe, timeout_handler, timeout);
+		mid = timing_counter_get();
+		z_abort_timeout(&probe);
+		finish = timing_counter_get();
+
+		cycles = timing_cycles_get(&start, &mid);
+		add_min = MIN(add_min, cycles);
+		add_max = MAX(add_max, cycles);
+		add_total += cycles;
+
+		cycles = timing_cycles_get(&mid, &finish);
+		abort_min = MIN(abort_min, cycles);
+		abort_max = MAX(abort_max, cycles);
+		abort_total += cycles;
+	}
+
+	drain_queue(depth);
+
+	report("timeout.add", "Add timeout", depth, add_min, add_max, add_total);
+	report("timeout.abort", "Abort timeout", depth, abort_min, abort_max, abort_total);
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %s timeout queues\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_SCALABLE) ? "scalable" : "simple");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(queue_depths); i++) {
+		test_add_abort(queue_depths[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the throughput of a work queue
+ * started with k_work_queue_start_workers() as the number of worker threads
+ * grows. Every work item runs a busy loop, to model the cost of handling
+ * it, and the time from the first submission until all items have been
+ * handled is measured.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Lower priority than main, so that main submits without being preempted */
+#define WORKERS_PRIORITY K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_BENCHMARK_MAX_WORKERS, STACK_SIZE);
+static struct k_work_q_worker workers[CONFIG_BENCHMARK_MAX_WORKERS];
+static struct k_work_q queue;
+
+static struct k_work items[CONFIG_BENCHMARK_NUM_ITEMS];
+static atomic_t remaining;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	for (volatile unsigned int i = 0; i < CONFIG_BENCHMARK_WORK_LOOPS; i++) {
+	}
+
+	if (atomic_dec(&remaining) == 1) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void report(unsigned int num_workers, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: work_queue.workers.%02u - %u worker(s), per work item"
+	       " : %7llu cycles , %7u ns :\n",
+	       num_workers, num_workers, cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("------------------------------------\n");
+	printk("%u worker(s)\n", num_workers);
+
+	printk("    Per work item : %7llu cycles (%7u nsec)\n", cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static void test_workers(unsigned int num_workers)
+{
+	uint64_t total = 0;
+	timing_t start;
+	timing_t finish;
+	int ret;
+
+	k_work_queue_start_workers(&queue, workers, num_workers, stacks[0], STACK_SIZE,
+				   WORKERS_PRIORITY, NULL);
+
+	for (unsigned int round = 0; round < CONFIG_BENCHMARK_NUM_ROUNDS; round++) {
+		atomic_set(&remaining, CONFIG_BENCHMARK_NUM_ITEMS);
+
+		start = timing_counter_get();
+		for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+			(void)k_work_submit_to_queue(&queue, &items[i]);
+		}
+		(void)k_sem_take(&done_sem, K_FOREVER);
+		finish = timing_counter_get();
+
+		total += timing_cycles_get(&start, &finish);
+	}
+
+	(void)k_work_queue_drain(&queue, true);
+	ret = k_work_queue_stop(&queue, K_FOREVER);
+	if (ret != 0) {
+		printk("Failed to stop work queue: %d\n", ret);
+	}
+
+	report(num_workers, total / (CONFIG_BENCHMARK_NUM_ROUNDS * CONFIG_BENCHMARK_NUM_ITEMS));
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for work queues with up to %u workers on %u CPU(s)\n",
+	       CONFIG_BENCHMARK_MAX_WORKERS, arch_num_cpus());
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+		k_work_init(&items[i], work_handler);
+	}
+
+	k_work_queue_init(&queue);
+
+	timing_start();
+
+	for (unsigned int n = 1; n <= CONFIG_BENCHMARK_MAX_WORKERS; n++) {
+		test_workers(n);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -435,6 +435,72 @@ ZTEST(ipi, test_thread_coop_no_ipis)
 	}
 }
 
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+static int ipi_stats_reset(struct k_obj_core *obj_core, void *data)
+{
+	ARG_UNUSED(data);
+
+	zassert_ok(k_obj_core_stats_reset(obj_core));
+
+	return 0;
+}
+
+static int ipi_stats_collect(struct k_obj_core *obj_core, void *data)
+{
+	struct k_ipi_stats **stats = data;
+
+	zassert_ok(k_obj_core_stats_raw(obj_core, *stats, sizeof(**stats)));
+	(*stats)++;
+
+	return 0;
+}
+
+/**
+ * Verify that the IPI statistics count IPIs that did not cause a context
+ * switch as wasted.
+ */
+ZTEST(ipi, test_ipi_stats)
+{
+	struct k_ipi_stats  stats[CONFIG_MP_MAX_NUM_CPUS];
+	struct k_ipi_stats *next = stats;
+	struct k_obj_type  *type;
+	uint32_t  id;
+	int priority;
+	unsigned int j;
+
+	type = k_obj_type_find(K_OBJ_TYPE_IPI_ID);
+	zassert_not_null(type, "No IPI object type\n");
+
+	priority = k_thread_priority_get(k_current_get());
+
+	id = busy_threads_create(priority - 1);
+
+	/* The busy threads keep running after the IPI */
+
+	k_obj_type_walk_unlocked(type, ipi_stats_reset, NULL);
+	arch_sched_broadcast_ipi();
+	k_busy_wait(DELAY_FOR_IPIS);
+	k_obj_type_walk_unlocked(type, ipi_stats_collect, &next);
+
+	zassert_equal(next - stats, CONFIG_MP_MAX_NUM_CPUS,
+		      "Expected one IPI object per CPU\n");
+
+	for (j = 0; j < CONFIG_MP_MAX_NUM_CPUS; j++) {
+		if (id == j) {
+			zassert_equal(stats[j].received, 0,
+				      "CPU%u received %llu IPIs\n", j, stats[j].received);
+		} else {
+			zassert_equal(stats[j].received, 1,
+				      "CPU%u received %llu IPIs\n", j, stats[j].received);
+			zassert_equal(stats[j].wasted, 1,
+				      "CPU%u wasted %llu IPIs\n", j, stats[j].wasted);
+			zassert_equal(stats[j].useful, 0,
+				      "CPU%u used %llu IPIs\n", j, stats[j].useful);
+		}
+	}
+}
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
+
 static void *ipi_tests_setup(void)
 {
 	/*
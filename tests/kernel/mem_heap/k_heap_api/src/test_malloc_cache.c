@@ -0,0 +1,139 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_KERNEL_MEM_POOL_CACHE
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+static K_THREAD_STACK_DEFINE(cache_tstack, STACK_SIZE);
+static struct k_thread cache_tdata;
+
+#define SMALL_SIZE 16
+
+extern struct k_heap _system_heap;
+
+static void thread_alloc_system_heap(void *p1, void *p2, void *p3)
+{
+	void *p;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	p = k_heap_alloc(&_system_heap, SMALL_SIZE, K_NO_WAIT);
+	zassert_is_null(p, "k_heap_alloc should fail but did not");
+
+	p = k_heap_alloc(&_system_heap, SMALL_SIZE, K_MSEC(500));
+	zassert_not_null(p, "k_heap_alloc waiter not woken by k_free");
+
+	k_heap_free(&_system_heap, p);
+}
+
+/* Allocates blocks of the given size from the system heap, bypassing
+ * the k_malloc() caches, until it runs out.  The blocks are chained
+ * through their first word.
+ */
+static void *exhaust_system_heap(void *chain, size_t size)
+{
+	void **p;
+
+	while ((p = k_heap_alloc(&_system_heap, size, K_NO_WAIT)) != NULL) {
+		*p = chain;
+		chain = p;
+	}
+
+	return chain;
+}
+
+/**
+ * @brief Test that k_free() wakes threads waiting on the system heap
+ *
+ * @details Leave free blocks in the k_malloc() cache of the current
+ * CPU, exhaust the system heap and have a child thread wait for a
+ * small block in k_heap_alloc().  Freeing a single k_malloc() block
+ * must hand the waiter the cached blocks instead of keeping them in
+ * the cache.
+ *
+ * @ingroup k_heap_api_tests
+ *
+ * @see k_malloc(), k_free(), k_heap_alloc()
+ */
+ZTEST(k_heap_api, test_malloc_cache_free_wakes_waiter)
+{
+	void **chain;
+	void *p;
+
+	/* Refill the cache, then give the block back to it */
+	p = k_malloc(SMALL_SIZE);
+	zassert_not_null(p, "small allocation failed");
+	k_free(p);
+
+	chain = exhaust_system_heap(NULL, 64);
+	chain = exhaust_system_heap(chain, 8);
+
+	/* Served from the cache even though the heap is exhausted */
+	p = k_malloc(SMALL_SIZE);
+	zassert_not_null(p, "cached allocation failed");
+
+	k_tid_t tid = k_thread_create(&cache_tdata, cache_tstack, STACK_SIZE,
+				      thread_alloc_system_heap, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+
+	/* Sleep long enough for child thread to go into pending */
+	k_msleep(5);
+
+	k_free(p);
+
+	k_thread_join(tid, K_FOREVER);
+
+	while (chain != NULL) {
+		p = chain;
+		chain = *chain;
+		k_heap_free(&_system_heap, p);
+	}
+}
+
+#ifdef CONFIG_SYS_HEAP_CACHE_STATS
+/**
+ * @brief Test the per-CPU k_malloc() cache statistics
+ *
+ * @details Allocate and free a small block twice. The first allocation
+ * refills the cache of the current CPU from the heap, the second one is
+ * served from that cache.
+ *
+ * @ingroup k_heap_api_tests
+ *
+ * @see sys_heap_cache_stats_get()
+ */
+ZTEST(k_heap_api, test_malloc_cache_stats)
+{
+	struct sys_heap_cache_stats before;
+	struct sys_heap_cache_stats after;
+	void *ptr;
+
+	zassert_ok(sys_heap_cache_stats_get(&_system_heap.heap, &before));
+
+	/* Small enough for a whole refill batch to fit in the heap */
+	for (int i = 0; i < 2; i++) {
+		ptr = k_malloc(SMALL_SIZE);
+		zassert_not_null(ptr, "small allocation failed");
+		k_free(ptr);
+	}
+
+	zassert_ok(sys_heap_cache_stats_get(&_system_heap.heap, &after));
+
+	zassert_true(after.hits > before.hits, "second allocation missed the cache");
+	zassert_equal(after.hits + after.misses, before.hits + before.misses + 2,
+		      "allocations not accounted for");
+	zassert_not_equal(after.cached_bytes, 0, "freed block not cached");
+
+	zassert_equal(sys_heap_cache_stats_get(NULL, &after), -EINVAL);
+	zassert_equal(sys_heap_cache_stats_get(&_system_heap.heap, NULL), -EINVAL);
+}
+#endif /* CONFIG_SYS_HEAP_CACHE_STATS */
+
+#endif /* CONFIG_KERNEL_MEM_POOL_CACHE */
@@ -0,0 +1,329 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for multi-producer multi-consumer queue objects
+ * @defgroup kernel_mpmcq_tests MPMC Queues
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define QUEUE_LEN 4
+#define NUM_PRODUCERS 2
+#define NUM_CONSUMERS 2
+#define NUM_VALUES 500
+
+K_MPMCQ_DEFINE(mq, QUEUE_LEN);
+K_MPMCQ_DEFINE(mq_min, 2);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_PRODUCERS + NUM_CONSUMERS, STACK_SIZE);
+static struct k_thread threads[NUM_PRODUCERS + NUM_CONSUMERS];
+
+static struct k_mpmcq alloc_mq;
+static atomic_t consumed_sum;
+
+K_HEAP_DEFINE(test_pool, 256);
+
+static void drain(void)
+{
+	uintptr_t data;
+
+	while (k_mpmcq_get(&mq, &data, K_NO_WAIT) == 0) {
+	}
+}
+
+static void put_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_mpmcq_put(&mq, (uintptr_t)p1, K_NO_WAIT));
+}
+
+static void get_entry(void *p1, void *p2, void *p3)
+{
+	uintptr_t data;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_mpmcq_get(&mq, &data, K_NO_WAIT));
+	zassert_equal(data, (uintptr_t)p1);
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	uintptr_t base = (uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uintptr_t i = 1; i <= NUM_VALUES; i++) {
+		zassert_ok(k_mpmcq_put(&mq, base + i, K_FOREVER));
+	}
+}
+
+static void consumer_entry(void *p1, void *p2, void *p3)
+{
+	uintptr_t data;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_VALUES * NUM_PRODUCERS / NUM_CONSUMERS; i++) {
+		zassert_ok(k_mpmcq_get(&mq, &data, K_FOREVER));
+		atomic_add(&consumed_sum, (atomic_val_t)data);
+	}
+}
+
+static void isr_put(const void *p)
+{
+	zassert_ok(k_mpmcq_put(&mq, (uintptr_t)p, K_NO_WAIT));
+}
+
+static void isr_get(const void *p)
+{
+	uintptr_t data;
+
+	zassert_ok(k_mpmcq_get(&mq, &data, K_NO_WAIT));
+	zassert_equal(data, (uintptr_t)p);
+}
+
+/**
+ * @brief Test values come out in order, and full and empty queues
+ *
+ * @ingroup kernel_mpmcq_tests
+ *
+ * @see k_mpmcq_put(), k_mpmcq_get()
+ */
+ZTEST_USER(mpmcq, test_mpmcq_order)
+{
+	uintptr_t data;
+
+	/* Go around the ring a few times */
+	for (uintptr_t lap = 0; lap < 3; lap++) {
+		for (uintptr_t i = 0; i < QUEUE_LEN; i++) {
+			zassert_ok(k_mpmcq_put(&mq, lap * QUEUE_LEN + i, K_NO_WAIT));
+		}
+
+		/**TESTPOINT: a full queue rejects values */
+		zassert_equal(k_mpmcq_put(&mq, 0, K_NO_WAIT), -ENOMSG);
+		zassert_equal(k_mpmcq_put(&mq, 0, K_MSEC(10)), -EAGAIN);
+
+		for (uintptr_t i = 0; i < QUEUE_LEN; i++) {
+			zassert_ok(k_mpmcq_get(&mq, &data, K_NO_WAIT));
+			zassert_equal(data, lap * QUEUE_LEN + i);
+		}
+
+		/**TESTPOINT: an empty queue has nothing to give */
+		zassert_equal(k_mpmcq_get(&mq, &data, K_NO_WAIT), -ENOMSG);
+		zassert_equal(k_mpmcq_get(&mq, &data, K_MSEC(10)), -EAGAIN);
+	}
+
+	/* Interleaved puts and gets */
+	for (uintptr_t i = 0; i < 3 * QUEUE_LEN; i++) {
+		zassert_ok(k_mpmcq_put(&mq, i, K_NO_WAIT));
+		zassert_ok(k_mpmcq_put(&mq, i + 100, K_NO_WAIT));
+		zassert_ok(k_mpmcq_get(&mq, &data, K_NO_WAIT));
+		zassert_equal(data, i);
+		zassert_ok(k_mpmcq_get(&mq, &data, K_NO_WAIT));
+		zassert_equal(data, i + 100);
+	}
+}
+
+/**
+ * @brief Test a thread pending on an empty queue is woken by a put
+ *
+ * @ingroup kernel_mpmcq_tests
+ *
+ * @see k_mpmcq_get()
+ */
+ZTEST(mpmcq, test_mpmcq_get_blocking)
+{
+	uintptr_t data;
+	k_tid_t tid;
+
+	tid = k_thread_create(&threads[0], stacks[0], STACK_SIZE, put_entry,
+			      (void *)0x1234, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_MSEC(10));
+
+	zassert_ok(k_mpmcq_get(&mq, &data, K_FOREVER));
+	zassert_equal(data, 0x1234);
+	k_thread_join(tid, K_FOREVER);
+}
+
+/**
+ * @brief Test a thread pending on a full queue is woken by a get
+ *
+ * @ingroup kernel_mpmcq_tests
+ *
+ * @see k_mpmcq_put()
+ */
+ZTEST(mpmcq, test_mpmcq_put_blocking)
+{
+	uintptr_t data;
+	k_tid_t tid;
+
+	for (uintptr_t i = 0; i < QUEUE_LEN; i++) {
+		zassert_ok(k_mpmcq_put(&mq, i, K_NO_WAIT));
+	}
+
+	tid = k_thread_create(&threads[0], stacks[0], STACK_SIZE, get_entry,
+			      (void *)0, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_MSEC(10));
+
+	zassert_ok(k_mpmcq_put(&mq, QUEUE_LEN, K_FOREVER));
+	k_thread_join(tid, K_FOREVER);
+
+	for (uintptr_t i = 1; i <= QUEUE_LEN; i++) {
+		zassert_ok(k_mpmcq_get(&mq, &data, K_NO_WAIT));
+		zassert_equal(data, i);
+	}
+}
+
+/**
+ * @brief Test putting and getting values from an ISR
+ *
+ * @ingroup kernel_mpmcq_tests
+ *
+ * @see k_mpmcq_put(), k_mpmcq_get()
+ */
+ZTEST(mpmcq, test_mpmcq_isr)
+{
+	uintptr_t data;
+
+	irq_offload(isr_put, (const void *)0x55);
+	zassert_ok(k_mpmcq_get(&mq, &data, K_NO_WAIT));
+	zassert_equal(data, 0x55);
+
+	zassert_ok(k_mpmcq_put(&mq, 0xaa, K_NO_WAIT));
+	irq_offload(isr_get, (const void *)0xaa);
+	zassert_equal(k_mpmcq_get(&mq, &data, K_NO_WAIT), -ENOMSG);
+}
+
+/**
+ * @brief Test several producers and consumers sharing a small queue
+ *
+ * @ingroup kernel_mpmcq_tests
+ *
+ * @see k_mpmcq_put(), k_mpmcq_get()
+ */
+ZTEST(mpmcq, test_mpmcq_producers_consumers)
+{
+	atomic_val_t expected = 0;
+	int n = 0;
+
+	atomic_set(&consumed_sum, 0);
+
+	for (int i = 0; i < NUM_CONSUMERS; i++, n++) {
+		k_thread_create(&threads[n], stacks[n], STACK_SIZE, consumer_entry,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_PRODUCERS; i++, n++) {
+		uintptr_t base = (uintptr_t)i * 0x10000;
+
+		k_thread_create(&threads[n], stacks[n], STACK_SIZE, producer_entry,
+				(void *)base, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		expected += (atomic_val_t)(base * NUM_VALUES + NUM_VALUES * (NUM_VALUES + 1) / 2);
+	}
+
+	for (int i = 0; i < n; i++) {
+		zassert_ok(k_thread_join(&threads[i], K_FOREVER));
+	}
+
+	/**TESTPOINT: every value was got exactly once */
+	zassert_equal(atomic_get(&consumed_sum), expected);
+	zassert_equal(k_mpmcq_get(&mq, &(uintptr_t){0}, K_NO_WAIT), -ENOMSG);
+}
+
+/**
+ * @brief Test queues with an allocated buffer
+ *
+ * @ingroup kernel_mpmcq_tests
+ *
+ * @see k_mpmcq_alloc_init(), k_mpmcq_cleanup()
+ */
+ZTEST(mpmcq, test_mpmcq_alloc)
+{
+	uintptr_t data;
+
+	zassert_equal(k_mpmcq_alloc_init(&alloc_mq, 3), -EINVAL);
+	zassert_equal(k_mpmcq_alloc_init(&alloc_mq, 1), -EINVAL);
+	zassert_equal(k_mpmcq_alloc_init(&alloc_mq, 0), -EINVAL);
+	zassert_ok(k_mpmcq_alloc_init(&alloc_mq, 8));
+
+	for (uintptr_t i = 0; i < 8; i++) {
+		zassert_ok(k_mpmcq_put(&alloc_mq, i, K_NO_WAIT));
+	}
+	zassert_equal(k_mpmcq_put(&alloc_mq, 8, K_NO_WAIT), -ENOMSG);
+	for (uintptr_t i = 0; i < 8; i++) {
+		zassert_ok(k_mpmcq_get(&alloc_mq, &data, K_NO_WAIT));
+		zassert_equal(data, i);
+	}
+
+	zassert_ok(k_mpmcq_cleanup(&alloc_mq));
+}
+
+/**
+ * @brief Test the smallest queue size
+ *
+ * @details With two slots, a full queue and a queue free for the next lap
+ * differ by a single sequence number step. Fill and drain the queue over
+ * several laps, with and without wrapping in the middle, and check that a
+ * full queue never accepts a value.
+ *
+ * @ingroup kernel_mpmcq_tests
+ *
+ * @see K_MPMCQ_DEFINE()
+ */
+ZTEST_USER(mpmcq, test_mpmcq_min_size)
+{
+	uintptr_t data;
+
+	for (uintptr_t lap = 0; lap < 4; lap++) {
+		zassert_ok(k_mpmcq_put(&mq_min, 2 * lap, K_NO_WAIT));
+		zassert_ok(k_mpmcq_put(&mq_min, 2 * lap + 1, K_NO_WAIT));
+		zassert_equal(k_mpmcq_put(&mq_min, 0xff, K_NO_WAIT), -ENOMSG,
+			      "Full queue accepted a value");
+
+		zassert_ok(k_mpmcq_get(&mq_min, &data, K_NO_WAIT));
+		zassert_equal(data, 2 * lap);
+
+		/* One slot free again, the next lap begins in the middle */
+		zassert_ok(k_mpmcq_put(&mq_min, 0x100 + lap, K_NO_WAIT));
+		zassert_equal(k_mpmcq_put(&mq_min, 0xff, K_NO_WAIT), -ENOMSG,
+			      "Full queue accepted a value");
+
+		zassert_ok(k_mpmcq_get(&mq_min, &data, K_NO_WAIT));
+		zassert_equal(data, 2 * lap + 1);
+		zassert_ok(k_mpmcq_get(&mq_min, &data, K_NO_WAIT));
+		zassert_equal(data, 0x100 + lap);
+		zassert_equal(k_mpmcq_get(&mq_min, &data, K_NO_WAIT), -ENOMSG,
+			      "Empty queue returned a value");
+	}
+}
+
+static void *mpmcq_setup(void)
+{
+	k_thread_access_grant(k_current_get(), &mq, &mq_min, &alloc_mq);
+	k_thread_heap_assign(k_current_get(), &test_pool);
+
+	return NULL;
+}
+
+static void mpmcq_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	drain();
+}
+
+ZTEST_SUITE(mpmcq, NULL, mpmcq_setup, mpmcq_before, NULL, NULL);
@@ -0,0 +1,186 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define MANY_LEN 8
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern k_tid_t tids[2];
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) mbuffer[MSG_SIZE * MANY_LEN];
+static ZTEST_DMEM uint32_t tx_data[MANY_LEN * 2];
+static ZTEST_BMEM uint32_t rx_data[MANY_LEN * 2];
+
+static void fill_tx_data(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(tx_data); i++) {
+		tx_data[i] = MSG0 + i;
+	}
+}
+
+static void put_get_many(struct k_msgq *q)
+{
+	int ret;
+
+	fill_tx_data();
+
+	/**TESTPOINT: put more messages than fit, only as many as fit are sent*/
+	ret = k_msgq_put_many(q, tx_data, MANY_LEN + 2, K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN);
+	zassert_equal(k_msgq_num_used_get(q), MANY_LEN);
+
+	/**TESTPOINT: put_many on a full queue returns -ENOMSG or -EAGAIN*/
+	zassert_equal(k_msgq_put_many(q, tx_data, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_put_many(q, tx_data, 1, TIMEOUT), -EAGAIN);
+
+	/**TESTPOINT: get fewer messages than queued, in FIFO order*/
+	ret = k_msgq_get_many(q, rx_data, MANY_LEN / 2, K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN / 2);
+	for (int i = 0; i < MANY_LEN / 2; i++) {
+		zassert_equal(rx_data[i], tx_data[i]);
+	}
+
+	/**TESTPOINT: messages written across the end of the ring buffer*/
+	ret = k_msgq_put_many(q, &tx_data[MANY_LEN], MANY_LEN, K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN / 2);
+
+	/**TESTPOINT: messages read across the end of the ring buffer*/
+	ret = k_msgq_get_many(q, rx_data, ARRAY_SIZE(rx_data), K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN);
+	for (int i = 0; i < MANY_LEN; i++) {
+		zassert_equal(rx_data[i], tx_data[(MANY_LEN / 2) + i]);
+	}
+
+	/**TESTPOINT: get_many on an empty queue returns -ENOMSG or -EAGAIN*/
+	zassert_equal(k_msgq_get_many(q, rx_data, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get_many(q, rx_data, 1, TIMEOUT), -EAGAIN);
+
+	/**TESTPOINT: zero messages is a no-op*/
+	zassert_equal(k_msgq_put_many(q, tx_data, 0, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_get_many(q, rx_data, 0, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_put_many((struct k_msgq *)p1, &tx_data[MANY_LEN],
+				  MANY_LEN, K_FOREVER);
+
+	zassert_equal(ret, MANY_LEN);
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_get_many((struct k_msgq *)p1, rx_data, MANY_LEN * 2,
+				  K_FOREVER);
+
+	zassert_equal(ret, MANY_LEN + 1);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving several messages at once
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_get_many)
+{
+	k_msgq_init(&msgq, mbuffer, MSG_SIZE, MANY_LEN);
+
+	put_get_many(&msgq);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test sending and receiving several messages at once from user mode
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST_USER(msgq_api, test_msgq_user_put_get_many)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, MANY_LEN));
+
+	put_get_many(q);
+}
+#endif /* CONFIG_USERSPACE */
+
+/**
+ * @brief Test that get_many refills the queue from a pending writer
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_get_many_pending_writer)
+{
+	int ret;
+
+	fill_tx_data();
+	k_msgq_init(&msgq, mbuffer, MSG_SIZE, MANY_LEN);
+
+	/* fill the queue, so that the writer blocks on its first message */
+	zassert_equal(k_msgq_put_many(&msgq, tx_data, MANY_LEN, K_NO_WAIT), MANY_LEN);
+	tids[0] = k_thread_create(&tdata, tstack, STACK_SIZE,
+				  writer_entry, &msgq, NULL, NULL,
+				  K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/**TESTPOINT: the pending writer's message fills the freed space*/
+	ret = k_msgq_get_many(&msgq, rx_data, MANY_LEN, K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN);
+	for (int i = 0; i < MANY_LEN; i++) {
+		zassert_equal(rx_data[i], tx_data[i]);
+	}
+
+	/* the writer woke up and sent the rest without waiting again */
+	k_thread_join(tids[0], K_FOREVER);
+	tids[0] = NULL;
+	zassert_equal(k_msgq_num_used_get(&msgq), MANY_LEN);
+
+	ret = k_msgq_get_many(&msgq, rx_data, MANY_LEN, K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN);
+	for (int i = 0; i < MANY_LEN; i++) {
+		zassert_equal(rx_data[i], tx_data[MANY_LEN + i]);
+	}
+}
+
+/**
+ * @brief Test that put_many hands messages to a pending reader
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_put_many_pending_reader)
+{
+	int ret;
+
+	fill_tx_data();
+	k_msgq_init(&msgq, mbuffer, MSG_SIZE, MANY_LEN);
+
+	tids[0] = k_thread_create(&tdata, tstack, STACK_SIZE,
+				  reader_entry, &msgq, NULL, NULL,
+				  K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	/**TESTPOINT: the first message goes to the reader, the rest is queued*/
+	ret = k_msgq_put_many(&msgq, tx_data, MANY_LEN + 1, K_NO_WAIT);
+	zassert_equal(ret, MANY_LEN + 1);
+
+	/* the reader takes the queued messages without waiting again */
+	k_thread_join(tids[0], K_FOREVER);
+	tids[0] = NULL;
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+	for (int i = 0; i < MANY_LEN + 1; i++) {
+		zassert_equal(rx_data[i], tx_data[i]);
+	}
+}
+
+/**
+ * @}
+ */
@@ -693,6 +693,176 @@ ZTEST(obj_core_stats_mem_slab, test_obj_core_stats_mem_slab)
 	k_mem_slab_free(&mem_slab, mem2);
 }
 
+/***************** TIMEOUT QUEUES *********************/
+
+static int timeout_q_find(struct k_obj_core *obj_core, void *data)
+{
+	struct k_obj_core **first = data;
+
+	*first = obj_core;
+
+	return 1;    /* Only the first timeout queue is needed */
+}
+
+static void timeout_q_stats_raw(struct k_obj_core *obj_core,
+				struct k_timeout_q_stats *raw)
+{
+	int  status;
+
+	status = k_obj_core_stats_raw(obj_core, raw, sizeof(*raw));
+	zassert_equal(status, 0, "Failed to get raw stats (%d)\n", status);
+	zassert_true(raw->lock_contended <= raw->lock_acquired,
+		     "%llu contended out of %llu acquisitions\n",
+		     raw->lock_contended, raw->lock_acquired);
+}
+
+ZTEST(obj_core_stats_timeout_q, test_obj_core_stats_timeout_q)
+{
+	struct k_obj_core *obj_core = NULL;
+	struct k_obj_type *type;
+	struct k_timeout_q_stats raw;
+	struct k_timer timer;
+	int  status;
+
+	type = k_obj_type_find(K_OBJ_TYPE_TIMEOUT_Q_ID);
+	zassert_not_null(type, "Timeout queue object type not found\n");
+
+	k_obj_type_walk_unlocked(type, timeout_q_find, &obj_core);
+	zassert_not_null(obj_core, "No timeout queue linked\n");
+
+	status = k_obj_core_stats_reset(obj_core);
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	timeout_q_stats_raw(obj_core, &raw);
+	zassert_equal(raw.added, 0, "Expected 0 added, got %llu\n", raw.added);
+
+	/* Arm and abort a timeout, then let one expire */
+
+	k_timer_init(&timer, NULL, NULL);
+	k_timer_start(&timer, K_TICKS(1000), K_NO_WAIT);
+	k_timer_stop(&timer);
+	k_sleep(K_TICKS(1));
+
+	timeout_q_stats_raw(obj_core, &raw);
+	zassert_true(raw.added >= 2, "Expected >= 2 added, got %llu\n", raw.added);
+	zassert_true(raw.expired >= 1, "Expected >= 1 expired, got %llu\n",
+		     raw.expired);
+	zassert_true(raw.lock_acquired >= 3,
+		     "Expected >= 3 acquisitions, got %llu\n", raw.lock_acquired);
+
+	status = k_obj_core_stats_disable(obj_core);
+	zassert_equal(status, -ENOTSUP,
+		      "Not supposed to be supported. Got %d, not %d\n",
+		      status, -ENOTSUP);
+}
+
+/***************** MUTEXES *********************/
+
+#define MUTEX_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_mutex stats_mutex;
+static struct k_thread mutex_thread;
+static K_THREAD_STACK_DEFINE(mutex_stack, MUTEX_STACK_SIZE);
+
+static void mutex_locker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+	k_mutex_unlock(&stats_mutex);
+}
+
+static void mutex_trylocker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_mutex_lock(&stats_mutex, K_NO_WAIT), -EBUSY);
+}
+
+static void mutex_stats_raw(struct k_mutex_stats *raw)
+{
+	int  status;
+
+	status = k_obj_core_stats_raw(K_OBJ_CORE(&stats_mutex), raw, sizeof(*raw));
+	zassert_equal(status, 0, "Failed to get raw stats (%d)\n", status);
+}
+
+ZTEST(obj_core_stats_mutex, test_obj_core_stats_mutex)
+{
+	struct k_mutex_stats raw;
+	int  status;
+
+	k_mutex_init(&stats_mutex);
+
+	mutex_stats_raw(&raw);
+	zassert_equal(raw.acquired, 0, "Expected 0 acquired, got %llu\n", raw.acquired);
+
+	/* Recursive locks are not counted */
+
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+	k_mutex_unlock(&stats_mutex);
+	k_mutex_unlock(&stats_mutex);
+
+	mutex_stats_raw(&raw);
+	zassert_equal(raw.acquired, 1, "Expected 1 acquired, got %llu\n", raw.acquired);
+	zassert_equal(raw.contended, 0, "Expected 0 contended, got %llu\n",
+		      raw.contended);
+
+	/* Have another thread pend on the mutex, then hand it over */
+
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+	k_thread_create(&mutex_thread, mutex_stack, MUTEX_STACK_SIZE,
+			mutex_locker, NULL, NULL, NULL,
+			K_HIGHEST_THREAD_PRIO, 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+	k_mutex_unlock(&stats_mutex);
+	k_thread_join(&mutex_thread, K_FOREVER);
+
+	mutex_stats_raw(&raw);
+	zassert_equal(raw.acquired, 3, "Expected 3 acquired, got %llu\n", raw.acquired);
+	zassert_equal(raw.contended, 1, "Expected 1 contended, got %llu\n",
+		      raw.contended);
+	zassert_equal(raw.blocked, 1, "Expected 1 blocked, got %llu\n", raw.blocked);
+	zassert_true(raw.spin_acquired <= raw.spun,
+		     "%llu spins acquired out of %llu\n", raw.spin_acquired, raw.spun);
+	zassert_true(raw.hold_max > 0, "Expected hold time, got %u\n", raw.hold_max);
+	zassert_true(raw.hold_cycles >= raw.hold_max,
+		     "Total hold time %llu below longest %u\n",
+		     raw.hold_cycles, raw.hold_max);
+
+	/* A mutex that cannot be locked is contended, but does not pend */
+
+	k_mutex_lock(&stats_mutex, K_FOREVER);
+	k_thread_create(&mutex_thread, mutex_stack, MUTEX_STACK_SIZE,
+			mutex_trylocker, NULL, NULL, NULL,
+			K_HIGHEST_THREAD_PRIO, 0, K_NO_WAIT);
+	k_thread_join(&mutex_thread, K_FOREVER);
+	k_mutex_unlock(&stats_mutex);
+
+	mutex_stats_raw(&raw);
+	zassert_equal(raw.contended, 2, "Expected 2 contended, got %llu\n",
+		      raw.contended);
+	zassert_equal(raw.blocked, 1, "Expected 1 blocked, got %llu\n", raw.blocked);
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&stats_mutex));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	mutex_stats_raw(&raw);
+	zassert_equal(raw.acquired, 0, "Expected 0 acquired, got %llu\n", raw.acquired);
+	zassert_equal(raw.hold_cycles, 0, "Expected 0 cycles, got %llu\n",
+		      raw.hold_cycles);
+
+	status = k_obj_core_stats_disable(K_OBJ_CORE(&stats_mutex));
+	zassert_equal(status, -ENOTSUP,
+		      "Not supposed to be supported. Got %d, not %d\n",
+		      status, -ENOTSUP);
+}
+
 ZTEST_SUITE(obj_core_stats_system, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
 
@@ -704,3 +874,9 @@ ZTEST_SUITE(obj_core_stats_mem_block, NULL, NULL,
 
 ZTEST_SUITE(obj_core_stats_mem_slab, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+
+ZTEST_SUITE(obj_core_stats_timeout_q, NULL, NULL,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+
+ZTEST_SUITE(obj_core_stats_mutex, NULL, NULL,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
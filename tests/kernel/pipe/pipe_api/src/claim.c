@@ -0,0 +1,251 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+ZTEST_SUITE(k_pipe_claim, NULL, NULL, NULL, NULL, NULL);
+
+#define PIPE_SIZE 16
+static const int claim_wait_time = 2000;
+static struct k_thread thread;
+static K_THREAD_STACK_DEFINE(stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_pipe pipe;
+static uint8_t buffer[PIPE_SIZE];
+
+static void thread_write_claim(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *data;
+	int rc;
+
+	rc = k_pipe_write_claim((struct k_pipe *)arg1, &data, PIPE_SIZE / 2,
+				K_MSEC(claim_wait_time));
+	zassert_equal(rc, PIPE_SIZE / 2, "Failed to claim space in pipe");
+	memset(data, 0xaa, rc);
+	zassert_ok(k_pipe_write_commit((struct k_pipe *)arg1, rc));
+}
+
+static void thread_read_claim(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *data;
+	int rc;
+
+	rc = k_pipe_read_claim((struct k_pipe *)arg1, &data, PIPE_SIZE,
+			       K_MSEC(claim_wait_time));
+	zassert_true(rc > 0, "Failed to claim data in pipe");
+	zassert_ok(k_pipe_read_commit((struct k_pipe *)arg1, rc));
+}
+
+ZTEST(k_pipe_claim, test_write_claim_read)
+{
+	uint8_t *data;
+	uint8_t read_data[PIPE_SIZE];
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write_claim(&pipe, &data, 4, K_NO_WAIT), 4,
+		      "Failed to claim space in pipe");
+	zassert_equal(data, buffer, "Claimed area not in pipe storage");
+	memcpy(data, "abcd", 4);
+	zassert_equal(k_pipe_read(&pipe, read_data, 1, K_NO_WAIT), -EAGAIN,
+		      "Uncommitted data should not be readable");
+
+	/* commit less than claimed, the rest is given back */
+	zassert_ok(k_pipe_write_commit(&pipe, 3));
+	zassert_equal(k_pipe_write_commit(&pipe, 1), -EINVAL,
+		      "Commit without claim should fail");
+	zassert_equal(k_pipe_read(&pipe, read_data, sizeof(read_data), K_NO_WAIT), 3,
+		      "Failed to read committed data");
+	zassert_mem_equal(read_data, "abc", 3);
+}
+
+ZTEST(k_pipe_claim, test_read_claim_write)
+{
+	uint8_t *data;
+	uint8_t garbage[PIPE_SIZE] = { 1, 2, 3, 4 };
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT), PIPE_SIZE);
+	zassert_equal(k_pipe_read_claim(&pipe, &data, 4, K_NO_WAIT), 4,
+		      "Failed to claim data in pipe");
+	zassert_mem_equal(data, garbage, 4);
+
+	/* claimed data is still in the pipe until committed */
+	zassert_equal(k_pipe_write(&pipe, garbage, 1, K_NO_WAIT), -EAGAIN,
+		      "Pipe should still be full");
+	zassert_equal(k_pipe_read_commit(&pipe, 5), -EINVAL,
+		      "Commit larger than claim should fail");
+	zassert_ok(k_pipe_read_commit(&pipe, 2));
+	zassert_equal(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT), 2,
+		      "Released space should be writable");
+	zassert_equal(k_pipe_read_claim(&pipe, &data, 1, K_NO_WAIT), 1);
+	zassert_equal(*data, garbage[2], "Uncommitted data should be read again");
+	zassert_ok(k_pipe_read_commit(&pipe, 1));
+}
+
+ZTEST(k_pipe_claim, test_claim_wrap_around)
+{
+	uint8_t *data;
+	uint8_t garbage[PIPE_SIZE] = {};
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write(&pipe, garbage, PIPE_SIZE - 2, K_NO_WAIT), PIPE_SIZE - 2);
+	zassert_equal(k_pipe_read(&pipe, garbage, PIPE_SIZE - 2, K_NO_WAIT), PIPE_SIZE - 2);
+
+	/* only the contiguous area up to the end of the buffer is claimed */
+	zassert_equal(k_pipe_write_claim(&pipe, &data, PIPE_SIZE, K_NO_WAIT), 2);
+	zassert_ok(k_pipe_write_commit(&pipe, 2));
+	zassert_equal(k_pipe_write_claim(&pipe, &data, PIPE_SIZE, K_NO_WAIT), PIPE_SIZE - 2);
+	zassert_equal(data, buffer, "Claim should start at the beginning of the buffer");
+	zassert_ok(k_pipe_write_commit(&pipe, PIPE_SIZE - 2));
+
+	zassert_equal(k_pipe_read_claim(&pipe, &data, PIPE_SIZE, K_NO_WAIT), 2);
+	zassert_ok(k_pipe_read_commit(&pipe, 2));
+	zassert_equal(k_pipe_read_claim(&pipe, &data, PIPE_SIZE, K_NO_WAIT), PIPE_SIZE - 2);
+	zassert_ok(k_pipe_read_commit(&pipe, PIPE_SIZE - 2));
+}
+
+ZTEST(k_pipe_claim, test_invalid_claim)
+{
+	uint8_t *data;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write_claim(&pipe, &data, 0, K_NO_WAIT), -EINVAL);
+	zassert_equal(k_pipe_read_claim(&pipe, &data, 0, K_NO_WAIT), -EINVAL);
+	zassert_equal(k_pipe_read_claim(&pipe, &data, 1, K_MSEC(100)), -EAGAIN);
+
+	k_pipe_init(&pipe, NULL, 0);
+	zassert_equal(k_pipe_write_claim(&pipe, &data, 1, K_NO_WAIT), -EINVAL);
+}
+
+ZTEST(k_pipe_claim, test_read_claim_wakeup)
+{
+	k_tid_t tid;
+	uint8_t *data;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_write_claim, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+
+	/**TESTPOINT: a blocked read claim is woken up by a write commit */
+	zassert_equal(k_pipe_read_claim(&pipe, &data, PIPE_SIZE, K_MSEC(claim_wait_time)),
+		      PIPE_SIZE / 2, "Failed to claim committed data");
+	zassert_equal(data[0], 0xaa, "Unexpected data claimed from pipe");
+	zassert_ok(k_pipe_read_commit(&pipe, PIPE_SIZE / 2));
+	k_thread_join(tid, K_FOREVER);
+}
+
+ZTEST(k_pipe_claim, test_write_claim_wakeup)
+{
+	k_tid_t tid;
+	uint8_t *data;
+	uint8_t garbage[PIPE_SIZE] = {};
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write(&pipe, garbage, sizeof(garbage), K_NO_WAIT), PIPE_SIZE);
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_read_claim, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+
+	/**TESTPOINT: a blocked write claim is woken up by a read commit */
+	zassert_equal(k_pipe_write_claim(&pipe, &data, PIPE_SIZE, K_MSEC(claim_wait_time)),
+		      PIPE_SIZE, "Failed to claim released space");
+	zassert_ok(k_pipe_write_commit(&pipe, 0));
+	k_thread_join(tid, K_FOREVER);
+}
+
+ZTEST(k_pipe_claim, test_write_waits_for_commit)
+{
+	k_tid_t tid;
+	uint8_t *data;
+	uint8_t read_data[PIPE_SIZE];
+	uint8_t byte = 0x55;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write_claim(&pipe, &data, 1, K_NO_WAIT), 1);
+	*data = 0x11;
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_write_claim, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_NO_WAIT);
+	k_msleep(100);
+
+	/**TESTPOINT: writes are held back while a write claim is outstanding */
+	zassert_equal(k_pipe_write(&pipe, &byte, 1, K_NO_WAIT), -EAGAIN,
+		      "Write should wait for the outstanding claim");
+	zassert_ok(k_pipe_write_commit(&pipe, 1));
+	k_thread_join(tid, K_FOREVER);
+
+	zassert_equal(k_pipe_read(&pipe, read_data, sizeof(read_data), K_NO_WAIT),
+		      1 + PIPE_SIZE / 2, "Failed to read committed data");
+	zassert_equal(read_data[0], 0x11, "Data claimed first should be read first");
+	zassert_equal(read_data[1], 0xaa, "Unexpected data read from pipe");
+}
+
+ZTEST(k_pipe_claim, test_reset_cancels_claim)
+{
+	uint8_t *data;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write_claim(&pipe, &data, PIPE_SIZE, K_NO_WAIT), PIPE_SIZE);
+	k_pipe_reset(&pipe);
+	zassert_equal(k_pipe_write_commit(&pipe, PIPE_SIZE), -ECANCELED,
+		      "Claim should be cancelled by reset");
+	zassert_equal(k_pipe_write_commit(&pipe, PIPE_SIZE), -EINVAL,
+		      "Cancelled claim should be released");
+	zassert_equal(k_pipe_write_claim(&pipe, &data, PIPE_SIZE, K_NO_WAIT), PIPE_SIZE);
+	k_pipe_close(&pipe);
+	zassert_equal(k_pipe_write_commit(&pipe, PIPE_SIZE), -EPIPE,
+		      "Commit on closed pipe should fail");
+}
+
+ZTEST(k_pipe_claim, test_reset_between_write_claim_and_commit)
+{
+	uint8_t *data;
+	uint8_t *stale;
+	uint8_t read_data[PIPE_SIZE];
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write_claim(&pipe, &stale, 4, K_NO_WAIT), 4);
+	k_pipe_reset(&pipe);
+
+	/* the cancelled claim keeps the pipe from being written in place */
+	zassert_equal(k_pipe_write_claim(&pipe, &data, 4, K_NO_WAIT), -EAGAIN,
+		      "Cancelled claim should block new claims until committed");
+	zassert_equal(k_pipe_write(&pipe, "wxyz", 4, K_NO_WAIT), -EAGAIN,
+		      "Cancelled claim should block writes until committed");
+
+	memcpy(stale, "abcd", 4);
+	zassert_equal(k_pipe_write_commit(&pipe, 4), -ECANCELED,
+		      "Commit after reset should fail");
+	zassert_equal(k_pipe_read(&pipe, read_data, 1, K_NO_WAIT), -EAGAIN,
+		      "Cancelled data should not be readable");
+
+	zassert_equal(k_pipe_write(&pipe, "wxyz", 4, K_NO_WAIT), 4);
+	zassert_equal(k_pipe_read(&pipe, read_data, sizeof(read_data), K_NO_WAIT), 4,
+		      "Pipe should only hold data written after the reset");
+	zassert_mem_equal(read_data, "wxyz", 4);
+}
+
+ZTEST(k_pipe_claim, test_reset_between_read_claim_and_commit)
+{
+	uint8_t *data;
+	uint8_t read_data[PIPE_SIZE];
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_write(&pipe, "abcd", 4, K_NO_WAIT), 4);
+	zassert_equal(k_pipe_read_claim(&pipe, &data, 4, K_NO_WAIT), 4);
+	k_pipe_reset(&pipe);
+
+	zassert_equal(k_pipe_write(&pipe, "wxyz", 4, K_NO_WAIT), 4);
+	zassert_equal(k_pipe_read(&pipe, read_data, 1, K_NO_WAIT), -EAGAIN,
+		      "Cancelled claim should block reads until committed");
+
+	zassert_equal(k_pipe_read_commit(&pipe, 4), -ECANCELED,
+		      "Release after reset should fail");
+	zassert_equal(k_pipe_read(&pipe, read_data, sizeof(read_data), K_NO_WAIT), 4,
+		      "Release of a cancelled claim should not consume new data");
+	zassert_mem_equal(read_data, "wxyz", 4);
+}
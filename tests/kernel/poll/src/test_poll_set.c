@@ -0,0 +1,226 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define NUM_SET_SEMS 64
+#define SET_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_poll_set set;
+static struct k_sem set_sems[NUM_SET_SEMS];
+static struct k_poll_event set_events[NUM_SET_SEMS];
+static struct k_poll_signal set_signal;
+static struct k_poll_event signal_event;
+static struct k_thread set_thread;
+static K_THREAD_STACK_DEFINE(set_stack, SET_STACK_SIZE);
+
+static void init_sem_events(int num)
+{
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < num; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		zassert_ok(k_poll_set_add(&set, &set_events[i]));
+	}
+}
+
+static void remove_sem_events(int num)
+{
+	for (int i = 0; i < num; i++) {
+		zassert_ok(k_poll_set_remove(&set, &set_events[i]));
+	}
+}
+
+static void signal_raise_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_poll_signal_raise((struct k_poll_signal *)p1, 0x5a);
+}
+
+static void poll_take_entry(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+	struct k_poll_event event;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, sem);
+	zassert_ok(k_poll(&event, 1, K_FOREVER));
+	zassert_ok(k_sem_take(sem, K_NO_WAIT));
+}
+
+/**
+ * @brief Test adding and removing poll set events
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_add_remove)
+{
+	struct k_poll_set other;
+	struct k_poll_event ignored;
+	struct k_poll_event *ready[1];
+
+	init_sem_events(1);
+	k_poll_set_init(&other);
+	k_poll_event_init(&ignored, K_POLL_TYPE_IGNORE, K_POLL_MODE_NOTIFY_ONLY, &set_sems[0]);
+
+	zassert_equal(k_poll_set_add(&set, &ignored), -EINVAL);
+	zassert_equal(k_poll_set_add(&set, &set_events[0]), -EBUSY,
+		      "event added twice");
+	zassert_equal(k_poll_set_add(&other, &set_events[0]), -EBUSY,
+		      "event added to two sets");
+	zassert_equal(k_poll_set_remove(&other, &set_events[0]), -EINVAL,
+		      "event removed from a set it is not part of");
+	zassert_equal(k_poll_set_wait(&set, ready, 0, K_NO_WAIT), -EINVAL);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN);
+
+	/* a removed event is no longer reported, nor attached to its object */
+	remove_sem_events(1);
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_MSEC(10)), -EAGAIN);
+	zassert_equal(k_poll_set_remove(&set, &set_events[0]), -EINVAL);
+}
+
+/**
+ * @brief Test that a poll set only returns ready events
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_ready_events)
+{
+	struct k_poll_event *ready[4];
+	int rc;
+
+	init_sem_events(NUM_SET_SEMS);
+
+	/* already available when added, ready straight away */
+	zassert_ok(k_poll_set_remove(&set, &set_events[NUM_SET_SEMS - 1]));
+	k_sem_give(&set_sems[NUM_SET_SEMS - 1]);
+	zassert_ok(k_poll_set_add(&set, &set_events[NUM_SET_SEMS - 1]));
+
+	k_sem_give(&set_sems[3]);
+	k_sem_give(&set_sems[17]);
+	k_sem_give(&set_sems[42]);
+
+	/**TESTPOINT: only ready events are returned, up to max_events */
+	rc = k_poll_set_wait(&set, ready, 2, K_NO_WAIT);
+	zassert_equal(rc, 2);
+	zassert_equal_ptr(ready[0], &set_events[NUM_SET_SEMS - 1]);
+	zassert_equal_ptr(ready[1], &set_events[3]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_equal(ready[1]->state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_ok(k_sem_take(&set_sems[NUM_SET_SEMS - 1], K_NO_WAIT));
+	zassert_ok(k_sem_take(&set_sems[3], K_NO_WAIT));
+
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 2);
+	zassert_equal_ptr(ready[0], &set_events[17]);
+	zassert_equal_ptr(ready[1], &set_events[42]);
+
+	/**TESTPOINT: unprocessed events are returned again */
+	zassert_ok(k_sem_take(&set_sems[17], K_NO_WAIT));
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 1);
+	zassert_equal_ptr(ready[0], &set_events[42]);
+	zassert_ok(k_sem_take(&set_sems[42], K_NO_WAIT));
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT), -EAGAIN);
+
+	/* events stay registered across waits */
+	k_sem_give(&set_sems[17]);
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, 1);
+	zassert_equal_ptr(ready[0], &set_events[17]);
+	zassert_ok(k_sem_take(&set_sems[17], K_NO_WAIT));
+
+	remove_sem_events(NUM_SET_SEMS);
+}
+
+/**
+ * @brief Test that a thread waiting on a poll set is woken up
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait_wakeup)
+{
+	struct k_poll_event *ready[2];
+	k_tid_t tid;
+	unsigned int signaled;
+	int result;
+	int rc;
+
+	init_sem_events(NUM_SET_SEMS);
+	k_poll_signal_init(&set_signal);
+	k_poll_event_init(&signal_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+	zassert_ok(k_poll_set_add(&set, &signal_event));
+
+	tid = k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			      signal_raise_entry, &set_signal, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_MSEC(50));
+
+	/**TESTPOINT: a blocked wait is woken by the signal being raised */
+	rc = k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_MSEC(1000));
+	zassert_equal(rc, 1);
+	zassert_equal_ptr(ready[0], &signal_event);
+	zassert_equal(signal_event.state, K_POLL_STATE_SIGNALED);
+	k_poll_signal_check(&set_signal, &signaled, &result);
+	zassert_equal(signaled, 1);
+	zassert_equal(result, 0x5a);
+	k_poll_signal_reset(&set_signal);
+	k_thread_join(tid, K_FOREVER);
+
+	/**TESTPOINT: a wait with no ready event times out */
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), K_MSEC(50)), -EAGAIN);
+
+	zassert_ok(k_poll_set_remove(&set, &signal_event));
+	remove_sem_events(NUM_SET_SEMS);
+}
+
+/**
+ * @brief Test that a polling thread is signaled before a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_with_k_poll)
+{
+	struct k_poll_event *ready[1];
+	k_tid_t tid;
+
+	init_sem_events(1);
+
+	tid = k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			      poll_take_entry, &set_sems[0], NULL, NULL,
+			      K_PRIO_COOP(0), 0, K_NO_WAIT);
+	k_msleep(50);
+
+	/**TESTPOINT: the polling thread gets the semaphore, the set does not */
+	k_sem_give(&set_sems[0]);
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN);
+
+	/* the set event is still registered with the semaphore */
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_ok(k_sem_take(&set_sems[0], K_NO_WAIT));
+
+	remove_sem_events(1);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for read-copy-update
+ * @defgroup kernel_rcu_tests RCU
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+#include <zephyr/kernel/rcu.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Long enough for the reader to be preempted by the test thread waking up */
+#define READ_TIME_US (100 * USEC_PER_MSEC)
+
+struct data {
+	struct k_rcu_head rcu;
+	int value;
+};
+
+static struct data data_a = { .value = 1 };
+static struct data data_b = { .value = 2 };
+static struct data *shared = &data_a;
+
+static K_THREAD_STACK_DEFINE(reader_stack, STACK_SIZE);
+static struct k_thread reader_thread;
+
+static volatile bool reading;
+static volatile bool done_reading;
+static volatile bool done_at_callback;
+static K_SEM_DEFINE(callback_sem, 0, 1);
+
+/* Enters a read-side critical section and stays in it for a while */
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	struct data *d;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_rcu_read_lock();
+	d = k_rcu_dereference(shared);
+	reading = true;
+
+	k_busy_wait(READ_TIME_US);
+
+	zassert_equal(d->value, 1, "data reclaimed while in use");
+	done_reading = true;
+	k_rcu_read_unlock();
+}
+
+/* Starts a reader that gets preempted within its critical section */
+static void start_reader(void)
+{
+	k_thread_create(&reader_thread, reader_stack, STACK_SIZE, reader_entry,
+			NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+
+	while (!reading) {
+		k_msleep(10);
+	}
+	zassert_false(done_reading);
+}
+
+/* Reclaims the old data, which the reader may still be using */
+static void reclaim(struct k_rcu_head *head)
+{
+	struct data *d = CONTAINER_OF(head, struct data, rcu);
+
+	done_at_callback = done_reading;
+	d->value = 0;
+	k_sem_give(&callback_sem);
+}
+
+static void isr_reader(const void *p)
+{
+	ARG_UNUSED(p);
+
+	k_rcu_read_lock();
+	zassert_equal(k_rcu_dereference(shared)->value, 1);
+	k_rcu_read_unlock();
+}
+
+/**
+ * @brief Test nested and ISR read-side critical sections
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_read_lock(), k_rcu_read_unlock()
+ */
+ZTEST(rcu, test_rcu_read_nesting)
+{
+	k_rcu_read_lock();
+	k_rcu_read_lock();
+	zassert_equal(k_rcu_dereference(shared)->value, 1);
+	irq_offload(isr_reader, NULL);
+	k_rcu_read_unlock();
+	zassert_equal(k_rcu_dereference(shared)->value, 1);
+	k_rcu_read_unlock();
+
+	/**TESTPOINT: without readers, a grace period ends right away */
+	k_rcu_synchronize();
+}
+
+/**
+ * @brief Test a grace period waits for a preempted reader
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_synchronize()
+ */
+ZTEST(rcu, test_rcu_synchronize)
+{
+	start_reader();
+
+	k_rcu_assign_pointer(shared, &data_b);
+	k_rcu_synchronize();
+
+	/**TESTPOINT: the reader left its critical section first */
+	zassert_true(done_reading);
+	zassert_ok(k_thread_join(&reader_thread, K_FOREVER));
+}
+
+/**
+ * @brief Test deferred reclamation waits for a preempted reader
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_call()
+ */
+ZTEST(rcu, test_rcu_call)
+{
+	start_reader();
+
+	k_rcu_assign_pointer(shared, &data_b);
+	k_rcu_call(&data_a.rcu, reclaim);
+
+	zassert_ok(k_sem_take(&callback_sem, K_SECONDS(1)));
+
+	/**TESTPOINT: the callback ran once the reader was done */
+	zassert_true(done_at_callback);
+	zassert_equal(data_a.value, 0);
+	zassert_ok(k_thread_join(&reader_thread, K_FOREVER));
+}
+
+/**
+ * @brief Test a reader aborted within its critical section
+ *
+ * @ingroup kernel_rcu_tests
+ *
+ * @see k_rcu_synchronize()
+ */
+ZTEST(rcu, test_rcu_reader_abort)
+{
+	start_reader();
+
+	k_thread_abort(&reader_thread);
+
+	/**TESTPOINT: an aborted reader does not hold up grace periods */
+	k_rcu_synchronize();
+	zassert_false(done_reading);
+}
+
+static void rcu_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	data_a.value = 1;
+	data_b.value = 2;
+	shared = &data_a;
+	reading = false;
+	done_reading = false;
+	done_at_callback = false;
+}
+
+ZTEST_SUITE(rcu, NULL, NULL, rcu_before, NULL, NULL);
@@ -0,0 +1,276 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for reader-writer lock objects
+ * @defgroup kernel_rwlock_tests Reader-Writer Locks
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS 3
+
+K_RWLOCK_DEFINE(rwlock, 0);
+K_RWLOCK_DEFINE(pi_rwlock, K_RWLOCK_PRIO_INHERIT);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static struct k_rwlock init_rwlock;
+
+/* Order in which helper threads got the lock */
+static ZTEST_BMEM int order[NUM_THREADS];
+static ZTEST_BMEM atomic_t order_idx;
+static ZTEST_BMEM atomic_t holding;
+
+enum helper_op {
+	OP_READ,
+	OP_WRITE,
+};
+
+static void helper_entry(void *p1, void *p2, void *p3)
+{
+	struct k_rwlock *lock = p1;
+	enum helper_op op = (enum helper_op)(uintptr_t)p2;
+	int id = (int)(uintptr_t)p3;
+
+	if (op == OP_READ) {
+		zassert_ok(k_rwlock_read_lock(lock, K_FOREVER));
+	} else {
+		zassert_ok(k_rwlock_write_lock(lock, K_FOREVER));
+	}
+
+	order[atomic_inc(&order_idx)] = id;
+	atomic_inc(&holding);
+
+	/* Hold the lock for a while, so that the test can observe it */
+	k_msleep(100);
+
+	atomic_dec(&holding);
+	if (op == OP_READ) {
+		zassert_ok(k_rwlock_read_unlock(lock));
+	} else {
+		zassert_ok(k_rwlock_write_unlock(lock));
+	}
+}
+
+static k_tid_t start_helper(int id, struct k_rwlock *lock, enum helper_op op, int prio)
+{
+	return k_thread_create(&threads[id], stacks[id], STACK_SIZE, helper_entry,
+			       lock, (void *)(uintptr_t)op, (void *)(uintptr_t)id,
+			       prio, K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+}
+
+static void join_helpers(int num)
+{
+	for (int i = 0; i < num; i++) {
+		zassert_ok(k_thread_join(&threads[i], K_FOREVER));
+	}
+}
+
+/**
+ * @brief Test initialization options
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_init()
+ */
+ZTEST_USER(rwlock, test_rwlock_init)
+{
+	zassert_equal(k_rwlock_init(&init_rwlock, BIT(7)), -EINVAL);
+	zassert_ok(k_rwlock_init(&init_rwlock, 0));
+	zassert_ok(k_rwlock_init(&init_rwlock, K_RWLOCK_PRIO_INHERIT));
+}
+
+/**
+ * @brief Test that readers share the lock and writers do not
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_read_lock(), k_rwlock_write_lock()
+ */
+ZTEST_USER(rwlock, test_rwlock_exclusion)
+{
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+
+	/**TESTPOINT: a writer cannot get a lock held by readers */
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_MSEC(10)), -EAGAIN);
+
+	/* Readers are still let in once the writer gave up */
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+
+	for (int i = 0; i < 3; i++) {
+		zassert_ok(k_rwlock_read_unlock(&rwlock));
+	}
+	zassert_equal(k_rwlock_read_unlock(&rwlock), -EINVAL);
+
+	/**TESTPOINT: nobody else gets a lock held by a writer */
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_MSEC(10)), -EDEADLK);
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), -EINVAL);
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	zassert_equal(k_rwlock_write_unlock(&rwlock), -EPERM);
+}
+
+/**
+ * @brief Test that several threads hold the lock for reading at once
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_read_lock()
+ */
+ZTEST_USER(rwlock, test_rwlock_concurrent_readers)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		start_helper(i, &rwlock, OP_READ, K_PRIO_PREEMPT(0));
+	}
+
+	k_msleep(10);
+	zassert_equal(atomic_get(&holding), NUM_THREADS);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY);
+
+	/* The writer gets the lock once all readers released it */
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_FOREVER));
+	zassert_equal(atomic_get(&holding), 0);
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+
+	join_helpers(NUM_THREADS);
+}
+
+/**
+ * @brief Test that waiting writers hold off new readers
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_read_lock(), k_rwlock_write_lock(), k_rwlock_write_unlock()
+ */
+ZTEST_USER(rwlock, test_rwlock_writer_preference)
+{
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+
+	/* A writer waits for the reader, then a reader waits for the writer */
+	start_helper(0, &rwlock, OP_WRITE, K_PRIO_PREEMPT(0));
+	k_msleep(10);
+	start_helper(1, &rwlock, OP_READ, K_PRIO_PREEMPT(0));
+	k_msleep(10);
+
+	/**TESTPOINT: new readers wait behind the waiting writer */
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(atomic_get(&holding), 0);
+
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	join_helpers(2);
+
+	zassert_equal(order[0], 0, "writer did not get the lock first");
+	zassert_equal(order[1], 1);
+}
+
+/**
+ * @brief Test that waiting readers get the lock together
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_write_unlock()
+ */
+ZTEST_USER(rwlock, test_rwlock_readers_released)
+{
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		start_helper(i, &rwlock, OP_READ, K_PRIO_PREEMPT(0));
+	}
+	k_msleep(10);
+	zassert_equal(atomic_get(&holding), 0);
+
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	k_msleep(10);
+
+	/**TESTPOINT: all waiting readers hold the lock */
+	zassert_equal(atomic_get(&holding), NUM_THREADS);
+
+	join_helpers(NUM_THREADS);
+}
+
+/**
+ * @brief Test that readers waiting behind a writer that timed out get in
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_write_lock()
+ */
+ZTEST_USER(rwlock, test_rwlock_writer_timeout)
+{
+	start_helper(0, &rwlock, OP_READ, K_PRIO_PREEMPT(0));
+	k_msleep(10);
+
+	/* A reader waits behind this writer, which then gives up */
+	start_helper(1, &rwlock, OP_READ, K_PRIO_PREEMPT(0));
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_MSEC(30)), -EAGAIN);
+	k_msleep(10);
+
+	/**TESTPOINT: both readers hold the lock */
+	zassert_equal(atomic_get(&holding), 2);
+
+	join_helpers(2);
+}
+
+/**
+ * @brief Test priority inheritance
+ *
+ * @ingroup kernel_rwlock_tests
+ *
+ * @see k_rwlock_write_lock()
+ */
+ZTEST(rwlock, test_rwlock_prio_inherit)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	zassert_ok(k_rwlock_write_lock(&pi_rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+
+	start_helper(0, &pi_rwlock, OP_READ, prio - 2);
+	start_helper(1, &rwlock, OP_WRITE, prio - 2);
+	k_msleep(10);
+
+	/**TESTPOINT: only a lock with K_RWLOCK_PRIO_INHERIT boosts its writer */
+	zassert_equal(k_thread_priority_get(k_current_get()), prio - 2);
+
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	zassert_equal(k_thread_priority_get(k_current_get()), prio - 2);
+
+	zassert_ok(k_rwlock_write_unlock(&pi_rwlock));
+	zassert_equal(k_thread_priority_get(k_current_get()), prio);
+
+	join_helpers(2);
+}
+
+static void *rwlock_setup(void)
+{
+	k_thread_access_grant(k_current_get(), &rwlock, &pi_rwlock, &init_rwlock,
+			      &threads[0], &threads[1], &threads[2],
+			      &stacks[0], &stacks[1], &stacks[2]);
+
+	return NULL;
+}
+
+static void rwlock_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(order, 0, sizeof(order));
+	atomic_set(&order_idx, 0);
+	atomic_set(&holding, 0);
+}
+
+ZTEST_SUITE(rwlock, NULL, rwlock_setup, rwlock_before, NULL, NULL);
@@ -554,5 +554,83 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+#define NUM_WAKEUPS 3
+
+static K_SEM_DEFINE(wakeup_sem, 0, 1);
+
+/**
+ * @brief Helper thread to test_thread_stats_histograms()
+ */
+void helper_wakeups(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		k_sem_take(&wakeup_sem, K_FOREVER);
+	}
+}
+
+static uint32_t histogram_count(const struct k_cycle_histogram *hist)
+{
+	uint32_t  count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(hist->buckets); i++) {
+		count += hist->buckets[i];
+	}
+
+	return count;
+}
+
+/**
+ * @brief Test the scheduling latency histograms
+ *
+ * Wake up a higher priority helper thread a number of times, and verify
+ * that each wakeup and each usage window of the helper thread is counted
+ * once.
+ */
+ZTEST(usage_api, test_thread_stats_histograms)
+{
+	k_tid_t  tid;
+	int  priority;
+	k_thread_runtime_stats_t  stats1;
+	k_thread_runtime_stats_t  stats2;
+	k_thread_runtime_stats_t  cpu_stats;
+
+	priority = k_thread_priority_get(_current);
+
+	/*
+	 * The helper thread runs as soon as this thread yields, until it
+	 * pends on the semaphore.
+	 */
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_wakeups, NULL, NULL, NULL,
+			      priority - 1, 0, K_NO_WAIT);
+	k_yield();
+
+	k_thread_runtime_stats_get(tid, &stats1);
+	zassert_equal(histogram_count(&stats1.wakeup_latency), 1);
+	zassert_equal(histogram_count(&stats1.run_length), 1);
+
+	for (int i = 0; i < NUM_WAKEUPS; i++) {
+		k_sem_give(&wakeup_sem);
+		k_yield();
+	}
+
+	k_thread_runtime_stats_get(tid, &stats2);
+	zassert_equal(histogram_count(&stats2.wakeup_latency), 1 + NUM_WAKEUPS);
+	zassert_equal(histogram_count(&stats2.run_length), 1 + NUM_WAKEUPS);
+	zassert_true(stats2.run_length.sum >= stats1.run_length.sum);
+
+	/* The CPU histograms cover the helper thread as well */
+
+	k_thread_runtime_stats_cpu_get(0, &cpu_stats);
+	zassert_true(histogram_count(&cpu_stats.wakeup_latency) >= 1 + NUM_WAKEUPS);
+	zassert_true(histogram_count(&cpu_stats.run_length) >= 1 + NUM_WAKEUPS);
+
+	k_thread_join(tid, K_FOREVER);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -0,0 +1,280 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_WORKERS 3
+#define NUM_ITEMS (NUM_WORKERS + 1)
+#define WORKERS_PRIORITY K_PRIO_COOP(0)
+
+static K_THREAD_STACK_ARRAY_DEFINE(workers_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q_worker workers[NUM_WORKERS];
+static struct k_work_q workers_queue;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stop_stacks, 2, STACK_SIZE);
+static struct k_work_q_worker stop_workers[2];
+static struct k_work_q stop_queue;
+
+/* Given by handlers on completion */
+static struct k_sem done_sem;
+
+/* Given by the test to release blocking handlers */
+static struct k_sem block_sem;
+
+static struct k_work items[NUM_ITEMS];
+static k_tid_t item_thread[NUM_ITEMS];
+static atomic_t active;
+static atomic_t max_active;
+
+static struct k_work_sync work_sync;
+
+static void release_cb(struct k_timer *timer)
+{
+	k_sem_give(&block_sem);
+}
+
+static K_TIMER_DEFINE(releaser, release_cb, NULL);
+
+static void count_handler(struct k_work *work)
+{
+	item_thread[work - items] = k_current_get();
+	k_sem_give(&done_sem);
+}
+
+static void block_handler(struct k_work *work)
+{
+	atomic_val_t now = atomic_inc(&active) + 1;
+
+	if (now > atomic_get(&max_active)) {
+		atomic_set(&max_active, now);
+	}
+
+	item_thread[work - items] = k_current_get();
+	(void)k_sem_take(&block_sem, K_FOREVER);
+	atomic_dec(&active);
+	k_sem_give(&done_sem);
+}
+
+static void chain_handler(struct k_work *work)
+{
+	item_thread[work - items] = k_current_get();
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[1]), 1);
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[2]), 1);
+	(void)k_sem_take(&block_sem, K_FOREVER);
+	k_sem_give(&done_sem);
+}
+
+static bool is_worker(k_tid_t tid)
+{
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		if (tid == &workers[i].thread) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void wait_done(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_MSEC(1000)));
+	}
+}
+
+/* Verify that items submitted to a queue with several workers run in
+ * parallel, each on its own worker.
+ */
+ZTEST(work_workers, test_workers_parallel)
+{
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&items[i], block_handler);
+		zassert_equal(k_work_submit_to_queue(&workers_queue, &items[i]), 1);
+	}
+
+	/* Let the workers pick up the items */
+	k_yield();
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_equal(k_work_busy_get(&items[i]), K_WORK_RUNNING);
+		zassert_true(is_worker(item_thread[i]));
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(item_thread[i], item_thread[j],
+					  "items %d and %d ran on the same worker", i, j);
+		}
+	}
+	zassert_equal(atomic_get(&max_active), NUM_WORKERS);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_sem_give(&block_sem);
+	}
+	wait_done(NUM_WORKERS);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+}
+
+/* Verify that an item resubmitted while running is not run by another
+ * worker until it has completed.
+ */
+ZTEST(work_workers, test_workers_reentrant)
+{
+	k_tid_t first;
+
+	k_work_init(&items[0], block_handler);
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[0]), 1);
+	k_yield();
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING);
+	first = item_thread[0];
+
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[0]), 2);
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* Idle workers must leave the item alone */
+	k_yield();
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING | K_WORK_QUEUED);
+	zassert_equal(atomic_get(&max_active), 1);
+
+	/* Once released, the same worker runs the item again */
+	k_sem_give(&block_sem);
+	wait_done(1);
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING);
+	zassert_equal(item_thread[0], first);
+	zassert_equal(atomic_get(&max_active), 1);
+
+	k_sem_give(&block_sem);
+	wait_done(1);
+}
+
+/* Verify that items chained from a blocked handler are taken by idle
+ * workers.
+ */
+ZTEST(work_workers, test_workers_steal)
+{
+	k_work_init(&items[0], chain_handler);
+	k_work_init(&items[1], count_handler);
+	k_work_init(&items[2], count_handler);
+
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[0]), 1);
+
+	/* The chained items complete while their submitter is blocked */
+	wait_done(2);
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING);
+	zassert_true(is_worker(item_thread[1]));
+	zassert_true(is_worker(item_thread[2]));
+	zassert_not_equal(item_thread[1], item_thread[0]);
+	zassert_not_equal(item_thread[2], item_thread[0]);
+
+	k_sem_give(&block_sem);
+	wait_done(1);
+}
+
+/* Verify flushing and cancelling of queued and running items. */
+ZTEST(work_workers, test_workers_flush_cancel)
+{
+	/* Keep all workers busy, so that the last item stays queued */
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&items[i], block_handler);
+		zassert_equal(k_work_submit_to_queue(&workers_queue, &items[i]), 1);
+	}
+	k_work_init(&items[NUM_WORKERS], count_handler);
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[NUM_WORKERS]), 1);
+	k_yield();
+	zassert_equal(k_work_busy_get(&items[NUM_WORKERS]), K_WORK_QUEUED);
+
+	/* A queued item is flushed once it has run */
+	k_timer_start(&releaser, K_TICKS(1), K_TICKS(1));
+	zassert_true(k_work_flush(&items[NUM_WORKERS], &work_sync));
+	zassert_equal(k_work_busy_get(&items[NUM_WORKERS]), 0);
+	k_timer_stop(&releaser);
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_sem_give(&block_sem);
+	}
+	wait_done(NUM_ITEMS);
+	k_sem_reset(&block_sem);
+
+	/* A queued item is removed from its worker by cancellation */
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_equal(k_work_submit_to_queue(&workers_queue, &items[i]), 1);
+	}
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[NUM_WORKERS]), 1);
+	k_yield();
+	zassert_equal(k_work_cancel(&items[NUM_WORKERS]), 0);
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_sem_give(&block_sem);
+	}
+	wait_done(NUM_WORKERS);
+	zassert_equal(k_sem_take(&done_sem, K_MSEC(10)), -EAGAIN);
+
+	/* A running item is flushed once it has completed */
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[0]), 1);
+	k_yield();
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING);
+	k_timer_start(&releaser, K_TICKS(1), K_NO_WAIT);
+	zassert_true(k_work_flush(&items[0], &work_sync));
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+	wait_done(1);
+
+	/* A running item is cancelled once it has completed */
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &items[0]), 1);
+	k_yield();
+	k_timer_start(&releaser, K_TICKS(1), K_NO_WAIT);
+	zassert_true(k_work_cancel_sync(&items[0], &work_sync));
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+	wait_done(1);
+}
+
+/* Verify draining and stopping a queue with several workers. */
+ZTEST(work_workers, test_workers_drain_stop)
+{
+	k_work_queue_start_workers(&stop_queue, stop_workers, ARRAY_SIZE(stop_workers),
+				   stop_stacks[0], STACK_SIZE, WORKERS_PRIORITY, NULL);
+
+	zassert_equal(k_work_queue_stop(&stop_queue, K_FOREVER), -EBUSY);
+
+	k_work_init(&items[0], count_handler);
+	k_work_init(&items[1], count_handler);
+	zassert_equal(k_work_submit_to_queue(&stop_queue, &items[0]), 1);
+	zassert_equal(k_work_submit_to_queue(&stop_queue, &items[1]), 1);
+
+	zassert_equal(k_work_queue_drain(&stop_queue, true), 1);
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+	zassert_equal(k_work_busy_get(&items[1]), 0);
+	wait_done(2);
+	zassert_equal(k_work_submit_to_queue(&stop_queue, &items[0]), -EBUSY);
+
+	zassert_ok(k_work_queue_stop(&stop_queue, K_FOREVER));
+	for (int i = 0; i < ARRAY_SIZE(stop_workers); i++) {
+		zassert_ok(k_thread_join(&stop_workers[i].thread, K_NO_WAIT));
+	}
+	zassert_equal(k_work_queue_stop(&stop_queue, K_FOREVER), -EALREADY);
+	zassert_equal(k_work_submit_to_queue(&stop_queue, &items[0]), -ENODEV);
+}
+
+static void *workers_setup(void)
+{
+	k_sem_init(&done_sem, 0, K_SEM_MAX_LIMIT);
+	k_sem_init(&block_sem, 0, K_SEM_MAX_LIMIT);
+
+	k_work_queue_init(&workers_queue);
+	k_work_queue_start_workers(&workers_queue, workers, ARRAY_SIZE(workers),
+				   workers_stacks[0], STACK_SIZE, WORKERS_PRIORITY, NULL);
+
+	return NULL;
+}
+
+static void workers_before(void *fixture)
+{
+	ztest_simple_1cpu_before(fixture);
+
+	memset(item_thread, 0, sizeof(item_thread));
+	atomic_set(&active, 0);
+	atomic_set(&max_active, 0);
+}
+
+ZTEST_SUITE(work_workers, NULL, workers_setup, workers_before, ztest_simple_1cpu_after, NULL);
@@ -14,6 +14,7 @@
 #define MAX_EVENTS 1024
 
 K_P4WQ_DEFINE(wq, MAX_NUM_THREADS, 2048);
+K_P4WQ_DEFINE(wq1, 1, 2048);
 
 static struct k_p4wq_work simple_item;
 static volatile int has_run;
@@ -274,5 +275,146 @@ ZTEST(lib_p4wq_1cpu, test_p4wq_simple)
 	zassert_true(has_run, "high-priority item didn't run");
 }
 
+#define NUM_ORDERED 4
+
+static struct k_p4wq_work ordered_items[NUM_ORDERED];
+static struct k_p4wq_work *ordered_run[NUM_ORDERED];
+static int ordered_prio[NUM_ORDERED];
+
+static void ordered_handler(struct k_p4wq_work *work)
+{
+	ordered_prio[run_count] = k_thread_priority_get(k_current_get());
+	ordered_run[run_count++] = work;
+}
+
+static void ordered_init(const int *prios, int num)
+{
+	run_count = 0;
+	memset(ordered_run, 0, sizeof(ordered_run));
+
+	for (int i = 0; i < num; i++) {
+		ordered_items[i] = (struct k_p4wq_work){};
+		ordered_items[i].priority = prios[i];
+		ordered_items[i].handler = ordered_handler;
+	}
+}
+
+/* Items submitted together run in priority order, at their priority */
+ZTEST(lib_p4wq_1cpu, test_p4wq_submit_many)
+{
+	static const int prios[NUM_ORDERED] = { 5, 3, 6, 4 };
+	static const int order[NUM_ORDERED] = { 1, 3, 0, 2 };
+	struct k_p4wq_work *batch[NUM_ORDERED];
+
+	k_thread_priority_set(k_current_get(), 2);
+
+	ordered_init(prios, NUM_ORDERED);
+	for (int i = 0; i < NUM_ORDERED; i++) {
+		batch[i] = &ordered_items[i];
+	}
+
+	k_p4wq_submit_many(&wq, batch, NUM_ORDERED);
+	zassert_equal(run_count, 0, "ran too early");
+
+	k_msleep(10);
+	zassert_equal(run_count, NUM_ORDERED, "Wrong run count: %d", run_count);
+
+	for (int i = 0; i < NUM_ORDERED; i++) {
+		zassert_equal_ptr(ordered_run[i], &ordered_items[order[i]],
+				  "item %d ran out of order", i);
+		zassert_equal(ordered_prio[i], prios[order[i]],
+			      "item %d ran with wrong priority", i);
+	}
+}
+
+#ifdef CONFIG_P4WQ_AGING
+/* An item that waited long enough runs ahead of later higher-priority
+ * ones, at its aged priority
+ */
+ZTEST(lib_p4wq_1cpu, test_p4wq_aging)
+{
+	static const int prios[2] = { 10, 5 };
+
+	k_thread_priority_set(k_current_get(), 2);
+	zassert_ok(k_p4wq_aging_set(&wq1, k_ms_to_cyc_ceil32(1)));
+
+	ordered_init(prios, 2);
+	k_p4wq_submit(&wq1, &ordered_items[0]);
+	zassert_equal(k_p4wq_aging_set(&wq1, 0), -EBUSY,
+		      "aging changed with items queued");
+
+	k_busy_wait(20 * USEC_PER_MSEC);
+	k_p4wq_submit(&wq1, &ordered_items[1]);
+
+	k_msleep(10);
+	zassert_equal(run_count, 2, "Wrong run count: %d", run_count);
+	zassert_equal_ptr(ordered_run[0], &ordered_items[0], "old item starved");
+	zassert_equal(ordered_prio[0], 0, "old item not aged: %d", ordered_prio[0]);
+
+	zassert_ok(k_p4wq_aging_set(&wq1, 0));
+}
+
+/* Aging stops at the highest preemptible priority, so an old
+ * preemptible item still runs after a cooperative one
+ */
+ZTEST(lib_p4wq_1cpu, test_p4wq_aging_coop)
+{
+	static const int prios[2] = { 10, -1 };
+
+	/* Cooperative, so that nothing runs before we sleep */
+	k_thread_priority_set(k_current_get(), K_HIGHEST_THREAD_PRIO);
+	zassert_ok(k_p4wq_aging_set(&wq1, k_ms_to_cyc_ceil32(1)));
+
+	ordered_init(prios, 2);
+	k_p4wq_submit(&wq1, &ordered_items[0]);
+	k_busy_wait(20 * USEC_PER_MSEC);
+	k_p4wq_submit(&wq1, &ordered_items[1]);
+
+	k_msleep(10);
+	zassert_equal(run_count, 2, "Wrong run count: %d", run_count);
+	zassert_equal_ptr(ordered_run[0], &ordered_items[1],
+			  "aged item ran before cooperative one");
+	zassert_equal(ordered_prio[0], -1, "wrong priority: %d", ordered_prio[0]);
+	zassert_equal(ordered_prio[1], 0, "old item not aged: %d", ordered_prio[1]);
+
+	zassert_ok(k_p4wq_aging_set(&wq1, 0));
+}
+#endif
+
+#ifdef CONFIG_P4WQ_STATS
+static void busy_handler(struct k_p4wq_work *work)
+{
+	k_busy_wait(USEC_PER_MSEC);
+}
+
+/* Statistics account for the time spent waiting and running */
+ZTEST(lib_p4wq_1cpu, test_p4wq_stats)
+{
+	struct k_p4wq_stats stats;
+
+	k_thread_priority_set(k_current_get(), 2);
+	k_p4wq_stats_reset(&wq1);
+
+	simple_item = (struct k_p4wq_work){};
+	simple_item.priority = 3;
+	simple_item.handler = busy_handler;
+	k_p4wq_submit(&wq1, &simple_item);
+
+	k_busy_wait(2 * USEC_PER_MSEC);
+	k_msleep(10);
+
+	k_p4wq_stats_get(&wq1, &stats);
+	zassert_equal(stats.count, 1, "Wrong count: %u", stats.count);
+	zassert_true(stats.wait_max >= k_ms_to_cyc_floor32(2), "wait not accounted");
+	zassert_equal(stats.wait_total, stats.wait_max);
+	zassert_true(stats.run_max >= k_ms_to_cyc_floor32(1), "run not accounted");
+	zassert_equal(stats.run_total, stats.run_max);
+
+	k_p4wq_stats_reset(&wq1);
+	k_p4wq_stats_get(&wq1, &stats);
+	zassert_equal(stats.count, 0, "stats not reset");
+}
+#endif
+
 ZTEST_SUITE(lib_p4wq, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(lib_p4wq_1cpu, NULL, NULL, ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -0,0 +1,248 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/radix_tree.h>
+
+#define NUM_NODES 256
+
+struct container {
+	struct radix_node node;
+	bool in_tree;
+};
+
+static struct container items[NUM_NODES];
+static uint64_t keys[NUM_NODES];
+static struct radix_tree tree;
+static uint32_t rand_state;
+
+static uint32_t rand32(void)
+{
+	/* xorshift32, for reproducible runs */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+/* Keys spread over the whole key space, and keys sharing long prefixes */
+static void make_keys(bool clustered)
+{
+	for (uint32_t i = 0; i < NUM_NODES; i++) {
+		if (clustered) {
+			keys[i] = 0xfedcba9800000000ULL + (i & 0xf) + ((i >> 4) << 20);
+		} else {
+			keys[i] = (i + 1) * 0x9e3779b97f4a7c15ULL;
+		}
+	}
+}
+
+static void check_tree(void)
+{
+	struct radix_node *node;
+	struct radix_node *prev = NULL;
+	size_t count = 0;
+	size_t expected = 0;
+
+	for (size_t i = 0; i < NUM_NODES; i++) {
+		node = radix_tree_find(&tree, keys[i]);
+		if (items[i].in_tree) {
+			zassert_equal_ptr(node, &items[i].node, "node %zu not found", i);
+			expected++;
+		} else {
+			zassert_is_null(node, "removed node %zu found", i);
+		}
+	}
+
+	RADIX_TREE_FOR_EACH(&tree, node) {
+		if (prev != NULL) {
+			zassert_true(radix_node_key(prev) < radix_node_key(node),
+				     "nodes out of order");
+		}
+		zassert_equal_ptr(radix_tree_prev(&tree, node), prev, "wrong previous node");
+		prev = node;
+		count++;
+	}
+
+	zassert_equal(count, expected, "walked %zu nodes, expected %zu", count, expected);
+	zassert_equal_ptr(radix_tree_get_max(&tree), prev, "wrong max node");
+	zassert_equal(radix_tree_is_empty(&tree), expected == 0U);
+}
+
+static struct radix_node *ref_lower_bound(uint64_t key)
+{
+	struct radix_node *best = NULL;
+
+	for (size_t i = 0; i < NUM_NODES; i++) {
+		if (items[i].in_tree && (keys[i] >= key) &&
+		    ((best == NULL) || (keys[i] < radix_node_key(best)))) {
+			best = &items[i].node;
+		}
+	}
+
+	return best;
+}
+
+static void fill(void)
+{
+	for (size_t i = 0; i < NUM_NODES; i++) {
+		zassert_ok(radix_tree_insert(&tree, &items[i].node, keys[i]));
+		items[i].in_tree = true;
+	}
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&tree, 0, sizeof(tree));
+	memset(items, 0, sizeof(items));
+	rand_state = 0x12345678U;
+	make_keys(false);
+}
+
+ZTEST(radix_tree, test_empty)
+{
+	zassert_true(radix_tree_is_empty(&tree));
+	zassert_is_null(radix_tree_get_min(&tree));
+	zassert_is_null(radix_tree_get_max(&tree));
+	zassert_is_null(radix_tree_find(&tree, 0));
+	zassert_is_null(radix_tree_lower_bound(&tree, 0));
+
+	zassert_ok(radix_tree_insert(&tree, &items[0].node, 42));
+	zassert_equal_ptr(radix_tree_get_min(&tree), &items[0].node);
+	zassert_equal_ptr(radix_tree_get_max(&tree), &items[0].node);
+	zassert_is_null(radix_tree_next(&tree, &items[0].node));
+	zassert_is_null(radix_tree_prev(&tree, &items[0].node));
+
+	radix_tree_remove(&tree, &items[0].node);
+	zassert_true(radix_tree_is_empty(&tree));
+	zassert_is_null(radix_tree_find(&tree, 42));
+}
+
+ZTEST(radix_tree, test_insert_remove)
+{
+	fill();
+	check_tree();
+
+	zassert_equal(radix_tree_insert(&tree, &items[0].node, keys[1]), -EEXIST,
+		      "duplicate key inserted");
+	check_tree();
+
+	/* Remove every other node, then the rest in reverse order */
+	for (size_t i = 0; i < NUM_NODES; i += 2) {
+		radix_tree_remove(&tree, &items[i].node);
+		items[i].in_tree = false;
+	}
+	check_tree();
+
+	for (size_t i = NUM_NODES; i-- > 0;) {
+		if (items[i].in_tree) {
+			radix_tree_remove(&tree, &items[i].node);
+			items[i].in_tree = false;
+		}
+	}
+	check_tree();
+}
+
+ZTEST(radix_tree, test_min_max)
+{
+	uint64_t min = UINT64_MAX;
+	uint64_t max = 0;
+
+	fill();
+
+	for (size_t i = 0; i < NUM_NODES; i++) {
+		min = MIN(min, keys[i]);
+		max = MAX(max, keys[i]);
+	}
+
+	zassert_equal(radix_node_key(radix_tree_get_min(&tree)), min);
+	zassert_equal(radix_node_key(radix_tree_get_max(&tree)), max);
+
+	/* Pop the minimum until empty, as a timeout queue would */
+	for (size_t i = 0; i < NUM_NODES; i++) {
+		struct radix_node *node = radix_tree_get_min(&tree);
+
+		zassert_not_null(node);
+		zassert_true(radix_node_key(node) >= min, "keys popped out of order");
+		min = radix_node_key(node);
+		radix_tree_remove(&tree, node);
+	}
+
+	zassert_true(radix_tree_is_empty(&tree));
+}
+
+ZTEST(radix_tree, test_lower_bound)
+{
+	for (int pass = 0; pass < 2; pass++) {
+		make_keys(pass == 1);
+		memset(&tree, 0, sizeof(tree));
+		fill();
+
+		for (size_t i = 0; i < NUM_NODES; i += 3) {
+			radix_tree_remove(&tree, &items[i].node);
+			items[i].in_tree = false;
+		}
+
+		for (size_t i = 0; i < NUM_NODES; i++) {
+			uint64_t probes[] = { keys[i], keys[i] - 1, keys[i] + 1,
+					      ((uint64_t)rand32() << 32) | rand32() };
+
+			for (size_t p = 0; p < ARRAY_SIZE(probes); p++) {
+				zassert_equal_ptr(radix_tree_lower_bound(&tree, probes[p]),
+						  ref_lower_bound(probes[p]),
+						  "wrong lower bound for %llx", probes[p]);
+			}
+		}
+
+		zassert_is_null(radix_tree_lower_bound(&tree, UINT64_MAX));
+	}
+}
+
+ZTEST(radix_tree, test_random)
+{
+	for (int pass = 0; pass < 2; pass++) {
+		make_keys(pass == 1);
+		memset(&tree, 0, sizeof(tree));
+		memset(items, 0, sizeof(items));
+
+		for (int step = 0; step < 20000; step++) {
+			size_t i = rand32() % NUM_NODES;
+
+			if (items[i].in_tree) {
+				radix_tree_remove(&tree, &items[i].node);
+			} else {
+				zassert_ok(radix_tree_insert(&tree, &items[i].node, keys[i]));
+			}
+			items[i].in_tree = !items[i].in_tree;
+
+			if ((step % 97) == 0) {
+				check_tree();
+			}
+		}
+
+		check_tree();
+	}
+}
+
+ZTEST(radix_tree, test_container)
+{
+	struct container *c;
+	size_t count = 0;
+
+	fill();
+
+	RADIX_TREE_FOR_EACH_CONTAINER(&tree, c, node) {
+		zassert_true(c->in_tree);
+		count++;
+	}
+
+	zassert_equal(count, NUM_NODES);
+}
+
+ZTEST_SUITE(radix_tree, NULL, NULL, before, NULL, NULL);
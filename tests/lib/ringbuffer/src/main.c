@@ -768,6 +768,59 @@ ZTEST(ringbuffer_api, test_reset)
 	zassert_true(granted == RINGBUFFER_SIZE);
 }
 
+ZTEST(ringbuffer_api, test_claim_vec)
+{
+	uint8_t indata[] = {1, 2, 3, 4, 5};
+	uint8_t outdata[RINGBUFFER_SIZE];
+	struct ring_buf_vec vec[2];
+	uint32_t granted;
+
+	ring_buf_init(&ringbuf_raw, RINGBUFFER_SIZE, ringbuf_raw.buffer);
+
+	/* Without wrapping, the second area is empty */
+	granted = ring_buf_put_claim_vec(&ringbuf_raw, vec, 3);
+	zassert_equal(granted, 3);
+	zassert_equal(vec[0].size, 3);
+	zassert_equal(vec[1].size, 0);
+	memcpy(vec[0].data, indata, 3);
+	zassert_ok(ring_buf_put_finish(&ringbuf_raw, 3));
+
+	granted = ring_buf_get_claim_vec(&ringbuf_raw, vec, RINGBUFFER_SIZE);
+	zassert_equal(granted, 3);
+	zassert_equal(vec[1].size, 0);
+	zassert_mem_equal(vec[0].data, indata, 3);
+	zassert_ok(ring_buf_get_finish(&ringbuf_raw, 3));
+
+	/**TESTPOINT: all the free space is claimed at once across the wrap */
+	granted = ring_buf_put_claim_vec(&ringbuf_raw, vec, RINGBUFFER_SIZE);
+	zassert_equal(granted, RINGBUFFER_SIZE);
+	zassert_equal(vec[0].size, RINGBUFFER_SIZE - 3);
+	zassert_equal(vec[1].size, 3);
+	zassert_equal_ptr(vec[1].data, ringbuf_raw.buffer);
+	memcpy(vec[0].data, indata, vec[0].size);
+	memcpy(vec[1].data, &indata[vec[0].size], vec[1].size);
+
+	/* Surplus bytes are returned */
+	zassert_equal(ring_buf_put_finish(&ringbuf_raw, RINGBUFFER_SIZE + 1), -EINVAL);
+	zassert_ok(ring_buf_put_finish(&ringbuf_raw, RINGBUFFER_SIZE - 1));
+	zassert_equal(ring_buf_size_get(&ringbuf_raw), RINGBUFFER_SIZE - 1);
+
+	/**TESTPOINT: all the data is claimed at once across the wrap */
+	granted = ring_buf_get_claim_vec(&ringbuf_raw, vec, RINGBUFFER_SIZE);
+	zassert_equal(granted, RINGBUFFER_SIZE - 1);
+	zassert_equal(vec[0].size, RINGBUFFER_SIZE - 3);
+	zassert_equal(vec[1].size, 2);
+	zassert_mem_equal(vec[0].data, indata, vec[0].size);
+	zassert_mem_equal(vec[1].data, &indata[vec[0].size], vec[1].size);
+	zassert_ok(ring_buf_get_finish(&ringbuf_raw, granted));
+	zassert_true(ring_buf_is_empty(&ringbuf_raw));
+
+	/* Regular accesses carry on after the wrap */
+	zassert_equal(ring_buf_put(&ringbuf_raw, indata, RINGBUFFER_SIZE), RINGBUFFER_SIZE);
+	zassert_equal(ring_buf_get(&ringbuf_raw, outdata, RINGBUFFER_SIZE), RINGBUFFER_SIZE);
+	zassert_mem_equal(outdata, indata, RINGBUFFER_SIZE);
+}
+
 static uint32_t ringbuf_stored[RINGBUFFER_SIZE];
 
 /**
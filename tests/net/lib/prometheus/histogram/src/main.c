@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 
 #include <zephyr/net/prometheus/histogram.h>
+#include <zephyr/net/prometheus/sched.h>
 
 PROMETHEUS_HISTOGRAM_DEFINE(test_histogram_m, "Test histogram",
 			    ({ .key = "test", .value = "histogram" }), NULL);
@@ -37,4 +38,52 @@ ZTEST(test_histogram, test_histogram_observe)
 	zassert_equal(test_histogram_m.sum, 3.0, "Histogram value is not 2");
 }
 
+#ifdef CONFIG_PROMETHEUS_SCHED_HISTOGRAMS
+PROMETHEUS_SCHED_HISTOGRAM_DEFINE(test_sched_histogram_m, "Test scheduling histogram",
+				  ({ .key = "test", .value = "sched" }), NULL);
+
+/**
+ * @brief Test prometheus_sched_histogram_set
+ *
+ * @details The test shall load a kernel log2 histogram and check that the
+ * buckets are made cumulative and that the count and sum are carried over.
+ *
+ * @details The test shall load the histograms of the current thread and
+ * check that they are consistent.
+ */
+ZTEST(test_histogram, test_sched_histogram_set)
+{
+	struct k_cycle_histogram hist = {
+		.buckets = { [0] = 1, [3] = 2 },
+		.sum = 20,
+	};
+	double freq = (double)sys_clock_hw_cycles_per_sec();
+	int ret;
+
+	ret = prometheus_sched_histogram_set(&test_sched_histogram_m, &hist);
+	zassert_ok(ret, "Error setting histogram");
+
+	zassert_equal(test_sched_histogram_m.num_buckets,
+		      CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS);
+	zassert_equal(test_sched_histogram_m.count, 3, "Histogram count is not 3");
+	zassert_equal(test_sched_histogram_m.sum, 20 / freq, "Histogram sum is wrong");
+	zassert_equal(test_sched_histogram_m.buckets[0].count, 1);
+	zassert_equal(test_sched_histogram_m.buckets[0].upper_bound, 1 / freq);
+	zassert_equal(test_sched_histogram_m.buckets[2].count, 1);
+	zassert_equal(test_sched_histogram_m.buckets[3].count, 3);
+	zassert_equal(test_sched_histogram_m.buckets[3].upper_bound, 15 / freq);
+	zassert_equal(test_sched_histogram_m.buckets[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS -
+						      1].upper_bound,
+		      PROMETHEUS_HISTOGRAM_INF, "Last bucket is not +Inf");
+	zassert_is_null(test_sched_histogram_m.user_data, "User data was used for buckets");
+
+	ret = prometheus_sched_thread_update(k_current_get(), &test_sched_histogram_m, NULL);
+	zassert_ok(ret, "Error updating histogram");
+	zassert_true(test_sched_histogram_m.count > 0, "Thread was never woken up");
+	zassert_equal(test_sched_histogram_m.buckets[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS -
+						      1].count,
+		      test_sched_histogram_m.count);
+}
+#endif /* CONFIG_PROMETHEUS_SCHED_HISTOGRAMS */
+
 ZTEST_SUITE(test_histogram, NULL, NULL, NULL, NULL, NULL);
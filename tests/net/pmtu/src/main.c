@@ -215,8 +215,10 @@ ZTEST(net_pmtu_test_suite, test_pmtu_01_ipv4_get_entry)
 	net_ipaddr_copy(&dest_ipv4.sin_addr, &dest_ipv4_addr1);
 	dest_ipv4.sin_family = NET_AF_INET;
 
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv4);
 	zassert_is_null(entry, "PMTU IPv4 entry is not NULL");
+	net_pmtu_read_unlock();
 
 	k_sleep(SMALL_SLEEP);
 #else
@@ -233,8 +235,10 @@ ZTEST(net_pmtu_test_suite, test_pmtu_01_ipv6_get_entry)
 	net_ipaddr_copy(&dest_ipv6.sin6_addr, &dest_ipv6_addr1);
 	dest_ipv6.sin6_family = NET_AF_INET6;
 
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv6);
 	zassert_is_null(entry, "PMTU IPv6 entry is not NULL");
+	net_pmtu_read_unlock();
 
 	k_sleep(SMALL_SLEEP);
 #else
@@ -291,9 +295,11 @@ ZTEST(net_pmtu_test_suite, test_pmtu_03_ipv4_create_more_entries)
 	net_ipaddr_copy(&dest_ipv4.sin_addr, &dest_ipv4_addr1);
 	ret = net_pmtu_update_mtu((struct net_sockaddr *)&dest_ipv4, 1300);
 	zassert_equal(ret, 1300, "PMTU IPv4 MTU update failed (%d)", ret);
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv4);
 	zassert_equal(entry->mtu, 1300, "PMTU IPv4 MTU is not correct (%d)",
 		      entry->mtu);
+	net_pmtu_read_unlock();
 
 	k_sleep(SMALL_SLEEP);
 
@@ -308,15 +314,19 @@ ZTEST(net_pmtu_test_suite, test_pmtu_03_ipv4_create_more_entries)
 	net_ipaddr_copy(&dest_ipv4.sin_addr, &dest_ipv4_addr3);
 	ret = net_pmtu_update_mtu((struct net_sockaddr *)&dest_ipv4, 1500);
 	zassert_equal(ret, 0, "PMTU IPv4 MTU update failed (%d)", ret);
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv4);
 	zassert_equal(entry->mtu, 1500, "PMTU IPv4 MTU is not correct (%d)",
 		      entry->mtu);
+	net_pmtu_read_unlock();
 
 	net_ipaddr_copy(&dest_ipv4.sin_addr, &dest_ipv4_addr_not_found);
 	ret = net_pmtu_get_mtu((struct net_sockaddr *)&dest_ipv4);
 	zassert_equal(ret, -ENOENT, "PMTU IPv4 MTU update succeed (%d)", ret);
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv4);
 	zassert_equal(entry, NULL, "PMTU IPv4 MTU update succeed");
+	net_pmtu_read_unlock();
 #else
 	ztest_test_skip();
 #endif
@@ -335,9 +345,11 @@ ZTEST(net_pmtu_test_suite, test_pmtu_03_ipv6_create_more_entries)
 	net_ipaddr_copy(&dest_ipv6.sin6_addr, &dest_ipv6_addr1);
 	ret = net_pmtu_update_mtu((struct net_sockaddr *)&dest_ipv6, 1600);
 	zassert_equal(ret, 1600, "PMTU IPv6 MTU update failed (%d)", ret);
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv6);
 	zassert_equal(entry->mtu, 1600, "PMTU IPv6 MTU is not correct (%d)",
 		      entry->mtu);
+	net_pmtu_read_unlock();
 
 	k_sleep(SMALL_SLEEP);
 
@@ -352,15 +364,19 @@ ZTEST(net_pmtu_test_suite, test_pmtu_03_ipv6_create_more_entries)
 	net_ipaddr_copy(&dest_ipv6.sin6_addr, &dest_ipv6_addr3);
 	ret = net_pmtu_update_mtu((struct net_sockaddr *)&dest_ipv6, 1800);
 	zassert_equal(ret, 0, "PMTU IPv6 MTU update failed (%d)", ret);
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv6);
 	zassert_equal(entry->mtu, 1800, "PMTU IPv6 MTU is not correct (%d)",
 		      entry->mtu);
+	net_pmtu_read_unlock();
 
 	net_ipaddr_copy(&dest_ipv6.sin6_addr, &dest_ipv6_addr_not_found);
 	ret = net_pmtu_get_mtu((struct net_sockaddr *)&dest_ipv6);
 	zassert_equal(ret, -ENOENT, "PMTU IPv6 MTU update succeed (%d)", ret);
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv6);
 	zassert_equal(entry, NULL, "PMTU IPv6 MTU update succeed");
+	net_pmtu_read_unlock();
 #else
 	ztest_test_skip();
 #endif
@@ -380,15 +396,19 @@ ZTEST(net_pmtu_test_suite, test_pmtu_04_ipv4_overflow)
 	ret = net_pmtu_update_mtu((struct net_sockaddr *)&dest_ipv4, 1450);
 	zassert_equal(ret, 0, "PMTU IPv4 MTU update failed (%d)", ret);
 
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv4);
 	zassert_equal(entry->mtu, 1450, "PMTU IPv4 MTU is not correct (%d)",
 		      entry->mtu);
+	net_pmtu_read_unlock();
 
 	k_sleep(SMALL_SLEEP);
 
 	net_ipaddr_copy(&dest_ipv4.sin_addr, &dest_ipv4_addr1);
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv4);
 	zassert_is_null(entry, "PMTU IPv4 MTU found when it should not be");
+	net_pmtu_read_unlock();
 #else
 	ztest_test_skip();
 #endif
@@ -408,9 +428,11 @@ ZTEST(net_pmtu_test_suite, test_pmtu_04_ipv6_overflow)
 	ret = net_pmtu_update_mtu((struct net_sockaddr *)&dest_ipv6, 1650);
 	zassert_equal(ret, 0, "PMTU IPv6 MTU update failed (%d)", ret);
 
+	net_pmtu_read_lock();
 	entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv6);
 	zassert_equal(entry->mtu, 1650, "PMTU IPv6 MTU is not correct (%d)",
 		      entry->mtu);
+	net_pmtu_read_unlock();
 
 	k_sleep(SMALL_SLEEP);
 
@@ -422,13 +444,44 @@ ZTEST(net_pmtu_test_suite, test_pmtu_04_ipv6_overflow)
 		dest_ipv4.sin_family = NET_AF_INET;
 
 		net_ipaddr_copy(&dest_ipv4.sin_addr, &dest_ipv4_addr2);
-		entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv4);
+		ret = net_pmtu_get_mtu((struct net_sockaddr *)&dest_ipv4);
 	} else {
 		net_ipaddr_copy(&dest_ipv6.sin6_addr, &dest_ipv6_addr1);
-		entry = net_pmtu_get_entry((struct net_sockaddr *)&dest_ipv6);
+		ret = net_pmtu_get_mtu((struct net_sockaddr *)&dest_ipv6);
 	}
 
-	zassert_is_null(entry, "PMTU IPv6 MTU found when it should not be");
+	zassert_equal(ret, -ENOENT, "PMTU IPv6 MTU found when it should not be");
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(net_pmtu_test_suite, test_pmtu_04_overflow_no_wait)
+{
+#if defined(CONFIG_NET_IPV4_PMTU)
+	struct net_in_addr addrs[] = {
+		{ { { 198, 51, 100, 5 } } },
+		{ { { 198, 51, 100, 6 } } },
+	};
+	struct net_sockaddr_in dest_ipv4;
+	int ret;
+
+	dest_ipv4.sin_family = NET_AF_INET;
+
+	/* Replace entries back to back, before the replaced ones could be
+	 * reclaimed in the background.
+	 */
+	ARRAY_FOR_EACH(addrs, i) {
+		net_ipaddr_copy(&dest_ipv4.sin_addr, &addrs[i]);
+		ret = net_pmtu_update_mtu((struct net_sockaddr *)&dest_ipv4, 1400 + i);
+		zassert_equal(ret, 0, "PMTU IPv4 MTU update failed (%d)", ret);
+	}
+
+	ARRAY_FOR_EACH(addrs, i) {
+		net_ipaddr_copy(&dest_ipv4.sin_addr, &addrs[i]);
+		ret = net_pmtu_get_mtu((struct net_sockaddr *)&dest_ipv4);
+		zassert_equal(ret, 1400 + i, "PMTU IPv4 MTU is not correct (%d)", ret);
+	}
 #else
 	ztest_test_skip();
 #endif
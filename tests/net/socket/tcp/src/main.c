@@ -2452,6 +2452,64 @@ ZTEST(net_socket_tcp, test_so_keepalive_opt)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CONGESTION_DEFAULT "cubic"
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+#define TCP_CONGESTION_DEFAULT "bbr"
+#else
+#define TCP_CONGESTION_DEFAULT "newreno"
+#endif
+
+static void test_tcp_congestion_set(int sock, const char *name)
+{
+	char buf[16];
+	net_socklen_t optlen = sizeof(buf);
+	int ret;
+
+	ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+			       name, strlen(name));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	ret = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, buf, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(buf, name, "getsockopt got invalid value");
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+}
+
+ZTEST(net_socket_tcp, test_tcp_congestion_opt)
+{
+	struct net_sockaddr_in bind_addr4;
+	char buf[16];
+	net_socklen_t optlen = sizeof(buf);
+	int sock, ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_CONGESTION_AVOIDANCE);
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	ret = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, buf, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(buf, TCP_CONGESTION_DEFAULT, "getsockopt got invalid value");
+
+	test_tcp_congestion_set(sock, "newreno");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		test_tcp_congestion_set(sock, "cubic");
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_BBR)) {
+		test_tcp_congestion_set(sock, "bbr");
+	}
+
+	ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, "vegas", 5);
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt got invalid errno (%d)", errno);
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 static void test_prepare_keepalive_socks(int *c_sock, int *s_sock, int *new_sock)
 {
 	struct net_sockaddr_in c_saddr, s_saddr;
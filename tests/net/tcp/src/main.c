@@ -116,6 +116,10 @@ static enum test_case_no {
 	TEST_CLIENT_SEQ_VALIDATION = 19,
 	TEST_SERVER_ACK_VALIDATION = 20,
 	TEST_SERVER_FIN_ACK_AFTER_DATA = 21,
+	TEST_SERVER_SACK_IPV4 = 22,
+	TEST_SERVER_SEGMENTATION_IPV4 = 23,
+	TEST_SERVER_RECV_SEGMENTS_IPV4 = 24,
+	TEST_SERVER_CONGESTION_IPV4 = 25,
 } test_case_no;
 
 static enum test_state t_state;
@@ -143,6 +147,10 @@ static void handle_client_fin_ack_with_data_test(net_sa_family_t af, struct tcph
 static void handle_client_seq_validation_test(net_sa_family_t af, struct tcphdr *th);
 static void handle_server_ack_validation_test(struct net_pkt *pkt);
 static void handle_server_fin_ack_after_data_test(net_sa_family_t af, struct tcphdr *th);
+static void handle_server_sack_test(struct net_pkt *pkt);
+static void handle_server_segmentation_test(struct net_pkt *pkt);
+static void handle_server_recv_segments_test(struct net_pkt *pkt);
+static void handle_server_congestion_test(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -253,7 +261,8 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
+	     test_case_no == TEST_SERVER_SACK_IPV4) && (flags & SYN)) {
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -289,11 +298,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
 	th->th_win = net_htons(NET_IPV6_MTU);
@@ -308,7 +313,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
 		ret = net_pkt_write(pkt, tcp_options, opts_len);
 		if (ret < 0) {
@@ -498,6 +503,18 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_FIN_ACK_AFTER_DATA:
 		handle_server_fin_ack_after_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_SERVER_SACK_IPV4:
+		handle_server_sack_test(pkt);
+		break;
+	case TEST_SERVER_SEGMENTATION_IPV4:
+		handle_server_segmentation_test(pkt);
+		break;
+	case TEST_SERVER_RECV_SEGMENTS_IPV4:
+		handle_server_recv_segments_test(pkt);
+		break;
+	case TEST_SERVER_CONGESTION_IPV4:
+		handle_server_congestion_test(pkt);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -771,8 +788,16 @@ fail:
 
 static void test_server_timeout(struct k_work *work)
 {
-	if (test_case_no == TEST_SERVER_IPV4 ||
-	    test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
+	if (test_case_no == TEST_SERVER_SACK_IPV4) {
+		handle_server_sack_test(NULL);
+	} else if (test_case_no == TEST_SERVER_SEGMENTATION_IPV4) {
+		handle_server_segmentation_test(NULL);
+	} else if (test_case_no == TEST_SERVER_RECV_SEGMENTS_IPV4) {
+		handle_server_recv_segments_test(NULL);
+	} else if (test_case_no == TEST_SERVER_CONGESTION_IPV4) {
+		handle_server_congestion_test(NULL);
+	} else if (test_case_no == TEST_SERVER_IPV4 ||
+		   test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
 	    test_case_no == TEST_SERVER_RST_ON_CLOSED_PORT ||
 	    test_case_no == TEST_SERVER_RST_ON_LISTENING_PORT_NO_ACTIVE_CONNECTION) {
 		handle_server_test(NET_AF_INET, NULL);
@@ -3209,4 +3234,759 @@ ZTEST(net_tcp, test_server_fin_ack_after_data)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
+/* Return the option of the given kind in the options of a TCP header */
+static const uint8_t *find_tcp_option(const uint8_t *options, size_t len, uint8_t kind)
+{
+	size_t i = 0;
+
+	while (i < len && options[i] != NET_TCP_END_OPT) {
+		if (options[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if ((i + 1 >= len) || (options[i + 1] < 2)) {
+			break;
+		}
+
+		if (options[i] == kind) {
+			return &options[i];
+		}
+
+		i += options[i + 1];
+	}
+
+	return NULL;
+}
+
+#define SACK_TEST_HOLE 10U
+#define SACK_TEST_LEN  5U
+
+static void handle_server_sack_test(struct net_pkt *pkt)
+{
+	uint8_t options[NET_TCP_OPTIONS_MAX_LEN];
+	const uint8_t *opt;
+	struct net_pkt *reply;
+	struct tcphdr th;
+	size_t opts_len = 0;
+	int ret;
+
+	if (pkt != NULL) {
+		ret = read_tcp_header(pkt, &th);
+		zassert_ok(ret, "Cannot read TCP header");
+
+		opts_len = th.th_off * 4U - sizeof(struct tcphdr);
+		net_pkt_cursor_init(pkt);
+		ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+				   sizeof(struct tcphdr));
+		zassert_ok(ret, "Cannot skip TCP header");
+		ret = net_pkt_read(pkt, options, opts_len);
+		zassert_ok(ret, "Cannot read TCP options");
+	}
+
+	switch (t_state) {
+	case T_SYN:
+		reply = prepare_syn_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(&th, SYN | ACK);
+
+		/* Both options were offered in the SYN, so they are agreed on */
+		opt = find_tcp_option(options, opts_len, NET_TCP_WINDOW_SCALE_OPT);
+		zassert_not_null(opt, "No window scale option in SYN-ACK");
+		zassert_equal(opt[1], NET_TCP_WINDOW_SCALE_SIZE, "Invalid window scale option");
+		zassert_true(opt[2] <= NET_TCP_WINDOW_SCALE_MAX, "Invalid window scale %u",
+			     opt[2]);
+
+		opt = find_tcp_option(options, opts_len, NET_TCP_SACK_PERM_OPT);
+		zassert_not_null(opt, "No SACK permitted option in SYN-ACK");
+
+		seq++;
+		ack = net_ntohl(th.th_seq) + 1U;
+		reply = prepare_ack_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+		t_state = T_DATA;
+		break;
+	case T_DATA:
+		/* Duplicate ACK of the out of order data */
+		test_verify_flags(&th, ACK);
+		zassert_equal(net_ntohl(th.th_ack), seq, "Unexpected ACK %u",
+			      net_ntohl(th.th_ack));
+
+		opt = find_tcp_option(options, opts_len, NET_TCP_SACK_OPT);
+		zassert_not_null(opt, "No SACK option in duplicate ACK");
+		zassert_equal(opt[1], 2 + NET_TCP_SACK_BLOCK_SIZE, "Invalid SACK option");
+		zassert_equal(net_ntohl(UNALIGNED_GET((uint32_t *)&opt[2])),
+			      seq + SACK_TEST_HOLE, "Invalid SACK block start");
+		zassert_equal(net_ntohl(UNALIGNED_GET((uint32_t *)&opt[6])),
+			      seq + SACK_TEST_HOLE + SACK_TEST_LEN, "Invalid SACK block end");
+
+		t_state = T_DATA_ACK;
+		test_sem_give();
+		return;
+	case T_DATA_ACK:
+		/* Data filling the hole is acknowledged up to the SACKed data */
+		test_verify_flags(&th, ACK);
+		zassert_equal(net_ntohl(th.th_ack), seq + SACK_TEST_HOLE + SACK_TEST_LEN,
+			      "Unexpected ACK %u", net_ntohl(th.th_ack));
+		zassert_is_null(find_tcp_option(options, opts_len, NET_TCP_SACK_OPT),
+				"SACK option without out of order data");
+
+		t_state = T_FIN_ACK;
+		test_sem_give();
+		return;
+	default:
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+}
+
+/* Test case scenario IPv4
+ *   send SYN with window scale and SACK permitted options,
+ *   expect SYN ACK with the same options,
+ *   send ACK,
+ *   send data after a hole,
+ *   expect duplicate ACK with a SACK block of the data,
+ *   send the missing data,
+ *   expect ACK of all the data without SACK block,
+ *   send RST.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_sack_ipv4)
+{
+	const uint8_t *data = lorem_ipsum;
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	uint32_t base;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_SACK);
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_TCP_WINDOW_SCALE);
+
+	t_state = T_SYN;
+	test_case_no = TEST_SERVER_SACK_IPV4;
+	seq = ack = 0;
+
+	k_sem_reset(&test_sem);
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_bind(ctx, (struct net_sockaddr *)&my_addr_s,
+			       sizeof(struct net_sockaddr_in));
+	zassert_ok(ret, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_ok(ret, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_ok(ret, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_recv(accepted_ctx, test_tcp_recv_cb, K_NO_WAIT, NULL);
+	zassert_ok(ret, "Failed to set recv callback");
+
+	/* Out of order data is only kept with a receive queue */
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT != 0) {
+		base = seq;
+
+		seq = base + SACK_TEST_HOLE;
+		pkt = prepare_data_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT),
+					  &data[SACK_TEST_HOLE], SACK_TEST_LEN);
+		zassert_not_null(pkt, "Cannot create pkt");
+
+		seq = base;
+		ret = net_recv_data(net_iface, pkt);
+		zassert_ok(ret, "recv data failed (%d)", ret);
+
+		test_sem_take(K_MSEC(100), __LINE__);
+
+		pkt = prepare_data_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT),
+					  data, SACK_TEST_HOLE);
+		zassert_not_null(pkt, "Cannot create pkt");
+
+		ret = net_recv_data(net_iface, pkt);
+		zassert_ok(ret, "recv data failed (%d)", ret);
+
+		test_sem_take(K_MSEC(100), __LINE__);
+
+		seq = base + SACK_TEST_HOLE + SACK_TEST_LEN;
+	}
+
+	/* Abort the connection, the closing handshake is covered elsewhere */
+	t_state = T_FIN_ACK;
+	pkt = prepare_rst_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define SEGMENTATION_TEST_LEN (2U * NET_TCP_DEFAULT_MSS + 128U)
+
+static size_t segmentation_test_received;
+
+static void handle_server_segmentation_test(struct net_pkt *pkt)
+{
+	uint8_t buf[NET_TCP_DEFAULT_MSS];
+	struct net_pkt *reply;
+	struct tcphdr th;
+	size_t hdr_len;
+	size_t len;
+	int ret;
+
+	if (pkt != NULL) {
+		ret = read_tcp_header(pkt, &th);
+		zassert_ok(ret, "Cannot read TCP header");
+	}
+
+	switch (t_state) {
+	case T_SYN:
+		reply = prepare_syn_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(&th, SYN | ACK);
+		seq++;
+		ack = net_ntohl(th.th_seq) + 1U;
+		reply = prepare_ack_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+		t_state = T_DATA;
+		break;
+	case T_DATA:
+		/* Each segment fits the MSS and follows the previous one */
+		hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) + th.th_off * 4U;
+		len = net_pkt_get_len(pkt) - hdr_len;
+
+		zassert_true(len > 0 && len <= NET_TCP_DEFAULT_MSS, "Invalid segment length %zu",
+			     len);
+		zassert_equal(net_ntohl(th.th_seq), ack, "Unexpected seq %u",
+			      net_ntohl(th.th_seq));
+
+		net_pkt_cursor_init(pkt);
+		ret = net_pkt_skip(pkt, hdr_len);
+		zassert_ok(ret, "Cannot skip headers");
+		ret = net_pkt_read(pkt, buf, len);
+		zassert_ok(ret, "Cannot read data");
+		zassert_mem_equal(buf, &lorem_ipsum[segmentation_test_received], len,
+				  "Invalid data at %zu", segmentation_test_received);
+
+		segmentation_test_received += len;
+		ack += len;
+		reply = prepare_ack_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+
+		if (segmentation_test_received == SEGMENTATION_TEST_LEN) {
+			t_state = T_FIN_ACK;
+			test_sem_give();
+		}
+		break;
+	default:
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send more than two segments of data from the accepted context,
+ *   expect segments which fit the MSS with contiguous sequence numbers,
+ *   send ACK of each segment,
+ *   send RST.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_segmentation_ipv4)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = TEST_SERVER_SEGMENTATION_IPV4;
+	seq = ack = 0;
+	segmentation_test_received = 0;
+
+	k_sem_reset(&test_sem);
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_bind(ctx, (struct net_sockaddr *)&my_addr_s,
+			       sizeof(struct net_sockaddr_in));
+	zassert_ok(ret, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_ok(ret, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_ok(ret, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, SEGMENTATION_TEST_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, SEGMENTATION_TEST_LEN, "Failed to send data to peer (%d)", ret);
+
+	test_sem_take(K_MSEC(500), __LINE__);
+
+	/* Abort the connection, the closing handshake is covered elsewhere */
+	pkt = prepare_rst_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define RECV_SEGMENTS_TEST_COUNT 4U
+#define RECV_SEGMENTS_TEST_LEN   64U
+
+static uint8_t recv_segments_test_buf[RECV_SEGMENTS_TEST_COUNT * RECV_SEGMENTS_TEST_LEN];
+static size_t recv_segments_test_received;
+static uint32_t recv_segments_test_ack;
+
+static void handle_server_recv_segments_test(struct net_pkt *pkt)
+{
+	struct net_pkt *reply;
+	struct tcphdr th;
+	int ret;
+
+	if (pkt != NULL) {
+		ret = read_tcp_header(pkt, &th);
+		zassert_ok(ret, "Cannot read TCP header");
+	}
+
+	switch (t_state) {
+	case T_SYN:
+		reply = prepare_syn_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(&th, SYN | ACK);
+		seq++;
+		ack = net_ntohl(th.th_seq) + 1U;
+		reply = prepare_ack_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+		t_state = T_DATA;
+		break;
+	case T_DATA:
+		/* The segments may be acknowledged one by one or at once */
+		test_verify_flags(&th, ACK);
+		if (net_ntohl(th.th_ack) == recv_segments_test_ack) {
+			t_state = T_FIN_ACK;
+			test_sem_give();
+		}
+		return;
+	default:
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+}
+
+static void test_recv_segments_recv_cb(struct net_context *context,
+				       struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       union net_proto_header *proto_hdr,
+				       int status,
+				       void *user_data)
+{
+	size_t len;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	len = net_pkt_remaining_data(pkt);
+	zassert_true(recv_segments_test_received + len <= sizeof(recv_segments_test_buf),
+		     "Too much data received");
+	zassert_ok(net_pkt_read(pkt, &recv_segments_test_buf[recv_segments_test_received],
+				len));
+
+	recv_segments_test_received += len;
+
+	net_pkt_unref(pkt);
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   queue several in order data segments before the stack processes them,
+ *   expect ACK of all the data,
+ *   expect the data to be received in order,
+ *   send RST.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_recv_segments_ipv4)
+{
+	const uint8_t *data = lorem_ipsum;
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	uint8_t flags;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = TEST_SERVER_RECV_SEGMENTS_IPV4;
+	seq = ack = 0;
+	recv_segments_test_received = 0;
+
+	k_sem_reset(&test_sem);
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_bind(ctx, (struct net_sockaddr *)&my_addr_s,
+			       sizeof(struct net_sockaddr_in));
+	zassert_ok(ret, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_ok(ret, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_ok(ret, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	ret = net_context_recv(accepted_ctx, test_recv_segments_recv_cb, K_NO_WAIT, NULL);
+	zassert_ok(ret, "Failed to set recv callback");
+
+	recv_segments_test_ack = seq + sizeof(recv_segments_test_buf);
+
+	/* Queue all the segments before the RX thread gets to them */
+	k_sched_lock();
+
+	for (int i = 0; i < RECV_SEGMENTS_TEST_COUNT; i++) {
+		flags = (i == RECV_SEGMENTS_TEST_COUNT - 1) ? (PSH | ACK) : ACK;
+
+		pkt = tester_prepare_tcp_pkt(NET_AF_INET, net_htons(MY_PORT),
+					     net_htons(PEER_PORT), flags,
+					     &data[i * RECV_SEGMENTS_TEST_LEN],
+					     RECV_SEGMENTS_TEST_LEN);
+		zassert_not_null(pkt, "Cannot create pkt");
+
+		ret = net_recv_data(net_iface, pkt);
+		zassert_ok(ret, "recv data failed (%d)", ret);
+
+		seq += RECV_SEGMENTS_TEST_LEN;
+	}
+
+	k_sched_unlock();
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(recv_segments_test_received, sizeof(recv_segments_test_buf),
+		      "Received %zu bytes", recv_segments_test_received);
+	zassert_mem_equal(recv_segments_test_buf, data, sizeof(recv_segments_test_buf),
+			  "Invalid data received");
+
+	/* Abort the connection, the closing handshake is covered elsewhere */
+	pkt = prepare_rst_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define CONGESTION_TEST_SEGMENTS 5U
+
+static size_t congestion_test_len;
+static size_t congestion_test_sent;
+static uint32_t congestion_test_base;
+
+static void handle_server_congestion_test(struct net_pkt *pkt)
+{
+	struct net_pkt *reply;
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	if (pkt != NULL) {
+		ret = read_tcp_header(pkt, &th);
+		zassert_ok(ret, "Cannot read TCP header");
+	}
+
+	switch (t_state) {
+	case T_SYN:
+		reply = prepare_syn_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(&th, SYN | ACK);
+		seq++;
+		ack = net_ntohl(th.th_seq) + 1U;
+		congestion_test_base = ack;
+		reply = prepare_ack_packet(NET_AF_INET, net_htons(MY_PORT),
+					   net_htons(PEER_PORT));
+		t_state = T_DATA;
+		break;
+	case T_DATA:
+		/* Collect the segments, the test acknowledges them */
+		len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		      net_pkt_ip_opts_len(pkt) - th.th_off * 4U;
+		if (len == 0 ||
+		    net_ntohl(th.th_seq) != congestion_test_base + congestion_test_sent) {
+			return;
+		}
+
+		congestion_test_sent += len;
+		if (congestion_test_sent == congestion_test_len) {
+			/* Retransmissions are ignored from now on */
+			t_state = T_DATA_ACK;
+			test_sem_give();
+		}
+		return;
+	default:
+		return;
+	}
+
+	ret = net_recv_data(net_iface, reply);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+}
+
+/* Sets up a connection using the given congestion control algorithm, and
+ * sends a window worth of data from it which is not acknowledged yet.
+ */
+static struct tcp *congestion_test_start(const char *name, struct net_context **ctx)
+{
+	struct tcp *conn;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = TEST_SERVER_CONGESTION_IPV4;
+	seq = ack = 0;
+	congestion_test_sent = 0;
+
+	k_sem_reset(&test_sem);
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(*ctx);
+
+	/* Inherited by the accepted connection */
+	ret = net_tcp_set_option(*ctx, TCP_OPT_CONGESTION, name, strlen(name));
+	zassert_ok(ret, "Failed to select %s (%d)", name, ret);
+
+	ret = net_context_bind(*ctx, (struct net_sockaddr *)&my_addr_s,
+			       sizeof(struct net_sockaddr_in));
+	zassert_ok(ret, "Failed to bind net_context");
+
+	ret = net_context_listen(*ctx, 1);
+	zassert_ok(ret, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(*ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_ok(ret, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = accepted_ctx->tcp;
+	congestion_test_len = CONGESTION_TEST_SEGMENTS * conn_mss(conn);
+	zassert_true(congestion_test_len <= conn->ca.cwnd, "Initial window too small");
+	zassert_equal(conn->ca.ssthresh, TCP_WINDOW_MAX, "Unexpected initial ssthresh %u",
+		      conn->ca.ssthresh);
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, congestion_test_len, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, congestion_test_len, "Failed to send data to peer (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	return conn;
+}
+
+/* Acknowledges the data up to the given offset, the same offset again is a
+ * duplicate ACK.
+ */
+static void congestion_test_ack(uint32_t offset)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	ack = congestion_test_base + offset;
+	pkt = prepare_ack_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(1);
+}
+
+static void congestion_test_end(struct net_context *ctx)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	/* Abort the connection, the closing handshake is covered elsewhere */
+	pkt = prepare_rst_packet(NET_AF_INET, net_htons(MY_PORT), net_htons(PEER_PORT));
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+/* Test case scenario IPv4
+ *   set up a connection using CUBIC,
+ *   send five segments from the accepted context,
+ *   acknowledge the first one, expect a slow start increase,
+ *   send three duplicate ACKs, expect the window to be reduced by beta
+ *   and inflated by the three segments which left the network,
+ *   send another duplicate ACK, expect the window to be inflated by a segment,
+ *   acknowledge all the data, expect the window to deflate to ssthresh,
+ *   send RST.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_congestion_cubic_ipv4)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC) && defined(CONFIG_NET_TCP_FAST_RETRANSMIT)
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t cwnd;
+	uint32_t win;
+	uint32_t mss;
+
+	conn = congestion_test_start("cubic", &ctx);
+	cwnd = conn->ca.cwnd;
+	mss = conn_mss(conn);
+
+	congestion_test_ack(mss);
+	zassert_equal(conn->ca.cwnd, cwnd + mss, "No slow start increase (%u)",
+		      conn->ca.cwnd);
+
+	/* The window reduction is based on the data in flight */
+	win = congestion_test_len - mss;
+
+	for (int i = 0; i < 3; i++) {
+		congestion_test_ack(mss);
+	}
+
+	zassert_equal(conn->ca.cubic.w_max, win, "Unexpected w_max %u",
+		      conn->ca.cubic.w_max);
+	zassert_equal(conn->ca.ssthresh, win * 7U / 10U, "Unexpected ssthresh %u",
+		      conn->ca.ssthresh);
+	zassert_equal(conn->ca.cwnd, conn->ca.ssthresh + 3U * mss,
+		      "Unexpected fast recovery cwnd %u", conn->ca.cwnd);
+
+	congestion_test_ack(mss);
+	zassert_equal(conn->ca.cwnd, conn->ca.ssthresh + 4U * mss,
+		      "Duplicate ACK did not inflate cwnd (%u)", conn->ca.cwnd);
+
+	congestion_test_ack(congestion_test_len);
+	zassert_equal(conn->ca.cwnd, conn->ca.ssthresh, "cwnd %u not deflated to ssthresh %u",
+		      conn->ca.cwnd, conn->ca.ssthresh);
+
+	congestion_test_end(ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/* Test case scenario IPv4
+ *   set up a connection using BBR,
+ *   send five segments from the accepted context,
+ *   acknowledge the first one,
+ *   send three duplicate ACKs, expect ssthresh to keep the window and the
+ *   window not to be inflated,
+ *   send another duplicate ACK, expect the window to be inflated by a segment,
+ *   acknowledge all the data, expect the window to be back where it was
+ *   before the loss,
+ *   send RST.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_congestion_bbr_ipv4)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR) && defined(CONFIG_NET_TCP_FAST_RETRANSMIT)
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t cwnd;
+	uint32_t mss;
+
+	conn = congestion_test_start("bbr", &ctx);
+	mss = conn_mss(conn);
+
+	congestion_test_ack(mss);
+	cwnd = conn->ca.cwnd;
+	zassert_true(cwnd >= 4U * mss, "cwnd %u below the minimum", cwnd);
+	zassert_equal(conn->ca.ssthresh, TCP_WINDOW_MAX, "Unexpected ssthresh %u",
+		      conn->ca.ssthresh);
+
+	for (int i = 0; i < 3; i++) {
+		congestion_test_ack(mss);
+	}
+
+	/* Losses are not a congestion signal */
+	zassert_equal(conn->ca.ssthresh, cwnd, "Unexpected ssthresh %u", conn->ca.ssthresh);
+	zassert_equal(conn->ca.cwnd, cwnd, "Unexpected fast recovery cwnd %u",
+		      conn->ca.cwnd);
+
+	congestion_test_ack(mss);
+	zassert_equal(conn->ca.cwnd, cwnd + mss, "Duplicate ACK did not inflate cwnd (%u)",
+		      conn->ca.cwnd);
+
+	congestion_test_ack(congestion_test_len);
+	zassert_equal(conn->ca.cwnd, cwnd, "cwnd %u changed by the loss, was %u",
+		      conn->ca.cwnd, cwnd);
+
+	congestion_test_end(ctx);
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -1354,8 +1354,8 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 
 	/* Work across all possible combination so offset and length */
-	for (int offset = 0; offset < 7; offset++) {
-		for (int length = 1; length < 32; length++) {
+	for (int offset = 0; offset < 16; offset++) {
+		for (int length = 1; length < 96; length++) {
 			sum_got = calc_chksum_ref(offset ^ 0x8e72, testdata + offset, length);
 			sum_exp = calc_chksum(offset ^ 0x8e72, testdata + offset, length);
 
@@ -1365,6 +1365,51 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+ZTEST(test_utils_fn, test_pkt_chksum_acc)
+{
+	static const size_t chunks[] = { 7, 100, 1, 150, 12 };
+	struct net_pkt *pkt;
+	size_t acc_len = 0;
+	size_t total = 0;
+	uint16_t acc = 0;
+	int ret;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_PKT_CHKSUM_ACCUMULATE);
+
+	for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+		testdata[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	pkt = net_pkt_alloc_with_buffer(net_if_get_default(), 300, NET_AF_UNSPEC,
+					0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	/* Data written before the start is not summed */
+	ret = net_pkt_write_u8(pkt, 0xa5);
+	zassert_equal(ret, 0, "Cannot write to pkt");
+
+	net_pkt_chksum_acc_start(pkt);
+
+	/* Chunks of odd lengths, spanning several fragments */
+	for (int i = 0; i < ARRAY_SIZE(chunks); i++) {
+		ret = net_pkt_write(pkt, testdata + total, chunks[i]);
+		zassert_equal(ret, 0, "Cannot write to pkt");
+		total += chunks[i];
+	}
+
+	zassert_true(net_pkt_chksum_acc_get(pkt, &acc, &acc_len), "Checksum not accumulated");
+	zassert_equal(acc_len, total, "Wrong accumulated length");
+	zassert_equal(acc, calc_chksum_ref(0, testdata, total),
+		      "Mismatch between reference and accumulated checksum");
+
+	/* Changing the end of the packet otherwise stops the accumulation */
+	ret = net_pkt_remove_tail(pkt, 1);
+	zassert_equal(ret, 0, "Cannot remove tail");
+	zassert_false(net_pkt_chksum_acc_get(pkt, &acc, &acc_len), "Checksum still accumulated");
+
+	net_pkt_unref(pkt);
+}
+
 /* Verify that the net_pkt pointer to the received link layer address
  * is correct.
  */
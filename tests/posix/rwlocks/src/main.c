@@ -70,6 +70,8 @@ ZTEST(posix_rw_locks, test_rw_lock)
 	zassert_ok(pthread_rwlock_init(&rwlock, NULL), "Failed to create rwlock");
 	LOG_DBG("main acquire WR lock and 3 threads acquire RD lock");
 	zassert_ok(pthread_rwlock_timedwrlock(&rwlock, &time), "Failed to acquire write lock");
+	zassert_equal(pthread_rwlock_trywrlock(&rwlock), EBUSY);
+	zassert_equal(pthread_rwlock_wrlock(&rwlock), EDEADLK);
 
 	/* Creating N preemptive threads in increasing order of priority */
 	for (int i = 0; i < N_THR; i++) {